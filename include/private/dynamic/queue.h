@@ -0,0 +1,46 @@
+#ifndef __WOODPILE_PRIVATE_DYNAMIC_QUEUE_H
+#define __WOODPILE_PRIVATE_DYNAMIC_QUEUE_H
+
+/**
+ * @file
+ * Queue definition
+ */
+
+#include <woodpile/dynamic/queue.h>
+
+/** a block of element slots in a DQueue */
+struct dqueue_block_t {
+  void *elements[DQUEUE_BLOCK_SIZE]; /**< the slots */
+  struct dqueue_block_t *next; /**< the block behind this one, or the next spare */
+};
+
+/**
+ * the Dynamic Queue container
+ *
+ * When the queue is empty it keeps its last block, with the front and back
+ * both reset to the first slot, so that a queue going between empty and a few
+ * elements touches no other block.
+ */
+struct dqueue_t {
+  size_t back; /**< the slot after the back element in the last block */
+  struct dqueue_block_t *first; /**< the block holding the front element */
+  size_t front; /**< the slot of the front element in the first block */
+  struct dqueue_block_t *last; /**< the block the next push goes into */
+  size_t size; /**< the number of elements in the queue */
+  struct dqueue_block_t *spare; /**< the cached blocks, linked by next */
+  size_t spare_count; /**< the number of cached blocks */
+};
+
+/**
+ * Puts a block drained by pops into the cache of a queue, or frees it if the
+ * cache is full.
+ *
+ * @param queue the queue the block came from. Must not be NULL.
+ * @param block the block to release. Must not be NULL.
+ */
+static
+void
+DQueueRelease
+( dqueue_t *queue, struct dqueue_block_t *block );
+
+#endif
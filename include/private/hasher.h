@@ -6,12 +6,196 @@
  * Hasher support functions.
  */
 
+#include <stddef.h>
 #include <woodpile/config.h>
 
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+# define HASHER_X86 1
+# define HASHER_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+# define HASHER_TARGET_SSE42 __attribute__(( target( "sse4.2" ) ))
+#elif defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+# define HASHER_X86 1
+# define HASHER_TARGET_AVX2
+# define HASHER_TARGET_SSE42
+#elif defined( __GNUC__ ) && defined( __aarch64__ )
+# define HASHER_ARM 1
+# ifdef __clang__
+#  define HASHER_TARGET_ARM_CRC32 __attribute__(( target( "crc" ) ))
+# else
+#  define HASHER_TARGET_ARM_CRC32 __attribute__(( target( "+crc" ) ))
+# endif
+#endif
+
+#if defined( HASHER_X86 ) && ( defined( __x86_64__ ) || defined( _M_X64 ) )
+# define HASHER_X86_64 1
+#endif
+
+/** set if the processor supports the SSE4.2 instruction set */
+#define HASHER_CPU_SSE42 0x1
+/** set if the processor supports the ARMv8 CRC32 extension */
+#define HASHER_CPU_ARM_CRC32 0x2
+/** set if the processor and operating system support the AVX2 instruction set */
+#define HASHER_CPU_AVX2 0x4
+
+/**
+ * A function pointer chosen on the first call of a hasher, which threads may
+ * race to set. Every thread picks the same function, so relaxed ordering is
+ * enough. Where stdatomic.h is not available these are plain pointers.
+ */
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# define HASHER_DISPATCH( type ) _Atomic( type )
+# define HASHER_DISPATCH_LOAD( pointer ) \
+  atomic_load_explicit( &(pointer), memory_order_relaxed )
+# define HASHER_DISPATCH_STORE( pointer, value ) \
+  atomic_store_explicit( &(pointer), (value), memory_order_relaxed )
+#else
+# define HASHER_DISPATCH( type ) type
+# define HASHER_DISPATCH_LOAD( pointer ) (pointer)
+# define HASHER_DISPATCH_STORE( pointer, value ) ( (pointer) = (value) )
+#endif
+
+/** a hashing function for blocks of data of a known length */
+typedef unsigned long long ( *data_hasher_t )( const void *, size_t, unsigned long long );
+
+/** a hashing function for batches of blocks of data of known lengths */
+typedef unsigned long long *( *data_batch_hasher_t )( const void * const *, const size_t *, size_t, unsigned long long, unsigned long long * );
+
+/**
+ * Hashes a batch of blocks of data one at a time with a data hasher. This is
+ * the batch implementation for hashers that cannot do better than this.
+ *
+ * @param hasher the hasher to use for each block
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block
+ *
+ * @return hashes
+ */
+unsigned long long *
+HashBatchSerially
+( data_hasher_t hasher, const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Hashes a batch of NULL-terminated strings using a data batch hasher. The
+ * lengths of the strings are measured a block at a time, so that the batch
+ * hasher sees as many strings at once as possible.
+ *
+ * @param hasher the data batch hasher to use
+ * @param strs the strings to hash
+ * @param count the number of strings
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each string
+ *
+ * @return hashes
+ */
+unsigned long long *
+HashStringBatch
+( data_batch_hasher_t hasher, const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Detects the processor features relevant to the hashing functions. This is
+ * cheap enough to call more than once, but is meant to be called only when a
+ * hasher is picking its implementation.
+ *
+ * @return a combination of the HASHER_CPU flags supported by the processor
+ */
+unsigned
+HasherCPUFeatures
+( void );
+
+#ifdef __WOODPILE_CRC_HASHER
+
+/**
+ * Computes a CRC32C checksum using the ARMv8 CRC32 instructions. This function
+ * must only be called if HasherCPUFeatures reports HASHER_CPU_ARM_CRC32.
+ *
+ * @param data the data to checksum
+ * @param length the length of the data
+ * @param crc the initial value of the checksum
+ *
+ * @return the updated checksum
+ */
+unsigned
+CRCARMUpdate
+( const void *data, size_t length, unsigned crc );
+
+/**
+ * Computes a CRC32C checksum using the SSE4.2 crc32 instruction. This function
+ * must only be called if HasherCPUFeatures reports HASHER_CPU_SSE42.
+ *
+ * @param data the data to checksum
+ * @param length the length of the data
+ * @param crc the initial value of the checksum
+ *
+ * @return the updated checksum
+ */
+unsigned
+CRCSSE42Update
+( const void *data, size_t length, unsigned crc );
+
+/**
+ * Computes CRC hashes for a batch of blocks using the SSE4.2 crc32
+ * instruction. Blocks are processed four at a time with their checksums
+ * interleaved, so that the latency of each crc32 instruction is hidden behind
+ * the others. This function must only be called if HasherCPUFeatures reports
+ * HASHER_CPU_SSE42, and is only available on 64-bit processors.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block
+ *
+ * @return hashes
+ */
+unsigned long long *
+CRCSSE42DataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Computes a CRC32C checksum using a lookup table, one byte at a time. This
+ * works on any processor.
+ *
+ * @param data the data to checksum
+ * @param length the length of the data
+ * @param crc the initial value of the checksum
+ *
+ * @return the updated checksum
+ */
+unsigned
+CRCSoftwareUpdate
+( const void *data, size_t length, unsigned crc );
+
+#endif
+
 #ifdef __WOODPILE_SPOOKY_HASHER
 
 #define SPOOKY_CHUNK_SIZE (sizeof( unsigned long long ) * 12)
 
+/**
+ * Computes Spooky hashes for a batch of blocks using AVX2 instructions. The
+ * states of four blocks are held in the four 64-bit lanes of the vector
+ * registers and mixed together. This function must only be called if
+ * HasherCPUFeatures reports HASHER_CPU_AVX2.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block
+ *
+ * @return hashes
+ */
+unsigned long long *
+SpookyAVX2DataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
 /**
  * Rotates a value to the left by a specified number of bits.
  *
@@ -36,4 +220,23 @@ SpookyMix
 
 #endif
 
+#ifdef __WOODPILE_WOODPILE_HASHER
+
+#define WOODPILE_C1 0x87c37b91114253d5uLL
+#define WOODPILE_C2 0x4cf5ad432745937fuLL
+
+/**
+ * Rotates a value to the left by a specified number of bits.
+ *
+ * @param value the value to left rotate
+ * @param bits the number of bits to shift by
+ *
+ * @return value left rotated by bits
+ */
+unsigned long long
+WoodpileLeftRotate
+( unsigned long long value, size_t bits );
+
+#endif
+
 #endif
@@ -0,0 +1,66 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_BLOCKINGQUEUE_H
+#define __WOODPILE_PRIVATE_STATIC_BLOCKINGQUEUE_H
+
+/**
+ * @file
+ * Blocking queue definition
+ */
+
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/blockingqueue.h>
+#include <woodpile/static/queue.h>
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+# define SBLOCKINGQUEUE_LOCK( queue ) pthread_mutex_lock( &(queue)->lock );
+# define SBLOCKINGQUEUE_UNLOCK( queue ) pthread_mutex_unlock( &(queue)->lock );
+#else
+# define SBLOCKINGQUEUE_LOCK( queue )
+# define SBLOCKINGQUEUE_UNLOCK( queue )
+#endif
+
+/** the Static Blocking Queue container */
+struct sblockingqueue_t {
+  size_t capacity; /**< the most elements the queue may hold */
+  unsigned short closed; /**< non-zero once the queue has been closed */
+  SQueue *elements; /**< the elements, front to back */
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  pthread_mutex_t lock; /**< held around every use of the fields */
+  pthread_cond_t not_empty; /**< signalled when an element is pushed */
+  pthread_cond_t not_full; /**< signalled when elements are popped */
+#endif
+  size_t waiting_consumers; /**< the threads waiting for an element */
+  size_t waiting_producers; /**< the threads waiting for room */
+};
+
+/**
+ * Gets the time at which a timeout will have passed.
+ *
+ * @param timeout the timeout in milliseconds, which must not be negative
+ * @param deadline the time to fill in, on the clock the condition variables use
+ */
+static
+void
+SBlockingQueueDeadline
+( long timeout, struct timespec *deadline );
+
+/**
+ * Waits for a blocking queue to have room or an element. The lock must be
+ * held, and is held again when this returns. Wakeups may be spurious, so the
+ * caller must check the queue again.
+ *
+ * @param queue the blocking queue to wait on. Must not be NULL.
+ * @param for_room non-zero to wait for room, 0 to wait for an element
+ * @param timeout the timeout the caller was given
+ * @param deadline the deadline of the timeout, if it is positive
+ *
+ * @return a positive value if the caller may check again, or 0 if the timeout
+ * has passed or waiting is not possible
+ */
+static
+unsigned short
+SBlockingQueueWait
+( sblockingqueue_t *queue, unsigned short for_room, long timeout, const struct timespec *deadline );
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_CACHE_H
+#define __WOODPILE_PRIVATE_STATIC_CACHE_H
+
+/**
+ * @file
+ * Cache definition
+ */
+
+#include <woodpile/static/cache.h>
+#include <woodpile/static/hash.h>
+
+/** the index marking the end of the recency list */
+#define SCACHE_NONE ( (size_t) -1 )
+
+/** an entry of a cache, threaded into the recency list */
+struct scache_entry_t {
+  void *key; /**< the key of the entry */
+  size_t newer; /**< the next more recently used entry */
+  size_t older; /**< the next less recently used entry, or the next free one */
+  void *value; /**< the value of the entry */
+};
+
+/** the Static Cache container */
+struct scache_t {
+  size_t capacity; /**< the most entries the cache may hold */
+  void *context; /**< the context given to the evictor */
+  struct scache_entry_t *entries; /**< the pool of entries */
+  void ( *evict )( void *, void *, void * ); /**< the evictor, if any */
+  size_t free; /**< the first free entry */
+  shash_t *index; /**< maps each key to its entry */
+  size_t newest; /**< the most recently used entry */
+  size_t oldest; /**< the least recently used entry */
+  size_t size; /**< the number of entries in use */
+};
+
+/**
+ * Puts an entry at the most recently used end of the recency list.
+ *
+ * @param cache the cache holding the entry. Must not be NULL.
+ * @param entry the entry to link, which must not be in the list
+ */
+static
+void
+SCacheLink
+( scache_t *cache, size_t entry );
+
+/**
+ * Takes an entry out of the recency list.
+ *
+ * @param cache the cache holding the entry. Must not be NULL.
+ * @param entry the entry to unlink, which must be in the list
+ */
+static
+void
+SCacheUnlink
+( scache_t *cache, size_t entry );
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_DEQUE_H
+#define __WOODPILE_PRIVATE_STATIC_DEQUE_H
+
+/**
+ * @file
+ * Deque definition
+ */
+
+#include <woodpile/static/deque.h>
+
+/**
+ * the Static Deque container
+ *
+ * The front and back are never wrapped: a push to the front steps the front
+ * back by one, letting it pass below zero. As the capacity is a power of two
+ * this still masks to the right slot, and the size is always back - front.
+ */
+struct sdeque_t {
+  size_t back; /**< the position after the back element */
+  size_t capacity; /**< the number of slots in the ring, a power of two */
+  void **elements; /**< the slots */
+  size_t front; /**< the position of the front element */
+};
+
+/**
+ * Doubles the capacity of a deque, moving the front element to the first
+ * slot.
+ *
+ * @param deque the deque to grow. Must not be NULL.
+ *
+ * @return deque, or NULL if memory was not available, in which case the deque
+ * is unchanged
+ */
+static
+sdeque_t *
+SDequeGrow
+( sdeque_t *deque );
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_DICT_H
+#define __WOODPILE_PRIVATE_STATIC_DICT_H
+
+/**
+ * @file
+ * Dict definition
+ */
+
+#include <woodpile/static/dict.h>
+
+/** the largest capacity a Dict can have, so that entry numbers fit in 32 bits */
+#define SDICT_MAX_CAPACITY 0xfffffffeuL
+
+/** an entry of a Dict */
+struct sdict_entry_t {
+  unsigned long long hash; /**< the stored hash of the key */
+  void *key; /**< the key, or NULL if the entry was removed */
+  void *value; /**< the value */
+};
+
+/** the Static Dict container */
+struct sdict_t {
+  size_t capacity; /**< the number of entries the dict can hold */
+  comparator_t compare_keys; /**< the key comparison function */
+  struct sdict_entry_t *entries; /**< the entries in insertion order */
+  hasher_t hash; /**< the hashing function */
+  size_t index_mask; /**< the number of index slots - 1 */
+  unsigned char index_width; /**< the size in bytes of an index slot */
+  void *indices; /**< the index slots, each an entry number + 1 or 0 if empty */
+  size_t next; /**< the number of entries used, including removed ones */
+  unsigned long long seed; /**< the seed to use for hashes */
+  size_t size; /**< the number of keys currently in the dict */
+};
+
+/**
+ * Finds the index slot of a key in a Dict.
+ *
+ * @param dict the Dict to search. Must not be NULL.
+ * @param key the key to find. Must not be NULL.
+ * @param hash the hash of the key
+ *
+ * @return the slot holding the key's entry, or the empty slot where it belongs
+ */
+static
+size_t
+SDictFindSlot
+( const sdict_t *dict, const void *key, unsigned long long hash );
+
+/**
+ * Gets the entry number + 1 stored in an index slot of a Dict.
+ *
+ * @param dict the Dict to read. Must not be NULL.
+ * @param slot the index slot to read
+ *
+ * @return the entry number + 1, or 0 if the slot is empty
+ */
+static
+size_t
+SDictGetSlot
+( const sdict_t *dict, size_t slot );
+
+/**
+ * Compacts the entries of a Dict into new storage of the given capacity and
+ * rebuilds its index table. If the hasher differs from the one the Dict uses,
+ * each key is rehashed into the new entries and the hasher is replaced once
+ * the rebuild has succeeded; otherwise the stored hashes are reused.
+ *
+ * @param dict the Dict to rebuild. Must not be NULL.
+ * @param capacity the capacity of the rebuilt Dict. Must not be less than the
+ * size of the Dict.
+ * @param hasher the hashing function of the rebuilt Dict. Must not be NULL.
+ *
+ * @return dict, or NULL if memory was not available, leaving dict unchanged
+ */
+static
+sdict_t *
+SDictRebuild
+( sdict_t *dict, size_t capacity, hasher_t hasher );
+
+/**
+ * Stores an entry number + 1 in an index slot of a Dict.
+ *
+ * @param dict the Dict to write. Must not be NULL.
+ * @param slot the index slot to write
+ * @param value the entry number + 1 to store
+ */
+static
+void
+SDictSetSlot
+( sdict_t *dict, size_t slot, size_t value );
+
+#endif
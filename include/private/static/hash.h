@@ -6,20 +6,206 @@
  * SHash definition
  */
 
+#include <time.h>
+#include <woodpile/config.h>
 #include <woodpile/static/hash.h>
 
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+/** the fewest keys a hasher is trained on, as fewer say little about it */
+#define SHASH_TRAINING_MIN_SIZE 32
+
+/** the most keys sampled when training a hasher */
+#define SHASH_TRAINING_SIZE 256
+
+/** the number of times each hasher is run over the sample when timed */
+#define SHASH_TRAINING_ROUNDS 16
+
+/**
+ * the multiple of log2( capacity ) + 1 that a single insertion can probe
+ * before the hash is reseeded
+ */
+#define SHASH_PROBE_FACTOR 4
+
+/** the most worker threads that a parallel build will start */
+#define SHASH_MAX_THREADS 64
+
+/**
+ * log2 of the number of slots in a segment. With 64-bit pointers the slots of
+ * a segment fill a 4 KiB page, and the reference count puts each segment just
+ * past one. The count must stay a power of two so that slots are found by
+ * shifting and masking.
+ */
+#define SHASH_SEGMENT_SHIFT 9
+
+/** the number of slots in a segment */
+#define SHASH_SEGMENT_SIZE ( 1 << SHASH_SEGMENT_SHIFT )
+
+/** the mask giving the position of a slot within its segment */
+#define SHASH_SEGMENT_MASK ( SHASH_SEGMENT_SIZE - 1 )
+
+/**
+ * The slot at an index of an SHash or table. Slots must only be written after
+ * SHashOwn has been called on them, unless the table is new.
+ */
+#define SHASH_SLOT( hash, i ) \
+  ( (hash)->segments[(i) >> SHASH_SEGMENT_SHIFT]->slots[(i) & SHASH_SEGMENT_MASK] )
+
+/**
+ * A reference count shared between snapshots. Where stdatomic.h is available
+ * the increments and decrements of the count are atomic, so that a snapshot
+ * can be released on a different thread than the hash it was taken of.
+ */
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+typedef atomic_size_t shash_references_t;
+#else
+typedef size_t shash_references_t;
+#endif
+
+/** a segment of the slots of an SHash, shared between tables until written */
+struct shash_segment_t {
+  shash_references_t references; /**< the number of tables holding the segment */
+  void *slots[SHASH_SEGMENT_SIZE]; /**< the keys and values in the segment */
+};
+
+/** the segments holding the slots of an SHash, shared between snapshots */
+struct shash_table_t {
+  size_t count; /**< the number of segments */
+  shash_references_t references; /**< the number of hashes holding the table */
+  struct shash_segment_t **segments; /**< the segments, in slot order */
+};
+
 /** the Static Hash container */
 struct shash_t {
   size_t capacity; /**< the number of elements the hash can hold */
   comparator_t compare_keys; /**< the key comparison function */
   comparator_t compare_elements; /**< the element comparison function */
+  size_t defended_size; /**< the size at the last probe-triggered rehash */
+  size_t defenses; /**< the number of probe-triggered rehashes */
   folder_t fold; /**< the folding function */
   hasher_t hash; /**< the hashing function */
+  unsigned short low_water; /**< the load percentage that halves the capacity */
   unsigned long long seed; /**< the seed to use for hashes */
+  struct shash_segment_t **segments; /**< the segments of table */
   size_t size; /**< the number of elements currently in the hash */
-  void **values; /**< the elements */
+  size_t stride; /**< the distance between neighboring keys in the slots */
+  struct shash_table_t *table; /**< the keys and values, laid out as SHashLayout gives */
+  unsigned short training; /**< non-zero if the hasher is yet to be picked */
+  size_t value_offset; /**< the distance from a key to its value in the slots */
 };
 
+/**
+ * The share of a parallel build of an SHash given to a single worker. Each
+ * worker first computes the home slots of a range of the source pairs. The
+ * pairs are then grouped by the worker whose range of slots holds their home,
+ * and each worker places only its own group. Pairs that
+ * probe past the end of that range are left as overflow, to be placed once all
+ * workers are done.
+ */
+struct shash_worker_t {
+  size_t begin; /**< the first slot this worker fills */
+  size_t end; /**< the slot after the last that this worker fills */
+  unsigned short failed; /**< non-zero if the overflow could not grow */
+  size_t fill_first; /**< the first entry of order that this worker places */
+  size_t fill_last; /**< the entry of order after the last this worker places */
+  size_t first; /**< the first source pair to find the home of */
+  shash_t *hash; /**< the SHash being built */
+  unsigned long long *homes; /**< the home slot of each source pair */
+  size_t inserted; /**< the number of new keys this worker placed */
+  void **keys; /**< the source keys, if there is no source SHash */
+  size_t last; /**< the source pair after the last to find the home of */
+  size_t *order; /**< the source pairs, grouped by the worker that places them */
+  size_t *overflow; /**< the source pairs that probed past end */
+  size_t overflow_capacity; /**< the number of pairs overflow can hold */
+  size_t overflow_count; /**< the number of pairs in overflow */
+  const shash_t *source; /**< the SHash holding the source pairs, if any */
+  void **values; /**< the source values, if there is no source SHash */
+};
+
+/**
+ * Fills the empty slots of an SHash from a set of key-value pairs, splitting
+ * the work between worker threads where threads are available. Pairs with a
+ * NULL key or value are skipped, and a later pair replaces an earlier one with
+ * the same key.
+ *
+ * @param hash the SHash to fill, whose table must be new and empty. Must not be
+ * NULL, and must have the capacity to hold every key.
+ * @param source the SHash whose slots are the pairs, or NULL to use keys and
+ * values
+ * @param keys the keys of the pairs, if source is NULL
+ * @param values the values of the pairs, if source is NULL
+ * @param pairs the number of pairs, which is the capacity of source if given
+ * @param threads the number of workers to split the build between
+ *
+ * @return hash, or NULL if memory was not available
+ */
+static
+shash_t *
+SHashBuild
+( shash_t *hash, const shash_t *source, void **keys, void **values, size_t pairs, unsigned threads );
+
+/**
+ * Finds the home slots of a worker's range of source pairs. This is run as
+ * the first pass of SHashBuild.
+ *
+ * @param worker the struct shash_worker_t to run. Must not be NULL.
+ *
+ * @return NULL
+ */
+static
+void *
+SHashComputeHomes
+( void *worker );
+
+/**
+ * Counts the buckets of an SHash that a set of keys are folded into by a
+ * hasher.
+ *
+ * @param hash the SHash giving the seed, folder and capacity. Must not be NULL.
+ * @param hasher the hasher to count the buckets of. Must not be NULL.
+ * @param keys the keys to hash. Must not be NULL.
+ * @param count the number of keys
+ * @param buckets a scratch array of capacity flags, all zero. Must not be NULL.
+ *
+ * @return the number of distinct buckets the keys were folded into
+ */
+static
+size_t
+SHashCountBuckets
+( const shash_t *hash, hasher_t hasher, void **keys, size_t count, unsigned char *buckets );
+
+/**
+ * Defends an SHash against clustering after an insertion probed too far. A
+ * hasher that ignores its seed or is weak against crafted keys is upgraded to
+ * a keyed one where possible, a new seed is picked and the hash is rehashed.
+ *
+ * @param hash the SHash to defend. Must not be NULL.
+ *
+ * @return the SHash that was defended, or NULL if it could not be rehashed, in
+ * which case it is unchanged
+ */
+static
+shash_t *
+SHashDefend
+( shash_t *hash );
+
+/**
+ * Places the source pairs grouped for a worker, all of which have a home in its
+ * range of slots, probing no further than the end of that range. This is run
+ * as the second pass of SHashBuild, after all homes have been found and the
+ * pairs have been grouped.
+ *
+ * @param worker the struct shash_worker_t to run. Must not be NULL.
+ *
+ * @return NULL
+ */
+static
+void *
+SHashFillRange
+( void *worker );
+
 /**
  * Gets the index of a key.
  *
@@ -33,6 +219,106 @@ unsigned long long
 SHashGetIndex
 ( const shash_t *hash, const void *key );
 
+/**
+ * Puts a new key and value into an empty slot of an SHash, then trains the
+ * hasher or defends the hash if the insertion calls for it.
+ *
+ * @param hash the SHash to put into. Must not be NULL.
+ * @param i the index of the empty slot
+ * @param key the key to put. Must not be NULL.
+ * @param value the value to put. Must not be NULL.
+ * @param probes the number of slots probed to find the empty one
+ *
+ * @return value, or NULL if memory was not available
+ */
+/**
+ * Checks whether a hasher gives every key of a sample the same hash, as a
+ * constant stub would. Installing such a hasher would put every key of the
+ * SHash in one probe chain.
+ *
+ * @param hash the SHash giving the seed. Must not be NULL.
+ * @param hasher the hasher to check. Must not be NULL.
+ * @param keys the distinct keys to hash. Must not be NULL.
+ * @param count the number of keys, at least 2
+ *
+ * @return a positive value if every key has the same hash, 0 otherwise
+ */
+static
+unsigned short
+SHashHashesAlike
+( const shash_t *hash, hasher_t hasher, void **keys, size_t count );
+
+static
+void *
+SHashInsert
+( shash_t *hash, unsigned long long i, void *key, void *value, size_t probes );
+
+/**
+ * Creates a table of empty slots, each segment of which is held only by the
+ * new table.
+ *
+ * @param slots the number of slots, which is rounded up to whole segments
+ *
+ * @return the new table, or NULL on failure
+ */
+static
+struct shash_table_t *
+SHashNewTable
+( size_t slots );
+
+/**
+ * Makes a slot of an SHash safe to write, copying its table and then its
+ * segment if either is still shared with a snapshot.
+ *
+ * @param hash the SHash to write to. Must not be NULL.
+ * @param i the index of the slot
+ *
+ * @return hash, or NULL if memory was not available
+ */
+static
+shash_t *
+SHashOwn
+( shash_t *hash, unsigned long long i );
+
+/**
+ * Gets the key of a source pair of a parallel build.
+ *
+ * @param worker the worker building with the pair. Must not be NULL.
+ * @param pair the index of the pair
+ *
+ * @return the key of the pair
+ */
+static
+void *
+SHashPairKey
+( const struct shash_worker_t *worker, size_t pair );
+
+/**
+ * Gets the value of a source pair of a parallel build.
+ *
+ * @param worker the worker building with the pair. Must not be NULL.
+ * @param pair the index of the pair
+ *
+ * @return the value of the pair
+ */
+static
+void *
+SHashPairValue
+( const struct shash_worker_t *worker, size_t pair );
+
+/**
+ * Gets the longest probe an insertion into an SHash may take before the hash
+ * defends itself, which is SHASH_PROBE_FACTOR times log2( capacity ) + 1.
+ *
+ * @param hash the SHash to get the limit of. Must not be NULL.
+ *
+ * @return the probe limit
+ */
+static
+size_t
+SHashProbeLimit
+( const shash_t *hash );
+
 /**
  * Rehashes the keys in an SHash. This is required whenever changes are made
  * to a hash such that the way in which elements are mapped to keys is changed,
@@ -41,13 +327,90 @@ SHashGetIndex
  *
  * This is a costly operation and should be avoided if possible.
  *
-  * @param hash the SHash to rehash. Must not be NULL.
-  *
-  * @return the SHash that was rehashed
+ * The keys are placed in a new table using the given hasher and seed, which
+ * only replace those of the hash once the new table is complete.
+ *
+ * @param hash the SHash to rehash. Must not be NULL.
+ * @param hasher the hashing function to rehash with. Must not be NULL.
+ * @param seed the seed to rehash with
+ *
+ * @return the SHash that was rehashed, or NULL if memory was not available, in
+ * which case the hash is unchanged
  */
 static
 shash_t *
 SHashRehash
-( shash_t *hash );
+( shash_t *hash, hasher_t hasher, unsigned long long seed );
+
+/**
+ * Lets go of a table, freeing it along with any segments that no other table
+ * holds once no hash holds it.
+ *
+ * @param table the table to release. Must not be NULL.
+ */
+static
+void
+SHashReleaseTable
+( struct shash_table_t *table );
+
+/**
+ * A builder for SHashUpsert that returns its context, used to implement
+ * SHashGetOrPut.
+ *
+ * @param key the key being put, which is unused
+ * @param context the value to put
+ *
+ * @return context
+ */
+static
+void *
+SHashReturnContext
+( const void *key, void *context );
+
+/**
+ * Runs a pass of SHashBuild over a set of workers, each on its own thread if
+ * threads are available. A worker whose thread cannot be started is run on
+ * the calling thread instead.
+ *
+ * @param workers the workers to run. Must not be NULL.
+ * @param count the number of workers
+ * @param pass the pass to run each worker through. Must not be NULL.
+ */
+static
+void
+SHashRunWorkers
+( struct shash_worker_t *workers, unsigned count, void *( *pass )( void * ) );
+
+/**
+ * Writes a key and value into a slot of an SHash, first making the slot safe
+ * to write with SHashOwn.
+ *
+ * @param hash the SHash to write to. Must not be NULL.
+ * @param i the index of the slot
+ * @param key the key to write
+ * @param value the value to write
+ *
+ * @return hash, or NULL if memory was not available
+ */
+static
+shash_t *
+SHashStore
+( shash_t *hash, unsigned long long i, void *key, void *value );
+
+/**
+ * Times a hasher over a set of keys, running through them
+ * SHASH_TRAINING_ROUNDS times.
+ *
+ * @param hasher the hasher to time. Must not be NULL.
+ * @param keys the keys to hash. Must not be NULL.
+ * @param count the number of keys
+ * @param seed the seed to hash with
+ *
+ * @return the clocks taken by the hasher
+ */
+static
+clock_t
+SHashTimeHasher
+( hasher_t hasher, void **keys, size_t count, unsigned long long seed );
 
 #endif
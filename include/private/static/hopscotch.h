@@ -0,0 +1,82 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_HOPSCOTCH_H
+#define __WOODPILE_PRIVATE_STATIC_HOPSCOTCH_H
+
+/**
+ * @file
+ * Hopscotch hash definition
+ */
+
+#include <stdint.h>
+#include <woodpile/static/hopscotch.h>
+
+/** the Static Hopscotch hash container */
+struct shopscotch_t {
+  size_t capacity; /**< the number of slots in the hash */
+  comparator_t compare_keys; /**< the key comparison function */
+  folder_t fold; /**< the folding function */
+  hasher_t hash; /**< the hashing function */
+  uint64_t *hops; /**< for each home slot, the neighbors holding its keys */
+  unsigned long long seed; /**< the seed to use for hashes */
+  size_t size; /**< the number of keys currently in the hash */
+  void **values; /**< the keys and values, interleaved */
+};
+
+/**
+ * Finds the slot holding a key in a Hopscotch hash.
+ *
+ * @param hash the Hopscotch hash to search. Must not be NULL.
+ * @param key the key to find. Must not be NULL.
+ * @param home the home slot of the key
+ *
+ * @return the slot holding the key, or the capacity if it is not present
+ */
+static
+size_t
+SHopscotchFind
+( const shopscotch_t *hash, const void *key, size_t home );
+
+/**
+ * Gets the home slot of a key in a Hopscotch hash.
+ *
+ * @param hash the Hopscotch hash to use. Must not be NULL.
+ * @param key the key to get the home slot of. Must not be NULL.
+ *
+ * @return the home slot of the key
+ */
+static
+size_t
+SHopscotchHome
+( const shopscotch_t *hash, const void *key );
+
+/**
+ * Places a key that is not yet present into its neighborhood, moving other keys
+ * to make room if needed.
+ *
+ * @param hash the Hopscotch hash to put into. Must not be NULL.
+ * @param key the key to place. Must not be NULL.
+ * @param value the value of the key. Must not be NULL.
+ * @param home the home slot of the key
+ *
+ * @return value, or NULL if no room could be made in the neighborhood
+ */
+static
+void *
+SHopscotchPlace
+( shopscotch_t *hash, void *key, void *value, size_t home );
+
+/**
+ * Rehashes every key of a Hopscotch hash into new slots. The hasher, folder
+ * and seed of the hash must already be those to rehash with.
+ *
+ * @param hash the Hopscotch hash to rehash. Must not be NULL.
+ * @param capacity the number of slots to rehash into
+ *
+ * @return hash, or NULL if memory was not available or a key could not be
+ * placed, in which case the slots of the hash are unchanged
+ */
+static
+shopscotch_t *
+SHopscotchRehash
+( shopscotch_t *hash, size_t capacity );
+
+#endif
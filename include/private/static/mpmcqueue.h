@@ -0,0 +1,71 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_MPMCQUEUE_H
+#define __WOODPILE_PRIVATE_STATIC_MPMCQUEUE_H
+
+/**
+ * @file
+ * MPMC queue definition
+ */
+
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+/** the size assumed for a cache line when keeping the two ends apart */
+#define SMPMCQUEUE_CACHE_LINE 64
+
+/**
+ * An index or sequence number shared between the threads using an MPMC queue.
+ * Where stdatomic.h is not available these are plain, and the queue may only
+ * be used by one thread.
+ */
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+typedef atomic_size_t smpmcqueue_index_t;
+# define SMPMCQUEUE_CLAIM( index, expected ) \
+  atomic_compare_exchange_weak_explicit( &(index), &(expected), (expected) + 1, \
+                                         memory_order_relaxed, memory_order_relaxed )
+# define SMPMCQUEUE_INIT( index, value ) atomic_init( &(index), (value) )
+# define SMPMCQUEUE_LOAD( index, order ) \
+  atomic_load_explicit( &(index), memory_order_##order )
+# define SMPMCQUEUE_STORE( index, value ) \
+  atomic_store_explicit( &(index), (value), memory_order_release )
+#else
+typedef size_t smpmcqueue_index_t;
+# define SMPMCQUEUE_CLAIM( index, expected ) ( (index) = (expected) + 1 )
+# define SMPMCQUEUE_INIT( index, value ) ( (index) = (value) )
+# define SMPMCQUEUE_LOAD( index, order ) (index)
+# define SMPMCQUEUE_STORE( index, value ) ( (index) = (value) )
+#endif
+
+/**
+ * A slot of an MPMC queue. The sequence of the slot for the element pushed at
+ * position p is p while it is free for that push, p + 1 once the element is
+ * there to pop, and p + capacity once it is free for the push on the next lap.
+ */
+struct smpmcqueue_cell_t {
+  smpmcqueue_index_t sequence; /**< whose turn the slot is */
+  void *element; /**< the element in the slot */
+};
+
+/**
+ * the Static MPMC Queue container
+ *
+ * The indices count every push and pop claimed and are never wrapped. Padding
+ * of a whole cache line is left between the parts written by producers and
+ * consumers, so that they never share a line whatever the alignment of the
+ * queue.
+ */
+struct smpmcqueue_t {
+  size_t capacity; /**< the number of slots in the ring, a power of two */
+  struct smpmcqueue_cell_t *cells; /**< the slots */
+  size_t mask; /**< capacity - 1 */
+  char before_back[SMPMCQUEUE_CACHE_LINE]; /**< keeps back off the fields above */
+  smpmcqueue_index_t back; /**< the next position to push to */
+  char before_front[SMPMCQUEUE_CACHE_LINE]; /**< keeps back and front apart */
+  smpmcqueue_index_t front; /**< the next position to pop from */
+  char after_front[SMPMCQUEUE_CACHE_LINE]; /**< keeps front off what follows */
+};
+
+#endif
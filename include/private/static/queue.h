@@ -6,12 +6,51 @@
  * StaticQueue definition
  */
 
-/** the Queue container */
+#include <woodpile/static/queue.h>
+
+/** the capacity of a Queue made by NewStaticQueue */
+#define SQUEUE_DEFAULT_CAPACITY 128
+
+/**
+ * the Queue container
+ *
+ * The front and back count every pop and push and are never wrapped, so the
+ * size is always back - front and every slot can be used. They are masked
+ * with capacity - 1 to find the slot they refer to.
+ */
 struct StaticQueue {
-  size_t back; /**< the index of the back element + 1 */
-  size_t capacity; /**< the max number of elements held */
+  size_t back; /**< the number of elements ever pushed */
+  size_t capacity; /**< the max number of elements held, a power of two */
   void **elements; /**< the elements */
-  size_t front; /**< the index of the front element */
+  size_t front; /**< the number of elements ever popped */
 };
 
+/**
+ * Gets the smallest power of two that is at least a given number.
+ *
+ * @param capacity the number to round up
+ *
+ * @return the rounded capacity, which is at least 1
+ */
+static
+size_t
+SQueueRoundCapacity
+( size_t capacity );
+
+/**
+ * Moves the elements of a Queue into a new array of a given capacity, with the
+ * front element in the first slot. Elements that do not fit are dropped from
+ * the back.
+ *
+ * @param queue the Queue to resize. Must not be NULL.
+ * @param capacity the new capacity, which must be a power of two
+ *
+ * @return queue, or NULL if memory was not available, in which case the Queue
+ * is unchanged
+ */
+static
+SQueue *
+SQueueResize
+( SQueue *queue, size_t capacity );
+
 #endif
@@ -0,0 +1,62 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_SPSCQUEUE_H
+#define __WOODPILE_PRIVATE_STATIC_SPSCQUEUE_H
+
+/**
+ * @file
+ * SPSC queue definition
+ */
+
+#include <woodpile/config.h>
+#include <woodpile/static/spscqueue.h>
+
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+/** the size assumed for a cache line when keeping the two sides apart */
+#define SSPSCQUEUE_CACHE_LINE 64
+
+/**
+ * An index written by one side of an SPSC queue and read by the other. The
+ * loads and stores made through SSPSCQUEUE_LOAD and SSPSCQUEUE_STORE are
+ * acquire and release where stdatomic.h is available, and volatile otherwise.
+ */
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+typedef atomic_size_t sspscqueue_index_t;
+# define SSPSCQUEUE_LOAD( index, order ) \
+  atomic_load_explicit( &(index), memory_order_##order )
+# define SSPSCQUEUE_STORE( index, value ) \
+  atomic_store_explicit( &(index), (value), memory_order_release )
+#else
+typedef volatile size_t sspscqueue_index_t;
+# define SSPSCQUEUE_LOAD( index, order ) (index)
+# define SSPSCQUEUE_STORE( index, value ) ( (index) = (value) )
+#endif
+
+/** the state of one side of an SPSC queue, kept on a cache line of its own */
+struct sspscqueue_side_t {
+  sspscqueue_index_t index; /**< the number of elements this side has moved */
+  size_t other; /**< the index of the other side when last loaded */
+};
+
+/**
+ * the Static SPSC Queue container
+ *
+ * The indices count every push and pop and are never wrapped, so the size is
+ * always back - front and every slot can be used. They are masked to find the
+ * slot they refer to. Padding of a whole cache line is left between the parts
+ * written by each side, so that they never share a line whatever the
+ * alignment of the queue.
+ */
+struct sspscqueue_t {
+  size_t capacity; /**< the number of slots in the ring, a power of two */
+  void **elements; /**< the slots */
+  size_t mask; /**< capacity - 1 */
+  char before_back[SSPSCQUEUE_CACHE_LINE]; /**< keeps back off the fields above */
+  struct sspscqueue_side_t back; /**< the producer side */
+  char before_front[SSPSCQUEUE_CACHE_LINE]; /**< keeps back and front apart */
+  struct sspscqueue_side_t front; /**< the consumer side */
+  char after_front[SSPSCQUEUE_CACHE_LINE]; /**< keeps front off what follows */
+};
+
+#endif
@@ -16,15 +16,17 @@ struct StaticStack {
 };
 
 /**
- * Doubles the capacity of a Stack.
+ * Enlarges a Stack to a new capacity.
  *
  * @param stack the Stack to enlarge
+ * @param capacity the new capacity, which must not be less than the size
  *
- * @return stack or NULL if memory is not available
+ * @return stack or NULL if memory is not available, in which case the Stack
+ * is unchanged
  */
 static
 SStack *
 Resize
-( SStack *stack );
+( SStack *stack, size_t capacity );
 
 #endif
@@ -0,0 +1,138 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_TINYLFU_H
+#define __WOODPILE_PRIVATE_STATIC_TINYLFU_H
+
+/**
+ * @file
+ * TinyLFU cache definition
+ */
+
+#include <stdint.h>
+#include <woodpile/static/hash.h>
+#include <woodpile/static/tinylfu.h>
+
+/** the index marking the end of a region list */
+#define STINYLFU_NONE ( (size_t) -1 )
+
+/** the number of rows in the frequency sketch */
+#define STINYLFU_ROWS 4
+
+/** the largest value of a sketch counter */
+#define STINYLFU_MAX_COUNT 15
+
+/** the regions an entry of a TinyLFU cache may be kept in */
+enum stinylfu_region_t {
+  STINYLFU_WINDOW = 0, /**< new keys, in least recently used order */
+  STINYLFU_PROBATION, /**< admitted keys not used since */
+  STINYLFU_PROTECTED, /**< admitted keys used again */
+  STINYLFU_REGIONS /**< the number of regions */
+};
+
+/** an entry of a TinyLFU cache, threaded into the list of its region */
+struct stinylfu_entry_t {
+  void *key; /**< the key of the entry */
+  size_t newer; /**< the next more recently used entry */
+  size_t older; /**< the next less recently used entry, or the next free one */
+  unsigned region; /**< the region the entry is kept in */
+  void *value; /**< the value of the entry */
+};
+
+/** the entries of one region of a TinyLFU cache */
+struct stinylfu_list_t {
+  size_t capacity; /**< the most entries the region should hold */
+  size_t newest; /**< the most recently used entry */
+  size_t oldest; /**< the least recently used entry */
+  size_t size; /**< the number of entries in the region */
+};
+
+/** the Static TinyLFU cache container */
+struct stinylfu_t {
+  size_t additions; /**< the counts since the sketch was last halved */
+  size_t capacity; /**< the most entries the cache may hold */
+  void *context; /**< the context given to the evictor */
+  struct stinylfu_entry_t *entries; /**< the pool of entries */
+  void ( *evict )( void *, void *, void * ); /**< the evictor, if any */
+  size_t free; /**< the first free entry */
+  hasher_t hash; /**< the hashing function for the sketch */
+  shash_t *index; /**< maps each key to its entry */
+  struct stinylfu_list_t regions[STINYLFU_REGIONS]; /**< the entries of each region */
+  size_t sample_size; /**< the counts after which the sketch is halved */
+  unsigned long long seed; /**< the seed to use for sketch hashes */
+  uint64_t *sketch; /**< the counters, sixteen to a word, row after row */
+  unsigned sketch_shift; /**< the shift taking a mixed hash to a column */
+  size_t sketch_words; /**< the number of words in each row of the sketch */
+};
+
+/**
+ * Gets the column of the sketch a key is counted in for one row.
+ *
+ * @param cache the TinyLFU cache holding the sketch. Must not be NULL.
+ * @param hash the hash of the key
+ * @param row the row of the sketch
+ *
+ * @return the column of the key in the row
+ */
+static
+size_t
+STinyLFUColumn
+( const stinylfu_t *cache, unsigned long long hash, unsigned row );
+
+/**
+ * Takes an entry out of a TinyLFU cache and gives it to the evictor.
+ *
+ * @param cache the TinyLFU cache to evict from. Must not be NULL.
+ * @param entry the entry to evict
+ */
+static
+void
+STinyLFUEvict
+( stinylfu_t *cache, size_t entry );
+
+/**
+ * Counts a use of a key in the sketch, halving every counter once enough uses
+ * have been counted.
+ *
+ * @param cache the TinyLFU cache to count in. Must not be NULL.
+ * @param key the key used. Must not be NULL.
+ */
+static
+void
+STinyLFUIncrement
+( stinylfu_t *cache, const void *key );
+
+/**
+ * Puts an entry at the most recently used end of the list of a region.
+ *
+ * @param cache the TinyLFU cache holding the entry. Must not be NULL.
+ * @param entry the entry to link, which must not be in any list
+ * @param region the region to link the entry into
+ */
+static
+void
+STinyLFULink
+( stinylfu_t *cache, size_t entry, unsigned region );
+
+/**
+ * Moves the entry that was just used to the front of its region, promoting it
+ * from probation to protected and demoting the protected entry this pushes
+ * out.
+ *
+ * @param cache the TinyLFU cache holding the entry. Must not be NULL.
+ * @param entry the entry used
+ */
+static
+void
+STinyLFUTouch
+( stinylfu_t *cache, size_t entry );
+
+/**
+ * Takes an entry out of the list of its region.
+ *
+ * @param cache the TinyLFU cache holding the entry. Must not be NULL.
+ * @param entry the entry to unlink, which must be in a list
+ */
+static
+void
+STinyLFUUnlink
+( stinylfu_t *cache, size_t entry );
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_TTL_H
+#define __WOODPILE_PRIVATE_STATIC_TTL_H
+
+/**
+ * @file
+ * TTL map definition
+ */
+
+#include <woodpile/static/hash.h>
+#include <woodpile/static/ttl.h>
+
+/** the index marking the end of a slot list */
+#define STTL_NONE ( (size_t) -1 )
+
+/** the cursor of a slot whose entries have not been visited yet */
+#define STTL_START ( (size_t) -2 )
+
+/** an entry of a TTL map, threaded into the list of its wheel slot */
+struct sttl_entry_t {
+  unsigned long long deadline; /**< the tick at which the entry expires */
+  void *key; /**< the key of the entry */
+  size_t next; /**< the next entry in the slot, or the next free one */
+  size_t previous; /**< the previous entry in the slot */
+  void *value; /**< the value of the entry */
+};
+
+/** the entries of a TTL map expiring in one slot of the wheel */
+struct sttl_slot_t {
+  size_t first; /**< the first entry of the slot */
+  size_t last; /**< the last entry of the slot */
+};
+
+/** the Static TTL map container */
+struct sttl_t {
+  size_t capacity; /**< the most entries the map may hold */
+  void *context; /**< the context given to the evictor */
+  size_t cursor; /**< the next entry to visit in the slot of tick */
+  struct sttl_entry_t *entries; /**< the pool of entries */
+  void ( *evict )( void *, void *, void * ); /**< the evictor, if any */
+  size_t free; /**< the first free entry */
+  shash_t *index; /**< maps each key to one more than its entry */
+  size_t mask; /**< the mask taking a tick to its wheel slot */
+  unsigned long long now; /**< the current tick */
+  size_t size; /**< the number of entries in use */
+  struct sttl_slot_t *slots; /**< the wheel */
+  unsigned long long tick; /**< the next tick to sweep the slot of */
+};
+
+/**
+ * Drops an entry from a TTL map and gives it to the evictor.
+ *
+ * @param ttl the TTL map holding the entry. Must not be NULL.
+ * @param entry the entry to expire
+ */
+static
+void
+STTLExpire
+( sttl_t *ttl, size_t entry );
+
+/**
+ * Finds the entry of a key in a TTL map.
+ *
+ * @param ttl the TTL map to search. Must not be NULL.
+ * @param key the key to find. Must not be NULL.
+ *
+ * @return the entry of the key, or STTL_NONE if it is not present
+ */
+static
+size_t
+STTLFind
+( const sttl_t *ttl, const void *key );
+
+/**
+ * Puts an entry at the end of the wheel slot of its deadline.
+ *
+ * @param ttl the TTL map holding the entry. Must not be NULL.
+ * @param entry the entry to link, which must not be in any slot
+ */
+static
+void
+STTLLink
+( sttl_t *ttl, size_t entry );
+
+/**
+ * Takes an entry out of its wheel slot, moving the sweep cursor past it if
+ * needed.
+ *
+ * @param ttl the TTL map holding the entry. Must not be NULL.
+ * @param entry the entry to unlink, which must be in a slot
+ */
+static
+void
+STTLUnlink
+( sttl_t *ttl, size_t entry );
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef __WOODPILE_PRIVATE_STATIC_WSDEQUE_H
+#define __WOODPILE_PRIVATE_STATIC_WSDEQUE_H
+
+/**
+ * @file
+ * Work-stealing deque definition
+ */
+
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+/** the size assumed for a cache line when keeping the two ends apart */
+#define SWSDEQUE_CACHE_LINE 64
+
+struct swsdeque_array_t;
+
+/**
+ * The indices, slots and ring pointer shared between the owner of a
+ * work-stealing deque and its thieves. Where stdatomic.h is not available
+ * these are plain, and the deque may only be used by one thread.
+ */
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+typedef _Atomic( struct swsdeque_array_t * ) swsdeque_array_pointer_t;
+typedef atomic_size_t swsdeque_index_t;
+typedef _Atomic( void * ) swsdeque_slot_t;
+# define SWSDEQUE_CLAIM( index, expected ) \
+  atomic_compare_exchange_strong_explicit( &(index), &(expected), (expected) + 1, \
+                                           memory_order_seq_cst, memory_order_relaxed )
+# define SWSDEQUE_FENCE( order ) atomic_thread_fence( memory_order_##order )
+# define SWSDEQUE_INIT( shared, value ) atomic_init( &(shared), (value) )
+# define SWSDEQUE_LOAD( shared, order ) \
+  atomic_load_explicit( &(shared), memory_order_##order )
+# define SWSDEQUE_STORE( shared, value, order ) \
+  atomic_store_explicit( &(shared), (value), memory_order_##order )
+#else
+typedef struct swsdeque_array_t *swsdeque_array_pointer_t;
+typedef size_t swsdeque_index_t;
+typedef void *swsdeque_slot_t;
+# define SWSDEQUE_CLAIM( index, expected ) ( (index) = (expected) + 1 )
+# define SWSDEQUE_FENCE( order )
+# define SWSDEQUE_INIT( shared, value ) ( (shared) = (value) )
+# define SWSDEQUE_LOAD( shared, order ) (shared)
+# define SWSDEQUE_STORE( shared, value, order ) ( (shared) = (value) )
+#endif
+
+/**
+ * A ring of slots of a work-stealing deque. The element at position p is kept
+ * in slot p & mask.
+ */
+struct swsdeque_array_t {
+  size_t capacity; /**< the number of slots, a power of two */
+  size_t mask; /**< capacity - 1 */
+  struct swsdeque_array_t *outgrown; /**< the ring this one replaced, if any */
+  swsdeque_slot_t *slots; /**< the slots */
+};
+
+/**
+ * the Static Work-Stealing Deque container
+ *
+ * The top and bottom count every steal and push and are never wrapped, so the
+ * size is bottom - top. A pop steps the bottom back before looking at the top,
+ * which can leave the bottom one behind the top for a moment. Padding of a
+ * whole cache line is left between the top, written by thieves, and the
+ * bottom, written by the owner.
+ */
+struct swsdeque_t {
+  char before_top[SWSDEQUE_CACHE_LINE]; /**< keeps top off what precedes */
+  swsdeque_index_t top; /**< the position of the next element to steal */
+  char before_bottom[SWSDEQUE_CACHE_LINE]; /**< keeps top and bottom apart */
+  swsdeque_index_t bottom; /**< the position the next push goes to */
+  swsdeque_array_pointer_t array; /**< the current ring */
+  char after_bottom[SWSDEQUE_CACHE_LINE]; /**< keeps bottom off what follows */
+};
+
+/**
+ * Moves the elements of a work-stealing deque into a ring of twice the
+ * capacity, keeping the old ring for any thief still reading it. May only be
+ * called by the owner.
+ *
+ * @param deque the work-stealing deque to grow. Must not be NULL.
+ * @param top the top of the deque, as last loaded by the owner
+ * @param bottom the bottom of the deque
+ *
+ * @return the new ring, or NULL if memory was not available, in which case
+ * the deque is unchanged
+ */
+static
+struct swsdeque_array_t *
+SWSDequeGrow
+( swsdeque_t *deque, size_t top, size_t bottom );
+
+/**
+ * Creates a ring of slots for a work-stealing deque.
+ *
+ * @param capacity the number of slots, a power of two
+ *
+ * @return the new ring, or NULL if memory was not available
+ */
+static
+struct swsdeque_array_t *
+SWSDequeNewArray
+( size_t capacity );
+
+#endif
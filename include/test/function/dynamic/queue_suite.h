@@ -0,0 +1,77 @@
+#ifndef __WOODPILE_TEST_FUNCTION_DYNAMIC_QUEUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_DYNAMIC_QUEUE_SUITE_H
+
+/**
+ * @file
+ * Queue tests
+ */
+
+#include <woodpile/dynamic/queue.h>
+
+/** the number of distinct values available to the tests, over three blocks */
+#define VALUE_COUNT ( DQUEUE_BLOCK_SIZE * 3 + 7 )
+
+/**
+ * Tests the DQueuePush function with NULL parameters.
+ *
+ * @test Pushing to a NULL DQueue or pushing a NULL element must return NULL
+ * and leave the DQueue empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWithNullParameters
+( void );
+
+/**
+ * Tests the DQueueIsEmpty and DQueueSize functions.
+ *
+ * @test A NULL DQueue and a new DQueue must be empty with a size of 0. The
+ * size must follow pushes and pops.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+/**
+ * Tests the DQueuePeek function.
+ *
+ * @test Peeking at a NULL or empty DQueue must return NULL. Peeking at a
+ * populated DQueue must return the front element without removing it, also
+ * once the front has moved into a later block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPeek
+( void );
+
+/**
+ * Tests a DQueue pushed and popped at a steady size across many blocks.
+ *
+ * @test Elements must come out in the order they were pushed as the front and
+ * back move through block after block, and the DQueue must be empty once they
+ * are all popped.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushAndPopAcrossBlocks
+( void );
+
+/**
+ * Tests filling a DQueue over several blocks, then draining and filling it
+ * again.
+ *
+ * @test Every element must be popped in the order it was pushed both times,
+ * and a pop from the drained DQueue must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRefillAfterDrain
+( void );
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef __WOODPILE_TEST_FUNCTION_HASHER_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_HASHER_SUITE_H
+
+/**
+ * @file
+ * Hasher tests
+ */
+
+#include <stddef.h>
+#include <woodpile/config.h>
+#include <woodpile/hasher.h>
+
+/** the number of blocks in the batches built by BuildBatch */
+#define BATCH_SIZE 203
+
+/** the length of the longest block hashed a piece at a time */
+#define STREAM_LENGTH 300
+
+/**
+ * Fills a buffer with bytes and splits it into a batch of blocks for the batch
+ * hashing tests. The blocks have every length from 0 up to several Spooky
+ * chunks, so that neighboring blocks in the batch need different numbers of
+ * chunks, and start at varying alignments.
+ *
+ * @param buffer the buffer to split. Must be large enough for the blocks.
+ * @param data receives BATCH_SIZE pointers into the buffer
+ * @param lengths receives BATCH_SIZE lengths
+ */
+static
+void
+BuildBatch
+( unsigned char *buffer, const void **data, size_t *lengths );
+
+#ifdef __WOODPILE_CRC_HASHER
+
+/**
+ * Tests the CRCDataHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one CRCDataHash gives for
+ * the same block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCDataHashBatch
+( void );
+
+/**
+ * Tests the CRCDataHash function against the standard CRC32C check value.
+ *
+ * @test The string "123456789" with a seed of 0 must hash to 0xe3069283.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCDataHashCheckValue
+( void );
+
+/**
+ * Tests the CRCHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one CRCHash gives for the
+ * same string.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCHashBatch
+( void );
+
+/**
+ * Tests the CRCHashInit, CRCHashUpdate and CRCHashFinal functions.
+ *
+ * @test Hashing blocks of several lengths split into three pieces at every
+ * possible first cut must give the same value as CRCDataHash does for the
+ * whole block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCHashStream
+( void );
+
+/**
+ * Tests the CRCHash function against the CRCDataHash function.
+ *
+ * @test Hashing a string with CRCHash must give the same value as hashing the
+ * characters of the string with CRCDataHash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCHashMatchesDataHash
+( void );
+
+/**
+ * Tests each of the CRC32C implementations supported by the processor against
+ * the software implementation.
+ *
+ * @test Every hardware implementation available must produce the same checksum
+ * as the software implementation for blocks of every length from 0 to 64 bytes
+ * at every alignment from 0 to 7 bytes.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCImplementationsAgree
+( void );
+
+/**
+ * Tests the effect of the seed on the CRCDataHash function.
+ *
+ * @test Hashing the same data with two different seeds must give two
+ * different values.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCRCSeedChangesHash
+( void );
+
+#endif
+
+/**
+ * Tests the MixedPointerHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one MixedPointerHash
+ * gives for the same pointer.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestMixedPointerHashBatch
+( void );
+
+/**
+ * Tests the MixedPointerHash function with aligned pointers.
+ *
+ * @test Pointers that are all a multiple of 16 apart must reach every bucket
+ * of a table folded with ModFold.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestMixedPointerHashSpreadsAlignedPointers
+( void );
+
+/**
+ * Tests the PointerHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one PointerHash gives for
+ * the same pointer.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPointerHashBatch
+( void );
+
+#ifdef __WOODPILE_SPOOKY_HASHER
+
+/**
+ * Tests the SpookyDataHash128 function with blocks that differ only in
+ * trailing zero bytes.
+ *
+ * @test A block and the same block with a zero byte appended must have
+ * different hashes.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyDataHash128TrailingZeros
+( void );
+
+/**
+ * Tests the halves of the hashes given by the SpookyDataHash128 function.
+ *
+ * @test Hashing a few thousand distinct blocks must never give the same upper
+ * half twice or the same lower half twice.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyDataHash128Unique
+( void );
+
+/**
+ * Tests the SpookyDataHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one SpookyDataHash gives
+ * for the same block, both through the dispatched function and through the
+ * AVX2 implementation if the processor supports it.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyDataHashBatch
+( void );
+
+/**
+ * Tests the SpookyHashInit, SpookyHashUpdate and SpookyHashFinal functions.
+ *
+ * @test Hashing blocks of several lengths split into three pieces at every
+ * possible first cut must give the same value as SpookyDataHash does for the
+ * whole block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyHashStream
+( void );
+
+/**
+ * Tests the SpookyHash128 function against the SpookyDataHash128 function.
+ *
+ * @test Hashing a string with SpookyHash128 must give the same value as
+ * hashing the characters of the string with SpookyDataHash128.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyHash128MatchesDataHash128
+( void );
+
+/**
+ * Tests the SpookyHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one SpookyHash gives for
+ * the same string.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSpookyHashBatch
+( void );
+
+#endif
+
+#ifdef __WOODPILE_WOODPILE_HASHER
+
+/**
+ * Tests the WoodpileDataHash128 function with blocks that a linear checksum
+ * cannot tell apart.
+ *
+ * @test Blocks with the same byte sum and position-weighted sum must differ in
+ * both halves for every seed tried, and blocks differing only by trailing zero
+ * bytes must have different hashes.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileDataHash128Collisions
+( void );
+
+/**
+ * Tests the WoodpileDataHash128 function with reordered data.
+ *
+ * @test Two blocks holding the same bytes in a different order must have
+ * different upper halves.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileDataHash128Order
+( void );
+
+/**
+ * Tests the WoodpileDataHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one WoodpileDataHash
+ * gives for the same block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileDataHashBatch
+( void );
+
+/**
+ * Tests the WoodpileDataHash function against the WoodpileHash function.
+ *
+ * @test Hashing a string with WoodpileHash must give the same value as hashing
+ * the characters of the string with WoodpileDataHash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileHashMatchesDataHash
+( void );
+
+/**
+ * Tests the WoodpileHashInit, WoodpileHashUpdate and WoodpileHashFinal functions.
+ *
+ * @test Hashing blocks of several lengths split into three pieces at every
+ * possible first cut must give the same value as WoodpileDataHash does for the
+ * whole block.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileHashStream
+( void );
+
+/**
+ * Tests the WoodpileHashBatch function.
+ *
+ * @test Each hash in a batch must be the same as the one WoodpileHash gives
+ * for the same string.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestWoodpileHashBatch
+( void );
+
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_BLOCKINGQUEUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_BLOCKINGQUEUE_SUITE_H
+
+/**
+ * @file
+ * Blocking queue tests
+ */
+
+#include <woodpile/config.h>
+
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 1024
+
+/** the number of values passed between threads */
+#define THREADED_VALUES 100000
+
+/** the largest batch popped in the threaded test */
+#define THREADED_BATCH 7
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Pops a single element from a blocking queue, waiting for as long as it
+ * takes.
+ *
+ * @param queue the blocking queue to pop from
+ *
+ * @return the element popped, or NULL if the queue was closed
+ */
+static
+void *
+PopForever
+( void *queue );
+
+/**
+ * Pushes THREADED_VALUES values to a blocking queue in order, waiting for
+ * room for as long as it takes, and then closes the queue.
+ *
+ * @param queue the blocking queue to push to
+ *
+ * @return NULL, or a non-NULL value if a push failed
+ */
+static
+void *
+Produce
+( void *queue );
+#endif
+
+/**
+ * Tests the SBlockingQueueNew function with a capacity of 0.
+ *
+ * @test A queue must not be created with no capacity.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the SBlockingQueuePush function with NULL parameters.
+ *
+ * @test Pushing to a NULL queue or pushing a NULL element must return NULL and
+ * leave the queue empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWithNullParameters
+( void );
+
+/**
+ * Tests the SBlockingQueueCapacity and SBlockingQueueSize functions.
+ *
+ * @test A NULL queue must have a capacity and size of 0. A queue asked for a
+ * capacity of 100 must keep exactly that capacity, and its size must follow
+ * each push and pop.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacityAndSize
+( void );
+
+/**
+ * Tests the SBlockingQueueClose function.
+ *
+ * @test Pushes to a closed queue must fail. Pops must return the elements left
+ * in the queue and then fail without waiting.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestClose
+( void );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Tests the SBlockingQueueClose function with a consumer waiting on an empty
+ * queue.
+ *
+ * @test The waiting consumer must be woken and return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCloseWakesConsumer
+( void );
+#endif
+
+/**
+ * Tests the SBlockingQueuePopBatch function.
+ *
+ * @test A batch must return at most the number of elements asked for, in the
+ * order they were pushed, and fewer if fewer are in the queue. Invalid
+ * parameters must return 0.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopBatch
+( void );
+
+/**
+ * Tests the SBlockingQueuePop function with an empty queue and a timeout.
+ *
+ * @test A pop with a timeout of 0, and one with a timeout of 20 milliseconds,
+ * must both return NULL, the second only after the timeout has passed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopTimesOut
+( void );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Tests a producer pushing many more values than the capacity of a blocking
+ * queue, while a consumer drains it in batches.
+ *
+ * @test The producer must wait for room rather than fail, and the consumer
+ * must receive every value exactly once and in order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWaitsForRoom
+( void );
+#endif
+
+/**
+ * Tests the SBlockingQueuePush function with a full queue and a timeout.
+ *
+ * @test A push to a full queue with a timeout of 0, and one with a timeout of
+ * 20 milliseconds, must both return NULL and leave the queue unchanged.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushTimesOut
+( void );
+
+#endif
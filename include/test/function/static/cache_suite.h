@@ -0,0 +1,163 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_CACHE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_CACHE_SUITE_H
+
+/**
+ * @file
+ * Cache tests
+ */
+
+#include <stddef.h>
+
+/** the number of distinct keys available to the tests */
+#define KEY_COUNT 1024
+
+/** the entries given to an evictor, in the order they were evicted */
+struct eviction_t {
+  size_t count; /**< the number of entries evicted */
+  void *keys[KEY_COUNT]; /**< the keys of the evicted entries */
+  unsigned short mismatched; /**< non-zero if a key came with the wrong value */
+};
+
+/**
+ * An evictor recording each entry it is given in a struct eviction_t. Every
+ * test puts each key with itself as the value.
+ *
+ * @param key the key of the evicted entry
+ * @param value the value of the evicted entry
+ * @param context the struct eviction_t to record into
+ */
+static
+void
+Record
+( void *key, void *value, void *context );
+
+/**
+ * Tests the SCacheGet function with a NULL cache or key.
+ *
+ * @test The function must return NULL for a NULL cache or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithNullParameters
+( void );
+
+/**
+ * Tests the SCacheNew function with no capacity.
+ *
+ * @test A capacity of 0 must give a NULL cache.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the SCachePut function with a NULL cache or key.
+ *
+ * @test The function must return NULL and put nothing for a NULL cache or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutWithNullParameters
+( void );
+
+/**
+ * Tests the SCacheDestroy function with an evictor set.
+ *
+ * @test The evictor must be given every entry still in the cache, from least
+ * to most recently used.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestDestroyWithEvictor
+( void );
+
+/**
+ * Tests the SCacheGet function.
+ *
+ * @test Getting a key must make it the most recently used, so that it is
+ * evicted after every key that was not used since.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetMakesKeyNewest
+( void );
+
+/**
+ * Tests the SCacheIsEmpty function.
+ *
+ * @test NULL and new caches must be empty, and a cache holding a key must not.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmpty
+( void );
+
+/**
+ * Tests the SCachePeek function.
+ *
+ * @test Peeking at a key must give its value without changing how recently
+ * it was used.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPeekKeepsRecency
+( void );
+
+/**
+ * Tests the SCachePut function on a full cache.
+ *
+ * @test Putting new keys into a full cache must evict the least recently used
+ * keys in order, give each to the evictor, and keep the size at the capacity.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutEvictsOldest
+( void );
+
+/**
+ * Tests the SCachePut function with a key that is already present.
+ *
+ * @test The previous value must be returned without being evicted, the new
+ * value must be kept, and the key must become the most recently used.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutExistingKey
+( void );
+
+/**
+ * Tests the SCacheRemove function.
+ *
+ * @test The removed value must be returned without being evicted, the key
+ * must no longer be found, and the freed entry must be used by the next put
+ * instead of evicting another key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemove
+( void );
+
+/**
+ * Tests the SCacheSetKeyComparator function.
+ *
+ * @test Keys that compare equal under the new comparator must be treated as
+ * the same key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetKeyComparator
+( void );
+
+#endif
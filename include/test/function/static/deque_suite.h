@@ -0,0 +1,120 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_DEQUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_DEQUE_SUITE_H
+
+/**
+ * @file
+ * Deque tests
+ */
+
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 64
+
+/**
+ * Tests the SDequePushBack and SDequePushFront functions with NULL parameters.
+ *
+ * @test Pushing to a NULL deque or pushing a NULL element to either end must
+ * return NULL and leave the deque empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWithNullParameters
+( void );
+
+/**
+ * Tests the SDequeSet function with invalid parameters.
+ *
+ * @test Setting an element of a NULL deque, setting a NULL element, or
+ * setting a position past the back must return NULL and change nothing.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetWithInvalidParameters
+( void );
+
+/**
+ * Tests the SDequeCapacity function.
+ *
+ * @test A NULL deque must return 0. A deque asked for a capacity of 100 must
+ * have a capacity of 128, and one asked for 0 must have a capacity of 1.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacity
+( void );
+
+/**
+ * Tests the SDequeGet function with elements pushed to both ends.
+ *
+ * @test Each position must give the element that is that far from the front,
+ * and a position past the back must give NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGet
+( void );
+
+/**
+ * Tests pushing to both ends of a deque well past its first capacity.
+ *
+ * @test The deque must double as it fills, and keep every element in order
+ * from front to back.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGrowFromBothEnds
+( void );
+
+/**
+ * Tests the SDequeIsEmpty and SDequeSize functions.
+ *
+ * @test A NULL deque and a new deque must be empty with a size of 0. The size
+ * must follow pushes and pops at both ends.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+/**
+ * Tests the SDequePeekBack and SDequePeekFront functions.
+ *
+ * @test Peeking at a NULL or empty deque must return NULL. Peeking at a
+ * populated deque must return the element at that end without removing it.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPeek
+( void );
+
+/**
+ * Tests the SDequePopBack and SDequePopFront functions.
+ *
+ * @test Pops from each end must return the elements in order from that end,
+ * wrapping around the ring, and pops from an empty deque must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopFromBothEnds
+( void );
+
+/**
+ * Tests the SDequeSet function.
+ *
+ * @test Setting a position must return the element that was there, and the
+ * new element must be found at that position afterwards.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSet
+( void );
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_DICT_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_DICT_SUITE_H
+
+/**
+ * @file
+ * Dict tests
+ */
+
+#include <stddef.h>
+#include <woodpile/static/dict.h>
+
+/** the number of distinct keys available to the tests */
+#define KEY_COUNT 70000
+
+/** the keys visited by SDictForEach, in the order they were visited */
+struct visit_t {
+  size_t count; /**< the number of keys visited */
+  char **order; /**< the visited keys */
+  unsigned short mismatched; /**< non-zero if a value was not its own key */
+};
+
+/**
+ * Checks that a Dict holds exactly the given keys, each mapped to itself, and
+ * that SDictForEach visits them in the given order.
+ *
+ * @param dict the Dict to check
+ * @param expected the keys in their expected order
+ * @param count the number of expected keys
+ *
+ * @return NULL if the Dict matches or a string describing the failure
+ */
+static
+const char *
+CheckOrder
+( sdict_t *dict, char **expected, size_t count );
+
+/**
+ * Records a key visited by SDictForEach.
+ *
+ * @param key the key visited
+ * @param value the value of the key
+ * @param context the visit_t to record the key in
+ */
+static
+void
+Visit
+( void *key, void *value, void *context );
+
+/**
+ * Tests the SDictForEach function with a NULL action or Dict.
+ *
+ * @test The function must return NULL for a NULL Dict or action.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestForEachWithNullParameters
+( void );
+
+/**
+ * Tests the SDictGet function with a NULL Dict or key.
+ *
+ * @test The function must return NULL for a NULL Dict or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithNullParameters
+( void );
+
+/**
+ * Tests the SDictNewSized function with invalid capacities.
+ *
+ * @test A capacity of 0 must give a NULL Dict.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewSizedWithZeroCapacity
+( void );
+
+/**
+ * Tests the SDictPut function with a NULL Dict or key.
+ *
+ * @test The function must return NULL for a NULL Dict or key, and nothing must
+ * be put.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutWithNullParameters
+( void );
+
+/**
+ * Tests the SDictForEach function on a Dict with keys removed.
+ *
+ * @test The remaining keys must be visited in the order they were put.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestForEachAfterRemove
+( void );
+
+/**
+ * Tests the SDictForEach function on a populated Dict.
+ *
+ * @test Every key must be visited once with its value, in the order the keys
+ * were put, and the context must be passed through.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestForEachInInsertionOrder
+( void );
+
+/**
+ * Tests the SDictGet function with an empty Dict.
+ *
+ * @test NULL must be returned for any key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetFromEmptyDict
+( void );
+
+/**
+ * Tests the SDictGet function with keys that hash to the same slot.
+ *
+ * @test Every key must be found with its own value.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithCollidingKeys
+( void );
+
+/**
+ * Tests the SDictIsEmpty function.
+ *
+ * @test A NULL or new Dict must be empty, and a Dict with a key must not be.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmpty
+( void );
+
+/**
+ * Tests the SDictPut function with a key already in the Dict.
+ *
+ * @test The previous value must be returned and replaced, and the key must
+ * keep its place in the insertion order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutExistingKey
+( void );
+
+/**
+ * Tests the SDictPut function with a full Dict.
+ *
+ * @test A full Dict where a quarter of the entries are removed must be
+ * compacted to make room for a new key, keeping its capacity, while one with
+ * fewer holes must have its capacity doubled. Either way the order of the
+ * entries must be kept.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutIntoFullDict
+( void );
+
+/**
+ * Tests the SDictRemove function.
+ *
+ * @test The value of a removed key must be returned, the key must no longer be
+ * found and removing it again must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemove
+( void );
+
+/**
+ * Tests the SDictSetCapacity function with capacities that need wider index
+ * slots.
+ *
+ * @test Growing past 255 and 65535 entries must keep every key and its order,
+ * and shrinking below the size must fail.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacity
+( void );
+
+/**
+ * Tests the SDictSetHasher function on a populated Dict.
+ *
+ * @test Every key must still be found after the hasher is changed, including
+ * with a hasher that gives every key the same hash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetHasher
+( void );
+
+/**
+ * Tests the SDictSize function.
+ *
+ * @test The size must count keys put, not count keys put twice, and drop when
+ * keys are removed. A NULL Dict must have a size of 0.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSize
+( void );
+
+#endif
@@ -8,6 +8,9 @@
 
 #include <woodpile/config.h>
 
+/** the number of distinct keys used to test building an SHash in parallel */
+#define PAIR_COUNT 20000
+
 #ifdef __WOODPILE_PARAMETER_VALIDATION
 
 /**
@@ -58,6 +61,28 @@ const char *
 TestGetNullKeyFromSHash
 ( void );
 
+/**
+ * Tests the SHashGetOrPut function with NULL parameters.
+ *
+ * @test NULL must be returned and nothing put for a NULL hash, key or value.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetOrPutWithNullParameters
+( void );
+
+/**
+ * Tests the SHashNewFromPairs function with NULL parameters.
+ *
+ * @test NULL must be returned for NULL keys or values.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewFromPairsWithNullParameters
+( void );
+
 /**
  * Tests the SHashPut function with a NULL SHash.
  *
@@ -118,6 +143,18 @@ const char *
 TestRemoveNullKey
 ( void );
 
+/**
+ * Tests the SHashSetCapacity function with a capacity below the size of the
+ * SHash.
+ *
+ * @test The capacity must not be set, and every key must still be found.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacityBelowSize
+( void );
+
 /**
  * Tests the SHashSetCapacity function with a NULL SHash.
  *
@@ -129,6 +166,18 @@ const char *
 TestSetCapacityWithNullSHash
 ( void );
 
+/**
+ * Tests the SHashSetCapacityParallel function with invalid parameters.
+ *
+ * @test NULL must be returned for a NULL hash or a capacity below the size,
+ * and the hash must be left unchanged.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacityParallelWithNullParameters
+( void );
+
 /**
  * Tests the SHashSetElementComparator function with a NULL comparator.
  *
@@ -202,6 +251,29 @@ const char *
 TestSetKeyComparatorWithNullSHash
 ( void );
 
+/**
+ * Tests the SHashSetLowWater function with invalid parameters.
+ *
+ * @test NULL must be returned for a NULL hash or a mark above 25 percent, and
+ * the mark must be left unchanged.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetLowWaterWithInvalidParameters
+( void );
+
+/**
+ * Tests the SHashSnapshot function with a NULL SHash.
+ *
+ * @test NULL must be returned for a NULL hash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSnapshotWithNullSHash
+( void );
+
 /**
  * Tests the SHashToString function with a NULL SHash.
  *
@@ -214,6 +286,17 @@ const char *
 TestToStringWithNullSHash
 ( void );
 
+/**
+ * Tests the SHashUpsert function with NULL parameters.
+ *
+ * @test NULL must be returned for a NULL hash, key or build function.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestUpsertWithNullParameters
+( void );
+
 #endif
 
 /**
@@ -264,6 +347,18 @@ const char *
 TestCopyContents
 ( void );
 
+/**
+ * Tests the SHashCopy function with a hash large enough to span many segments.
+ *
+ * @test Every key must be found in the copy with its value, and changes to the
+ * copy must not be seen in the original.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCopyKeepsEveryKey
+( void );
+
 /**
  * Tests the SHashGet function with an empty SHash.
  *
@@ -286,6 +381,28 @@ const char *
 TestGetFromPopulatedSHash
 ( void );
 
+/**
+ * Tests the SHashGetOrPut function with a key already in the SHash.
+ *
+ * @test The existing value must be returned and kept.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetOrPutExistingKey
+( void );
+
+/**
+ * Tests the SHashGetOrPut function with a key missing from the SHash.
+ *
+ * @test The provided value must be put and returned.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetOrPutNewKey
+( void );
+
 /**
  * Tests the SHashGet function with two keys that have a hash collision.
  *
@@ -298,6 +415,44 @@ const char *
 TestGetWithCollidingKeys
 ( void );
 
+/**
+ * Tests the SHashNewFromPairs function.
+ *
+ * @test Every pair must be found in the new hash when it is built on one
+ * thread and on several, pairs with a NULL key or value must be skipped, and
+ * the last value of a repeated key must be kept.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewFromPairs
+( void );
+
+/**
+ * Tests the hasher used by the SHashNew function.
+ *
+ * @test A new SHash must hash its keys with MixedPointerHash, so that aligned
+ * pointers are spread across all of the buckets.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewUsesMixedPointerHash
+( void );
+
+/**
+ * Tests that SHashPut defends a hash against keys that cluster.
+ *
+ * @test Keys that PointerHash folds into a single bucket must make the hash
+ * switch to MixedPointerHash and count the defense, and every key must still
+ * be found.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutClusteredKeys
+( void );
+
 /**
  * Tests the SHashPut function with a full SHash and a key that already exists
  * in the hash.
@@ -376,6 +531,19 @@ const char *
 TestRemove
 ( void );
 
+/**
+ * Tests the SHashRemove function on a long run of colliding keys.
+ *
+ * @test After removing every third key from a crowded hash, every other key
+ * must still be found, no removed key may be found, and the size must count
+ * only the keys that are left.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemoveFromCrowdedSHash
+( void );
+
 /**
  * Tests the SHashRemove function with a key that does not exist in the
  * SHash.
@@ -400,6 +568,18 @@ const char *
 TestSetCapacity
 ( void );
 
+/**
+ * Tests the SHashSetCapacityParallel function.
+ *
+ * @test Every element must still be found after growing and shrinking a hash
+ * with several threads, in both the interleaved and split layouts.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacityParallel
+( void );
+
 /**
  *  Tests the SHashSetElementComparator function.
  *
@@ -427,6 +607,19 @@ const char *
 TestSetHasher
 ( void );
 
+/**
+ * Tests the SHashSetHasher function with SHashAutoHash.
+ *
+ * @test The hasher must not change until the hash has enough keys to train on.
+ * Once it does, the clustered PointerHash must be replaced by MixedPointerHash
+ * and every key must still be found.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetHasherToAutoHash
+( void );
+
 /**
  * Tests the SHashSetHasher function with a function that has new collisions.
  *
@@ -496,6 +689,33 @@ const char *
 TestSetKeyComparatorWithEqualKeys
 ( void );
 
+/**
+ * Tests the SHashSetLayout function.
+ *
+ * @test Every element must still be found after switching a populated hash to
+ * SHASH_SPLIT, and must stay found when elements are put, removed and the
+ * capacity is changed in that layout, and after switching back to
+ * SHASH_INTERLEAVED.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetLayout
+( void );
+
+/**
+ * Tests the SHashSetLowWater function.
+ *
+ * @test Removing elements must halve the capacity each time the load drops
+ * below the mark, stopping at SHASH_MIN_CAPACITY, and every remaining element
+ * must still be found. A hash without a mark must never shrink.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetLowWater
+( void );
+
 /**
  * Tests the SHashSize function.
  *
@@ -507,6 +727,20 @@ const char *
 TestSize
 ( void );
 
+/**
+ * Tests the SHashSnapshot function.
+ *
+ * @test A snapshot must hold every element the hash held when it was taken,
+ * while elements later put into or replaced in either the hash or the snapshot
+ * must not be seen in the other. The snapshot must stay whole after the hash
+ * is resized and after the hash is destroyed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSnapshot
+( void );
+
 /**
  * Tests the SHashToString function an empty SHash.
  *
@@ -546,4 +780,56 @@ const char *
 TestToStringWithPopulatedSHash
 ( void );
 
+/**
+ * Tests the SHashTrainHasher function with a dictionary.
+ *
+ * @test The trained hasher must be a string hasher that spreads the words,
+ * so the constant CityHash stub must not be picked, and every word must still
+ * be found.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTrainHasherWithDictionary
+( void );
+
+/**
+ * Tests the SHashTrainHasher function with fewer keys than it needs.
+ *
+ * @test With 31 keys the clustered PointerHash must be kept. Once a 32nd key
+ * is added, training must replace it with MixedPointerHash, and every key must
+ * still be found.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTrainHasherWithTooFewKeys
+( void );
+
+/**
+ * Tests the SHashTrimToSize function.
+ *
+ * @test A hash grown far past its size must be trimmed to twice its size with
+ * every element still found, a hash with a single element must be trimmed to
+ * SHASH_MIN_CAPACITY, and a hash that is already small must not change.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTrimToSize
+( void );
+
+/**
+ * Tests the SHashUpsert function with missing and existing keys.
+ *
+ * @test The build function must be called once for a missing key, with the
+ * key and context, and not at all once the key is present. A NULL built value
+ * must not be put.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestUpsert
+( void );
+
 #endif
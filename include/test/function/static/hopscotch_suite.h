@@ -0,0 +1,140 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_HOPSCOTCH_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_HOPSCOTCH_SUITE_H
+
+/**
+ * @file
+ * Hopscotch hash tests
+ */
+
+/** the number of distinct keys available to the tests */
+#define KEY_COUNT 4096
+
+/**
+ * Tests the SHopscotchGet function with a NULL hash or key.
+ *
+ * @test The function must return NULL for a NULL hash or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithNullParameters
+( void );
+
+/**
+ * Tests the SHopscotchNewSized function with no capacity.
+ *
+ * @test A capacity of 0 must give a NULL hash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewSizedWithZeroCapacity
+( void );
+
+/**
+ * Tests the SHopscotchPut function with a NULL hash or key.
+ *
+ * @test The function must return NULL for a NULL hash or key, and nothing must
+ * be put.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutWithNullParameters
+( void );
+
+/**
+ * Tests the SHopscotchGet function with an empty hash.
+ *
+ * @test NULL must be returned for any key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetFromEmptyHash
+( void );
+
+/**
+ * Tests the SHopscotchIsEmpty and SHopscotchSize functions.
+ *
+ * @test A NULL or new hash must be empty with a size of 0. The size must count
+ * each key put once and drop when a key is removed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+/**
+ * Tests the SHopscotchPut function with a key already in the hash.
+ *
+ * @test The previous value must be returned and replaced.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutExistingKey
+( void );
+
+/**
+ * Tests the SHopscotchPut function with keys that all share a home slot.
+ *
+ * @test Exactly SHOPSCOTCH_NEIGHBORHOOD keys must fit, each found with its own
+ * value, after which a put must fail without changing the hash.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutIntoFullNeighborhood
+( void );
+
+/**
+ * Tests the SHopscotchPut function up to a high load.
+ *
+ * @test A hash filled to 95% of its capacity must keep every key within its
+ * neighborhood and find each one.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutToHighLoad
+( void );
+
+/**
+ * Tests the SHopscotchRemove function.
+ *
+ * @test The value of a removed key must be returned, the key must no longer be
+ * found, removing it again must return NULL and other keys must remain.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemove
+( void );
+
+/**
+ * Tests the SHopscotchSetCapacity function.
+ *
+ * @test Growing a populated hash must keep every key, and shrinking it below its
+ * size must fail and leave it unchanged.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacity
+( void );
+
+/**
+ * Tests the SHopscotchSetHasher, SHopscotchSetFolder and SHopscotchSetSeed
+ * functions on a populated hash.
+ *
+ * @test Every key must still be found after each change.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetHashing
+( void );
+
+#endif
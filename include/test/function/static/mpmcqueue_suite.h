@@ -0,0 +1,156 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_MPMCQUEUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_MPMCQUEUE_SUITE_H
+
+/**
+ * @file
+ * MPMC queue tests
+ */
+
+#include <stddef.h>
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 1024
+
+/** the number of producers, and of consumers, in the threaded test */
+#define THREAD_COUNT 4
+
+/** the number of values each producer pushes in the threaded test */
+#define THREAD_VALUES 50000
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/** a producer or consumer of the threaded test */
+struct worker_t {
+  unsigned short failed; /**< non-zero if a consumer saw a value out of order */
+  size_t first; /**< the first value a producer pushes */
+  smpmcqueue_t *queue; /**< the queue shared by every worker */
+};
+
+/**
+ * Pops THREAD_VALUES values from an MPMC queue, yielding whenever it is empty.
+ * Each value is counted as received, and the values of each producer must
+ * arrive in the order they were pushed.
+ *
+ * @param worker the struct worker_t of the consumer
+ *
+ * @return NULL
+ */
+static
+void *
+Consume
+( void *worker );
+
+/**
+ * Pushes THREAD_VALUES values to an MPMC queue in order, starting at the first
+ * value of the worker, yielding whenever the queue is full.
+ *
+ * @param worker the struct worker_t of the producer
+ *
+ * @return NULL
+ */
+static
+void *
+Produce
+( void *worker );
+#endif
+
+/**
+ * Tests the SMPMCQueueNew function with a capacity of 0.
+ *
+ * @test A queue must not be created with no capacity.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the SMPMCQueueTryPop function with a NULL queue.
+ *
+ * @test Popping from a NULL queue must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTryPopFromNullQueue
+( void );
+
+/**
+ * Tests the SMPMCQueueTryPush function with NULL parameters.
+ *
+ * @test Pushing to a NULL queue or pushing a NULL element must return NULL and
+ * leave the queue empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTryPushWithNullParameters
+( void );
+
+/**
+ * Tests the SMPMCQueueCapacity function.
+ *
+ * @test A NULL queue must return 0. A queue asked for a capacity of 100 must
+ * have a capacity of 128, and one asked for 1 must have a capacity of 2.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacity
+( void );
+
+/**
+ * Tests the SMPMCQueueIsEmpty and SMPMCQueueSize functions.
+ *
+ * @test A NULL queue and a new queue must be empty with a size of 0. The size
+ * must follow each push and pop.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Tests an MPMC queue with several producers and consumers at once, through a
+ * ring small enough to be full and empty often.
+ *
+ * @test Every value must be received exactly once, and the values of each
+ * producer must reach each consumer in the order they were pushed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestManyThreads
+( void );
+#endif
+
+/**
+ * Tests the SMPMCQueueTryPop function as the positions wrap around the ring
+ * many times.
+ *
+ * @test Every element must be popped once, in the order it was pushed, and a
+ * drained queue must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTryPopInOrderAcrossWraps
+( void );
+
+/**
+ * Tests the SMPMCQueueTryPush function with a full queue.
+ *
+ * @test A push to a full queue must fail, and succeed again once an element
+ * has been popped.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTryPushToFullQueue
+( void );
+
+#endif
@@ -6,6 +6,21 @@
  * Queue tests
  */
 
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 12
+
+/**
+ * Tests the QueueCapacity function.
+ *
+ * @test A NULL Queue must return 0, and a new Queue must have the default
+ * capacity of 128.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacity
+( void );
+
 /**
  * Tests the QueueContains function with a value existing multiple times in the
  * Queue.
@@ -188,6 +203,18 @@ const char *
 TestNew
 ( void );
 
+/**
+ * Tests the NewSizedQueue function.
+ *
+ * @test A Queue asked for a capacity of 100 must be empty and have a capacity
+ * of 128. A Queue asked for a capacity of 0 must have a capacity of 1.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewSized
+( void );
+
 /**
  * Tests the PeekAtQueue function with an Empty Queue.
  *
@@ -255,6 +282,20 @@ const char *
 TestPopFromPopulatedQueue
 ( void );
 
+/**
+ * Tests the PopNFromQueue function with values that wrap around the end of the
+ * ring.
+ *
+ * @test A NULL Queue or array must return 0. Popping part of the Queue and
+ * then more than the rest must return the values in the order they were
+ * pushed, and leave the Queue empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopNAcrossWrap
+( void );
+
 /**
  * Tests the PopFromQueue function to make sure it removes the value returned.
  *
@@ -268,6 +309,19 @@ const char *
 TestPopRemovesValue
 ( void );
 
+/**
+ * Tests the PushNToQueue function with NULL parameters.
+ *
+ * @test Pushing to a NULL Queue, or from a NULL array, must return NULL unless
+ * no values are pushed. Pushing an array holding a NULL value must return NULL
+ * and push nothing.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushNWithNullParameters
+( void );
+
 /**
  * Tests the PushToQueue function with a NULL value.
  *
@@ -280,6 +334,33 @@ const char *
 TestPushNullValue
 ( void );
 
+/**
+ * Tests the PushToQueue function with a full Queue whose elements wrap around
+ * the end of the ring.
+ *
+ * @test Pushes to a full Queue must succeed and double its capacity, and the
+ * values must be popped in the order they were pushed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushGrowsWrappedQueue
+( void );
+
+/**
+ * Tests the PushNToQueue function with values that wrap around the end of the
+ * ring, and with more values than the Queue has room for.
+ *
+ * @test Values that fit must not grow the Queue. Values that do not fit must
+ * grow it once, by doubling or straight to a power of two holding them, and
+ * every value must be popped in the order it was pushed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushNAcrossWrap
+( void );
+
 /**
  * Tests the PushToQueue function with an empty Queue.
  *
@@ -391,6 +472,42 @@ const char *
 TestRemoveUniqueValue
 ( void );
 
+/**
+ * Tests the RemoveFromQueue function with a value at the end of the ring,
+ * followed by values wrapped around to its start.
+ *
+ * @test The value must be removed, and the values after it must move forward
+ * across the wrap in order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemoveWrappedValue
+( void );
+
+/**
+ * Tests the SetQueueCapacity function with a capacity smaller than the size.
+ *
+ * @test The capacity must be rounded up to a power of two, and only the values
+ * at the front that fit in it must be kept, in order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacityDropsBack
+( void );
+
+/**
+ * Tests the SetQueueCapacity function with a NULL Queue.
+ *
+ * @test Setting the capacity of a NULL Queue must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacityOfNullQueue
+( void );
+
 /**
  * Tests the QueueSize function.
  *
@@ -424,4 +541,16 @@ const char *
 TestSizeWithNullQueue
 ( void );
 
+/**
+ * Tests the TrimQueueToSize function.
+ *
+ * @test A NULL Queue must return 0. A Queue of capacity 64 holding 5 values
+ * must be trimmed to a capacity of 8, keeping its values in order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTrimToSize
+( void );
+
 #endif
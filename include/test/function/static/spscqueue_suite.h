@@ -0,0 +1,140 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_SPSCQUEUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_SPSCQUEUE_SUITE_H
+
+/**
+ * @file
+ * SPSC queue tests
+ */
+
+#include <woodpile/config.h>
+
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 1024
+
+/** the number of values passed between threads */
+#define THREADED_VALUES 200000
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Pushes THREADED_VALUES values to an SPSC queue in order, yielding whenever
+ * the queue is full.
+ *
+ * @param queue the SPSC queue to push to
+ *
+ * @return NULL
+ */
+static
+void *
+Produce
+( void *queue );
+#endif
+
+/**
+ * Tests the SSPSCQueueNew function with a capacity of 0.
+ *
+ * @test A queue must not be created with no capacity.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the SSPSCQueuePop function with a NULL queue.
+ *
+ * @test Popping from a NULL queue must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopFromNullQueue
+( void );
+
+/**
+ * Tests the SSPSCQueuePush function with NULL parameters.
+ *
+ * @test Pushing to a NULL queue or pushing a NULL element must return NULL and
+ * leave the queue empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWithNullParameters
+( void );
+
+/**
+ * Tests the SSPSCQueueCapacity function.
+ *
+ * @test A NULL queue must return 0, and a queue asked for a capacity of 100
+ * must have a capacity of 128.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacity
+( void );
+
+/**
+ * Tests the SSPSCQueueIsEmpty and SSPSCQueueSize functions.
+ *
+ * @test A NULL queue and a new queue must be empty with a size of 0. The size
+ * must follow each push and pop.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+/**
+ * Tests the SSPSCQueuePeek function.
+ *
+ * @test Peeking at an empty queue must return NULL. Peeking at a populated
+ * queue must return the front element without removing it.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPeek
+( void );
+
+/**
+ * Tests the SSPSCQueuePop function as the indices wrap around the ring many
+ * times.
+ *
+ * @test Every element must be popped once, in the order it was pushed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopInOrderAcrossWraps
+( void );
+
+/**
+ * Tests the SSPSCQueuePush function with a full queue.
+ *
+ * @test A push to a full queue must fail, and succeed again once an element
+ * has been popped.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushToFullQueue
+( void );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Tests an SPSC queue with a producer and a consumer on separate threads,
+ * through a ring small enough to be full and empty often.
+ *
+ * @test The consumer must receive every value exactly once and in order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestTwoThreads
+( void );
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_STACK_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_STACK_SUITE_H
+
+/**
+ * @file
+ * Stack tests
+ */
+
+/** the number of distinct values available to the tests */
+#define VALUE_COUNT 64
+
+/**
+ * Tests the PushNToStack and PopNFromStack functions together.
+ *
+ * @test Values pushed as an array must come back off the top of the Stack in
+ * the order they were pushed, a batch at a time, and pushing a popped batch
+ * must restore the Stack. A NULL Stack or array must pop nothing.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushNAndPopN
+( void );
+
+/**
+ * Tests the PushNToStack function with more values than the Stack has room
+ * for.
+ *
+ * @test The Stack must grow once to hold every value, and the values must be
+ * popped one at a time in reverse order.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushNGrows
+( void );
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_TINYLFU_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_TINYLFU_SUITE_H
+
+/**
+ * @file
+ * TinyLFU cache tests
+ */
+
+#include <stddef.h>
+
+/** the number of distinct keys available to the tests */
+#define KEY_COUNT 4096
+
+/** the entries given to an evictor */
+struct eviction_t {
+  size_t count; /**< the number of entries evicted */
+  unsigned short mismatched; /**< non-zero if a key came with the wrong value */
+};
+
+/**
+ * An evictor counting each entry it is given in a struct eviction_t. Every
+ * test puts each key with itself as the value.
+ *
+ * @param key the key of the evicted entry
+ * @param value the value of the evicted entry
+ * @param context the struct eviction_t to count in
+ */
+static
+void
+Count
+( void *key, void *value, void *context );
+
+/**
+ * Tests the STinyLFUGet function with a NULL cache or key.
+ *
+ * @test The function must return NULL for a NULL cache or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithNullParameters
+( void );
+
+/**
+ * Tests the STinyLFUNew function with no capacity.
+ *
+ * @test A capacity of 0 must give a NULL cache.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the STinyLFUPut function with a NULL cache or key.
+ *
+ * @test The function must return NULL and put nothing for a NULL cache or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutWithNullParameters
+( void );
+
+/**
+ * Tests the admission of a key pushed out of the window of a full cache.
+ *
+ * @test A key used more often than the probation victim must be admitted, and
+ * the victim evicted in its place.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestAdmitFrequentKey
+( void );
+
+/**
+ * Tests the STinyLFUDestroy function with an evictor set.
+ *
+ * @test The evictor must be given every entry still in the cache.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestDestroyWithEvictor
+( void );
+
+/**
+ * Tests the STinyLFUFrequency function.
+ *
+ * @test Every get and put of a key must be counted, whether the key is in the
+ * cache or not, up to a most of 15, and peeks must not be counted.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestFrequencyCountsUses
+( void );
+
+/**
+ * Tests the aging of the frequency sketch.
+ *
+ * @test After ten counts for each column of the sketch, the estimate of a key
+ * must have been halved.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestFrequencyIsHalved
+( void );
+
+/**
+ * Tests the STinyLFUIsEmpty function.
+ *
+ * @test NULL and new caches must be empty, and a cache holding a key must not.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmpty
+( void );
+
+/**
+ * Tests the STinyLFUPut function with a key that is already present.
+ *
+ * @test The previous value must be returned without being evicted, and the
+ * new value must be kept.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutExistingKey
+( void );
+
+/**
+ * Tests the STinyLFUPut function with many more keys than the capacity.
+ *
+ * @test The size must never pass the capacity, and every key not kept must be
+ * given to the evictor, for caches of several capacities.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutKeepsCapacity
+( void );
+
+/**
+ * Tests the STinyLFURemove function.
+ *
+ * @test The removed value must be returned without being evicted, the key
+ * must no longer be found, and the freed entry must be reused.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemove
+( void );
+
+/**
+ * Tests a scan of keys used once through a cache holding keys used often.
+ *
+ * @test None of the keys used often may be evicted by the scan.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestScanKeepsFrequentKeys
+( void );
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_TTL_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_TTL_SUITE_H
+
+/**
+ * @file
+ * TTL map tests
+ */
+
+#include <stddef.h>
+
+/** the number of distinct keys available to the tests */
+#define KEY_COUNT 1024
+
+/** the entries given to an evictor */
+struct eviction_t {
+  size_t count; /**< the number of entries evicted */
+  unsigned short mismatched; /**< non-zero if a key came with the wrong value */
+};
+
+/**
+ * An evictor counting each entry it is given in a struct eviction_t. Every
+ * test puts each key with itself as the value.
+ *
+ * @param key the key of the evicted entry
+ * @param value the value of the evicted entry
+ * @param context the struct eviction_t to count in
+ */
+static
+void
+Count
+( void *key, void *value, void *context );
+
+/**
+ * Tests the STTLGet function with a NULL map or key.
+ *
+ * @test The function must return NULL for a NULL map or key.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetWithNullParameters
+( void );
+
+/**
+ * Tests the STTLNew function with no capacity or wheel slots.
+ *
+ * @test A capacity or slot count of 0 must give a NULL map.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroSizes
+( void );
+
+/**
+ * Tests the STTLPut function with a NULL map or key or no lifetime.
+ *
+ * @test The function must return NULL and put nothing for a NULL map or key or
+ * a lifetime of 0.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutWithInvalidParameters
+( void );
+
+/**
+ * Tests the STTLAdvance function with lifetimes longer than the wheel.
+ *
+ * @test Each entry must expire on the tick of its deadline and not before,
+ * whether its deadline is in the first turn of the wheel or a later one.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestAdvanceExpiresOnDeadline
+( void );
+
+/**
+ * Tests the STTLAdvance function with a jump of many turns of the wheel.
+ *
+ * @test Every entry must be expired, with work bounded by the size of the
+ * wheel rather than the number of ticks passed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestAdvancePastWholeWheel
+( void );
+
+/**
+ * Tests the STTLAdvance function with a work budget.
+ *
+ * @test No call may expire more entries than its budget, and repeated calls
+ * must expire every entry, telling the evictor of each.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestAdvanceWithBudget
+( void );
+
+/**
+ * Tests the STTLGet function on an entry past its deadline.
+ *
+ * @test The entry must be found until its deadline and missed from then on,
+ * being dropped and given to the evictor even if the wheel has not reached it.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestGetDropsExpiredEntry
+( void );
+
+/**
+ * Tests the STTLIsEmpty function.
+ *
+ * @test NULL and new maps must be empty, and a map holding a key must not.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmpty
+( void );
+
+/**
+ * Tests the STTLPut function with a key that is already present.
+ *
+ * @test The previous value must be returned, and the deadline must be moved
+ * to the new lifetime.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPutExistingKey
+( void );
+
+/**
+ * Tests the STTLRemove function.
+ *
+ * @test The removed value must be returned without being evicted, the key
+ * must no longer be found, and the entry must not be expired later.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestRemove
+( void );
+
+/**
+ * Tests the STTLSetCapacity function.
+ *
+ * @test A full map must refuse new keys until it is grown, after which every
+ * key must be found and expire as before.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestSetCapacity
+( void );
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef __WOODPILE_TEST_FUNCTION_STATIC_WSDEQUE_SUITE_H
+#define __WOODPILE_TEST_FUNCTION_STATIC_WSDEQUE_SUITE_H
+
+/**
+ * @file
+ * Work-stealing deque tests
+ */
+
+#include <stddef.h>
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+# include <stdatomic.h>
+#endif
+
+/** the number of values the owner pushes in the threaded test */
+#define OWNER_VALUES 200000
+
+/** the number of thieves in the threaded test */
+#define THIEF_COUNT 3
+
+/** the number of distinct values available to the other tests */
+#define VALUE_COUNT 100
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+/** a thief of the threaded test */
+struct thief_t {
+  swsdeque_t *deque; /**< the deque of the owner */
+  atomic_int *done; /**< set once the owner has pushed every value */
+  unsigned short failed; /**< non-zero if the thief stole a value out of order */
+};
+
+/**
+ * Steals from a work-stealing deque until the owner is done and the deque is
+ * empty. Each value is counted as received, and each value stolen must have
+ * been pushed after the one the thief stole before it.
+ *
+ * @param worker the struct thief_t of the thief
+ *
+ * @return NULL
+ */
+static
+void *
+Steal
+( void *worker );
+#endif
+
+/**
+ * Tests the SWSDequeNew function with a capacity of 0.
+ *
+ * @test NULL must be returned.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestNewWithZeroCapacity
+( void );
+
+/**
+ * Tests the SWSDequePop function with a NULL deque.
+ *
+ * @test NULL must be returned.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopFromNullDeque
+( void );
+
+/**
+ * Tests the SWSDequePush function with NULL parameters.
+ *
+ * @test Pushing to a NULL deque or pushing a NULL element must return NULL
+ * and leave the deque empty.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushWithNullParameters
+( void );
+
+/**
+ * Tests the SWSDequeSteal function with a NULL deque.
+ *
+ * @test NULL must be returned.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestStealFromNullDeque
+( void );
+
+/**
+ * Tests the SWSDequeCapacity function.
+ *
+ * @test A NULL deque must return 0, and a deque asked for a capacity of 100
+ * must have a capacity of 128.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestCapacity
+( void );
+
+/**
+ * Tests the SWSDequeIsEmpty and SWSDequeSize functions.
+ *
+ * @test A NULL deque and a new deque must be empty with a size of 0. The size
+ * must follow pushes, pops and steals.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestIsEmptyAndSize
+( void );
+
+/**
+ * Tests the SWSDequePop function.
+ *
+ * @test Pops must return the elements in the reverse of the order they were
+ * pushed, and a pop from an empty deque must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPopInReverseOrder
+( void );
+
+/**
+ * Tests pushing to a full deque whose top has moved around the ring.
+ *
+ * @test The capacity must double each time the deque is full, and steals and
+ * pops must still find every element at its own end.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestPushGrowsWrappedDeque
+( void );
+
+/**
+ * Tests the SWSDequeSteal function.
+ *
+ * @test Steals must return the elements in the order they were pushed, and a
+ * steal from an empty deque must return NULL.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestStealInOrder
+( void );
+
+/**
+ * Tests thieves stealing from a deque while its owner pushes and pops.
+ *
+ * @test Every value must be either popped by the owner or stolen by a thief,
+ * exactly once, and each thief must steal values in the order they were
+ * pushed.
+ *
+ * @return NULL on completion or a string describing the failure
+ */
+const char *
+TestStealWhileOwnerWorks
+( void );
+
+#endif
@@ -19,6 +19,19 @@ unsigned long long
 CollisionHash
 ( const void *data, unsigned long long seed );
 
+/**
+ * Builds a value for SHashUpsert by returning the key, counting each call in
+ * the int that the context points to.
+ *
+ * @param key the key to build a value for
+ * @param context a pointer to the call count, or NULL to build no value
+ *
+ * @return key, or NULL if context is NULL
+ */
+void *
+CountingBuilder
+( const void *key, void *context );
+
 /**
  * Converts the provided element to a string. Does conversion by simply
  * casting the element to a char pointer and returning it.
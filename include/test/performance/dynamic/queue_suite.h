@@ -0,0 +1,51 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_DYNAMIC_QUEUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_DYNAMIC_QUEUE_SUITE_H
+
+/**
+ * @file
+ * Dynamic Queue performance tests
+ */
+
+#include <time.h>
+
+/**
+ * Gets the wall time that has passed since a point.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+/**
+ * Pushes every value into a new DQueue and then into a new SQueue of the
+ * default capacity, letting each grow as it fills, then pops them all. This is
+ * done twice with the same DQueue, so the second round shows the cost once the
+ * blocks freed by the first are there to be allocated again. Reports the time
+ * taken for each half.
+ *
+ * @param count the number of values to push
+ * @param values the values to push, at least count long
+ */
+static
+void
+MeasureGrowth
+( size_t count, char *values );
+
+/**
+ * Keeps a DQueue and an SQueue at a steady depth, pushing one value and
+ * popping one for every operation. Reports the millions of push and pop pairs
+ * done each second by each.
+ *
+ * @param depth the number of values to keep in the queues
+ * @param values the values to push, at least depth long
+ */
+static
+void
+MeasureSteadyState
+( size_t depth, char *values );
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_HASHER_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_HASHER_SUITE_H
+
+/**
+ * @file
+ * Hasher performance tests
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <woodpile/hasher.h>
+
+/**
+ * Hashes all of the words as a single batch a number of times and reports the
+ * time taken.
+ *
+ * @param name the name of the hasher to print in the report
+ * @param batch_hasher the batch hasher to measure
+ * @param words the words to hash
+ * @param word_count the number of words
+ */
+static
+void
+MeasureBatchSpeed
+( const char *name, batch_hasher_t batch_hasher, char **words, size_t word_count );
+
+/**
+ * Hashes each of the words into a set of buckets and reports how evenly the
+ * words were spread across them. The report includes the number of empty
+ * buckets, the size of the largest bucket, and the chi-squared statistic of
+ * the bucket sizes, which is close to the number of buckets for a hasher that
+ * distributes the words uniformly.
+ *
+ * @param name the name of the hasher to print in the report
+ * @param hasher the hasher to measure
+ * @param words the words to hash
+ * @param word_count the number of words
+ */
+static
+void
+MeasureDistribution
+( const char *name, hasher_t hasher, char **words, size_t word_count );
+
+/**
+ * Hashes each of the words a number of times and reports the time taken.
+ *
+ * @param name the name of the hasher to print in the report
+ * @param hasher the hasher to measure
+ * @param words the words to hash
+ * @param word_count the number of words
+ */
+static
+void
+MeasureSpeed
+( const char *name, hasher_t hasher, char **words, size_t word_count );
+
+/**
+ * Reads each line of the stream into a separately allocated word, without
+ * the trailing newline.
+ *
+ * @param stream the stream to read the words from
+ * @param word_count set to the number of words read
+ *
+ * @return an array of the words read, or NULL on failure
+ */
+static
+char **
+ReadWords
+( FILE *stream, size_t *word_count );
+
+#endif
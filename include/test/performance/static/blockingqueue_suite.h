@@ -0,0 +1,66 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_BLOCKINGQUEUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_BLOCKINGQUEUE_SUITE_H
+
+/**
+ * @file
+ * Blocking queue performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/blockingqueue.h>
+
+/** the most producers measured at once */
+#define MAX_PRODUCERS 4
+
+/** a producer pushing its share of the values */
+struct producer_t {
+  size_t count; /**< the number of values to push */
+  size_t first; /**< the first value to push */
+  sblockingqueue_t *queue; /**< the queue shared by every producer */
+};
+
+/**
+ * Gets the wall time that has passed since a point, which unlike clock()
+ * does not add together the time spent on each thread.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Passes TRANSFER_VALUES values from producer threads to the calling thread
+ * through a blocking queue, with the calling thread popping up to a number of
+ * values at a time. Reports the millions of values passed each second and the
+ * average size of the batches popped.
+ *
+ * @param producers the number of producer threads, at most MAX_PRODUCERS
+ * @param batch the most values to pop at once, at most MAX_BATCH
+ */
+static
+void
+MeasureBlockingQueue
+( unsigned producers, size_t batch );
+
+/**
+ * Pushes the count of values of a producer, starting at its first value,
+ * waiting for room for as long as it takes.
+ *
+ * @param producer the struct producer_t of the producer
+ *
+ * @return NULL
+ */
+static
+void *
+Produce
+( void *producer );
+#endif
+
+#endif
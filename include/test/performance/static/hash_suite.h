@@ -8,6 +8,21 @@
 
 #include <stdio.h>
 #include <time.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hash.h>
+
+/**
+ * Gets the wall time that has passed since a point, which unlike clock()
+ * does not add together the time spent on each thread.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
 
 /**
  * Loads the given SHash with values. The keys are read from the provided
@@ -24,4 +39,50 @@ clock_t
 LoadSHash
 ( shash_t *hash, FILE *stream );
 
+/**
+ * Loads an SHash with pointer keys and then looks each of them up, reporting
+ * the time taken along with the probe lengths the keys needed. The probe
+ * lengths are found by replaying the insertions into a table of home slots
+ * using the same hasher, folder, capacity and seed as the SHash.
+ *
+ * @param name the name of the configuration to print in the report
+ * @param hasher the hasher for the SHash to use
+ * @param folder the folder for the SHash to use
+ * @param keys the keys to load into the SHash
+ * @param key_count the number of keys
+ */
+static
+void
+MeasurePointerSHash
+( const char *name, hasher_t hasher, folder_t folder, void **keys, size_t key_count );
+
+/**
+ * Fills an SHash to a load and then looks up keys that are all missing,
+ * reporting the time taken. Misses probe until they reach an empty slot
+ * without ever reading a value, which is where the layouts differ most.
+ *
+ * @param name the name of the configuration to print in the report
+ * @param layout the layout for the SHash to use
+ * @param load the percentage of the capacity to fill
+ * @param keys a pool of distinct keys, at least twice MISS_CAPACITY long
+ */
+static
+void
+MeasureMissHeavySHash
+( const char *name, unsigned short layout, unsigned load, char *keys );
+
+/**
+ * Builds an SHash from a set of pairs and then doubles its capacity, reporting
+ * the wall time each step took.
+ *
+ * @param threads the number of threads to build and resize with, or 0 to put
+ * the pairs one at a time and resize with SHashSetCapacity
+ * @param pairs the pointers to use as both keys and values
+ * @param count the number of pairs
+ */
+static
+void
+MeasureParallelBuild
+( unsigned threads, void **pairs, size_t count );
+
 #endif
@@ -0,0 +1,37 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_HOPSCOTCH_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_HOPSCOTCH_SUITE_H
+
+/**
+ * @file
+ * Hopscotch hash performance tests
+ */
+
+#include <stddef.h>
+
+/**
+ * Fills a Hopscotch hash to a load, then looks up every key put and as many
+ * keys that are missing, reporting the time taken by each and the number of
+ * puts that found no room.
+ *
+ * @param load the percentage of the capacity to fill
+ * @param keys a pool of distinct keys, at least twice HOPSCOTCH_CAPACITY long
+ */
+static
+void
+MeasureSHopscotch
+( unsigned load, char *keys );
+
+/**
+ * Fills an SHash to a load, then looks up every key put and as many keys that
+ * are missing, reporting the time taken by each, for comparison with the
+ * Hopscotch hash.
+ *
+ * @param load the percentage of the capacity to fill
+ * @param keys a pool of distinct keys, at least twice HOPSCOTCH_CAPACITY long
+ */
+static
+void
+MeasureSHash
+( unsigned load, char *keys );
+
+#endif
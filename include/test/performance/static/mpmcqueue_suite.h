@@ -0,0 +1,78 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_MPMCQUEUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_MPMCQUEUE_SUITE_H
+
+/**
+ * @file
+ * MPMC queue performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+
+/** the most producers, and the most consumers, measured at once */
+#define MAX_THREADS 8
+
+/** a producer or consumer moving its share of the values */
+struct worker_t {
+  size_t count; /**< the number of values to push or pop */
+  size_t first; /**< the first value a producer pushes */
+  smpmcqueue_t *queue; /**< the queue shared by every worker */
+};
+
+/**
+ * Gets the wall time that has passed since a point, which unlike clock()
+ * does not add together the time spent on each thread.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Pops the count of values of a consumer, yielding whenever the queue is
+ * empty.
+ *
+ * @param worker the struct worker_t of the consumer
+ *
+ * @return NULL
+ */
+static
+void *
+Consume
+( void *worker );
+
+/**
+ * Passes TRANSFER_VALUES values through an MPMC queue, split evenly between
+ * the producers and between the consumers, and reports the millions of values
+ * passed each second.
+ *
+ * @param producers the number of producer threads, at most MAX_THREADS
+ * @param consumers the number of consumer threads, at most MAX_THREADS
+ */
+static
+void
+MeasureMPMCQueue
+( unsigned producers, unsigned consumers );
+
+/**
+ * Pushes the count of values of a producer, starting at its first value,
+ * yielding whenever the queue is full.
+ *
+ * @param worker the struct worker_t of the producer
+ *
+ * @return NULL
+ */
+static
+void *
+Produce
+( void *worker );
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_QUEUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_QUEUE_SUITE_H
+
+/**
+ * @file
+ * Queue performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+
+/** a fixed ring stepped with a division, as SQueue was before it was masked */
+struct modulo_ring_t {
+  size_t back; /**< the index of the back element + 1 */
+  size_t capacity; /**< the number of slots in the ring */
+  void **elements; /**< the slots */
+  size_t front; /**< the index of the front element */
+};
+
+/**
+ * Gets the wall time that has passed since a point.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+/**
+ * Pushes a batch of values into a Queue and pops them back out, over and over,
+ * first one value at a time and then with SQueuePushN and SQueuePopN. Reports
+ * the millions of values pushed and popped each second both ways.
+ *
+ * @param batch the number of values in each batch, at most MAX_BATCH
+ * @param values the values to push, at least batch long
+ */
+static
+void
+MeasureBatches
+( size_t batch, char *values );
+
+/**
+ * Pushes every value into a new Queue of the default capacity, letting it grow
+ * as it fills, then pops them all. Reports the time taken for each half.
+ *
+ * @param values the values to push, GROWTH_VALUES long
+ */
+static
+void
+MeasureGrowth
+( char *values );
+
+/**
+ * Keeps a fixed ring stepped with a division at a steady depth, pushing one
+ * value and popping one for every operation. Reports the millions of push and
+ * pop pairs done each second.
+ *
+ * @param depth the number of values to keep in the ring
+ * @param values the values to push, at least depth long
+ */
+static
+void
+MeasureModuloRing
+( size_t depth, char *values );
+
+/**
+ * Keeps a Queue at a steady depth, pushing one value and popping one for every
+ * operation, so that the front and back wrap around the ring many times.
+ * Reports the millions of push and pop pairs done each second.
+ *
+ * @param depth the number of values to keep in the Queue
+ * @param values the values to push, at least depth long
+ */
+static
+void
+MeasureSteadyState
+( size_t depth, char *values );
+
+#endif
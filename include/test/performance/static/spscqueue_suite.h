@@ -0,0 +1,91 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_SPSCQUEUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_SPSCQUEUE_SUITE_H
+
+/**
+ * @file
+ * SPSC queue performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/queue.h>
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+/** an SQueue guarded by a mutex, as work was passed before the SPSC queue */
+struct locked_queue_t {
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  pthread_mutex_t lock; /**< held around every push and pop */
+#endif
+  SQueue *queue; /**< the queue holding the values */
+};
+
+/**
+ * Gets the wall time that has passed since a point, which unlike clock()
+ * does not add together the time spent on each thread.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+/**
+ * Passes TRANSFER_VALUES values from a producer thread to the calling thread
+ * through an SQueue guarded by a mutex, and reports the millions of values
+ * passed each second.
+ *
+ * @param values the values to pass, TRANSFER_VALUES long
+ */
+static
+void
+MeasureLockedQueue
+( char *values );
+
+/**
+ * Passes TRANSFER_VALUES values from a producer thread to the calling thread
+ * through an SPSC queue, and reports the millions of values passed each
+ * second.
+ *
+ * @param capacity the capacity of the SPSC queue
+ * @param values the values to pass, TRANSFER_VALUES long
+ */
+static
+void
+MeasureSPSCQueue
+( size_t capacity, char *values );
+
+/**
+ * Pushes every value to a locked queue in order, yielding whenever it is
+ * full.
+ *
+ * @param queue the struct locked_queue_t to push to
+ *
+ * @return NULL
+ */
+static
+void *
+ProduceLocked
+( void *queue );
+
+/**
+ * Pushes every value to an SPSC queue in order, yielding whenever it is full.
+ *
+ * @param queue the SPSC queue to push to
+ *
+ * @return NULL
+ */
+static
+void *
+ProduceSPSC
+( void *queue );
+#endif
+
+#endif
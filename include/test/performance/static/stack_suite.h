@@ -0,0 +1,37 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_STACK_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_STACK_SUITE_H
+
+/**
+ * @file
+ * Stack performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * Gets the wall time that has passed since a point.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+/**
+ * Pushes a batch of values onto a Stack and pops them back off, over and over,
+ * first one value at a time and then with SStackPushN and SStackPopN. Reports
+ * the millions of values pushed and popped each second both ways.
+ *
+ * @param batch the number of values in each batch, at most MAX_BATCH
+ * @param values the values to push, at least batch long
+ */
+static
+void
+MeasureBatches
+( size_t batch, char *values );
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_TINYLFU_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_TINYLFU_SUITE_H
+
+/**
+ * @file
+ * TinyLFU cache performance tests
+ */
+
+#include <stddef.h>
+
+/**
+ * Fills a trace with keys drawn from a Zipf distribution, with the most
+ * popular keys first in the pool. If scan_every is not 0, a run of keys that
+ * are never used again is inserted after every scan_every keys.
+ *
+ * @param trace receives the keys, TRACE_LENGTH of them
+ * @param keys a pool of distinct keys, KEY_POOL long
+ * @param skew the exponent of the distribution
+ * @param scan_every the number of keys between scans, or 0 for no scans
+ */
+static
+void
+BuildTrace
+( char **trace, char *keys, double skew, size_t scan_every );
+
+/**
+ * Runs a trace through an SCache, putting each key that misses, and reports
+ * the hit rate and the time taken.
+ *
+ * @param name the name of the trace
+ * @param trace the keys to look up, TRACE_LENGTH of them
+ */
+static
+void
+MeasureSCache
+( const char *name, char **trace );
+
+/**
+ * Runs a trace through a TinyLFU cache, putting each key that misses, and
+ * reports the hit rate and the time taken.
+ *
+ * @param name the name of the trace
+ * @param trace the keys to look up, TRACE_LENGTH of them
+ */
+static
+void
+MeasureSTinyLFU
+( const char *name, char **trace );
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_TTL_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_TTL_SUITE_H
+
+/**
+ * @file
+ * TTL map performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * Gets the wall time that has passed since a point.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+/**
+ * Fills a TTL map with keys of random lifetimes and advances it one tick per
+ * call until every key has expired, with one stall where the clock jumps
+ * STALL_TICKS at once. Reports the total and the worst time of a single call.
+ *
+ * @param budget the work budget given to each call of STTLAdvance
+ * @param keys a pool of distinct keys, TTL_ENTRIES long
+ */
+static
+void
+MeasureSTTL
+( size_t budget, char *keys );
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef __WOODPILE_TEST_PERFORMANCE_STATIC_WSDEQUE_SUITE_H
+#define __WOODPILE_TEST_PERFORMANCE_STATIC_WSDEQUE_SUITE_H
+
+/**
+ * @file
+ * Work-stealing deque performance tests
+ */
+
+#include <stddef.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+
+/** the most workers measured at once */
+#define MAX_WORKERS 8
+
+/** a worker of the fork/join test, owning one deque */
+struct worker_t {
+  swsdeque_t *deque; /**< the deque the worker owns */
+  unsigned index; /**< the position of the worker among all of them */
+  unsigned long seed; /**< the state of the random choice of victim */
+  size_t steals; /**< the number of tasks the worker stole */
+  unsigned long long sum; /**< the total of the leaves the worker computed */
+  char after_sum[64]; /**< keeps the counts of the workers off each other's lines */
+};
+
+/**
+ * Gets the wall time that has passed since a point, which unlike clock()
+ * does not add together the time spent on each thread.
+ *
+ * @param begin the point to measure from, taken from CLOCK_MONOTONIC
+ *
+ * @return the milliseconds since begin
+ */
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin );
+
+/**
+ * Computes a Fibonacci number by naive recursion, as each leaf task does.
+ *
+ * @param n the position of the number
+ *
+ * @return the nth Fibonacci number
+ */
+static
+unsigned long long
+Fibonacci
+( unsigned n );
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+/**
+ * Pushes a task to the deque of a worker, for it to run later or for another
+ * worker to steal. The task must already be counted as pending.
+ *
+ * @param worker the worker forking the task
+ * @param n the position of the Fibonacci number the task computes
+ */
+static
+void
+Fork
+( struct worker_t *worker, unsigned n );
+
+/**
+ * Computes FIBONACCI_N with a number of workers, each forking the tasks it
+ * takes into two until they reach CUTOFF, and stealing from a random other
+ * worker when its own deque is empty. Reports the time taken, the speedup over
+ * the plain recursion, and how many tasks were stolen.
+ *
+ * @param workers the number of worker threads, at most MAX_WORKERS
+ * @param expected the result of the plain recursion, to check against
+ * @param sequential_time the milliseconds the plain recursion took
+ */
+static
+void
+MeasureForkJoin
+( unsigned workers, unsigned long long expected, double sequential_time );
+
+/**
+ * Runs tasks until every task of the computation is done: those on the deque
+ * of the worker first, newest first, then those stolen from other workers.
+ *
+ * @param worker the struct worker_t of the worker
+ *
+ * @return NULL
+ */
+static
+void *
+Work
+( void *worker );
+#endif
+
+#endif
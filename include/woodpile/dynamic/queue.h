@@ -0,0 +1,118 @@
+#ifndef __WOODPILE_DYNAMIC_QUEUE_H
+#define __WOODPILE_DYNAMIC_QUEUE_H
+
+/**
+ * @file
+ * DQueue declaration and functions
+ */
+
+/**
+ * @struct dqueue_t
+ * The DQueue data structure is a First In First Out (FIFO) structure that
+ * needs no capacity to be chosen ahead of time.
+ *
+ * Elements are kept in a linked list of blocks of DQUEUE_BLOCK_SIZE slots.
+ * Pushes fill the last block and pops drain the first, so a new block is only
+ * needed once every DQUEUE_BLOCK_SIZE pushes, and growing the queue never
+ * moves the elements already in it. A block drained by pops is kept in a small
+ * cache of spare blocks to be used by the next push that needs one, so a queue
+ * whose size stays about the same does not allocate at all. Blocks beyond
+ * those the cache holds are freed, so the memory used shrinks as the queue
+ * drains.
+ *
+ * If the most the queue will hold is known ahead of time and is not too large
+ * then the StaticQueue structure is more suitable, as its elements are in a
+ * single block of memory. NULL elements are not supported.
+ *
+ * Memory overhead can be calculated as follows:
+ * sizeof( void * ) * ( DQUEUE_BLOCK_SIZE + 1 ) for each block in use or
+ * cached, plus sizeof( void * ) * 7
+ */
+struct dqueue_t;
+typedef struct dqueue_t dqueue_t;
+
+/** the number of element slots in each block of a DQueue */
+#define DQUEUE_BLOCK_SIZE 512
+
+/** the most drained blocks a DQueue keeps for later pushes */
+#define DQUEUE_SPARE_BLOCKS 2
+
+/**
+ * Destroys a DQueue, along with any spare blocks it has cached. Does not
+ * affect the elements stored within.
+ *
+ * @param queue the DQueue to destroy
+ */
+void
+DQueueDestroy
+( const dqueue_t *queue );
+
+/**
+ * Checks a DQueue to see if it's empty.
+ *
+ * @param queue the DQueue to check
+ *
+ * @return a positive value if the DQueue is NULL or empty, 0 otherwise
+ */
+unsigned short
+DQueueIsEmpty
+( const dqueue_t *queue );
+
+/**
+ * Creates a new empty DQueue. No blocks are allocated until the first push.
+ *
+ * @return a new DQueue or NULL on failure
+ */
+dqueue_t *
+DQueueNew
+( void );
+
+/**
+ * Gets the front element of a DQueue, but does not remove it.
+ *
+ * @param queue the DQueue to get the front element of
+ *
+ * @return the front element, or NULL if queue is NULL or empty
+ */
+void *
+DQueuePeek
+( const dqueue_t *queue );
+
+/**
+ * Removes the front element of a DQueue. If this drains the first block then
+ * the block is cached for later pushes, or freed if the cache is full.
+ *
+ * @param queue the DQueue to pop from. Must not be NULL.
+ *
+ * @return the front element, or NULL if queue is empty
+ */
+void *
+DQueuePop
+( dqueue_t *queue );
+
+/**
+ * Adds an element to the back of a DQueue. A new block is taken from the
+ * cache, or allocated if there is none, when the last block is full.
+ *
+ * @param queue the DQueue to push to. Must not be NULL.
+ * @param element the element to push. Must not be NULL.
+ *
+ * @return queue, or NULL if a block was needed and memory was not available,
+ * in which case the DQueue is unchanged
+ */
+dqueue_t *
+DQueuePush
+( dqueue_t *queue, void *element );
+
+/**
+ * Gets the number of elements in a DQueue.
+ *
+ * @param queue the DQueue to get the size of
+ *
+ * @return the number of elements in queue, or 0 if queue is NULL
+ */
+size_t
+DQueueSize
+( const dqueue_t *queue );
+
+#endif
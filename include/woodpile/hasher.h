@@ -12,6 +12,8 @@
 #ifdef __WOODPILE_ALL_HASHERS
 # undef __WOODPILE_CITY_HASHER
 # define __WOODPILE_CITY_HASHER 1
+# undef __WOODPILE_CRC_HASHER
+# define __WOODPILE_CRC_HASHER 1
 # undef __WOODPILE_SPOOKY_HASHER
 # define __WOODPILE_SPOOKY_HASHER 1
 # undef __WOODPILE_WOODPILE_HASHER
@@ -20,6 +22,18 @@
 
 typedef unsigned long long ( *folder_t )( unsigned long long, unsigned long long );
 typedef unsigned long long ( *hasher_t )( const void *, unsigned long long );
+typedef unsigned long long *( *batch_hasher_t )( const void * const *, size_t, unsigned long long, unsigned long long * );
+
+/**
+ * A 128-bit hash value, for uses such as fingerprinting where 64 bits do not
+ * make collisions unlikely enough.
+ */
+typedef struct hash128_t {
+  unsigned long long high; /**< the upper 64 bits of the hash */
+  unsigned long long low; /**< the lower 64 bits of the hash */
+} hash128_t;
+
+typedef hash128_t ( *hasher128_t )( const void *, unsigned long long );
 
 #ifdef __WOODPILE_CITY_HASHER
 /**
@@ -50,8 +64,205 @@ CityDataHash
 unsigned long long
 CityHash
 ( const void *str, unsigned long long seed );
+
+/**
+ * Hashes a batch of blocks of data with the City hasher. Each hash is the same
+ * as the one CityDataHash would return for the block.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+CityDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Hashes a batch of NULL-terminated strings with the City hasher. Each hash is
+ * the same as the one CityHash would return for the string.
+ *
+ * @param strs the strings to hash
+ * @param count the number of strings
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each string. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+CityHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes );
+#endif
+
+#ifdef __WOODPILE_CRC_HASHER
+/**
+ * The state of a CRC hash computed a piece at a time. The fields should not be
+ * modified directly, only through the CRCHash streaming functions.
+ */
+typedef struct crc_state_t {
+  unsigned crc; /**< the checksum of the data so far */
+} crc_state_t;
+
+/**
+ * A hash based on the CRC32C (Castagnoli) checksum. The implementation used is
+ * chosen the first time the function is called based on the features of the
+ * processor: the SSE4.2 crc32 instruction on x86, the ARMv8 CRC32 extension on
+ * ARM, and a table-driven software version on everything else. All three
+ * produce identical results.
+ *
+ * The seed is folded into the initial value of the checksum. Only the lower 32
+ * bits of the result are significant.
+ *
+ * @param data the data to hash
+ * @param length the length of the data block to hash
+ * @param seed a seed for the hash
+ *
+ * @return a noncryptographic hash of the data
+ */
+unsigned long long
+CRCDataHash
+( const void *data, size_t length, unsigned long long seed );
+
+/**
+ * A hash based on the CRC32C (Castagnoli) checksum. See CRCDataHash for the
+ * details of the implementation.
+ *
+ * @param str a NULL-terminated string
+ * @param seed a seed for the hash
+ *
+ * @return a noncryptographic hash of the string
+ */
+unsigned long long
+CRCHash
+( const void *str, unsigned long long seed );
+
+/**
+ * Hashes a batch of blocks of data with the CRC hasher. Each hash is the same
+ * as the one CRCDataHash would return for the block. On processors supporting
+ * SSE4.2, four blocks are hashed at a time with their checksums interleaved.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+CRCDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Finishes a CRC hash computed a piece at a time. The result is the same as
+ * CRCDataHash would return for all of the data passed to CRCHashUpdate, in
+ * order, as one block.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ *
+ * @return a noncryptographic hash of the data
+ */
+unsigned long long
+CRCHashFinal
+( const crc_state_t *state );
+
+/**
+ * Starts a CRC hash to be computed a piece at a time.
+ *
+ * @param state the state to initialize. Must not be NULL.
+ * @param seed a seed for the hash
+ *
+ * @return state
+ */
+crc_state_t *
+CRCHashInit
+( crc_state_t *state, unsigned long long seed );
+
+/**
+ * Adds the next piece of data to a CRC hash computed a piece at a time.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ * @param data the next piece of data
+ * @param length the length of the piece
+ *
+ * @return state
+ */
+crc_state_t *
+CRCHashUpdate
+( crc_state_t *state, const void *data, size_t length );
+
+/**
+ * Hashes a batch of NULL-terminated strings with the CRC hasher. Each hash is
+ * the same as the one CRCHash would return for the string. On processors
+ * supporting SSE4.2, four strings are hashed at a time with their checksums
+ * interleaved.
+ *
+ * @param strs the strings to hash
+ * @param count the number of strings
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each string. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+CRCHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes );
 #endif
 
+/**
+ * Scrambles an integer so that every bit of the result depends on every bit of
+ * the value and the seed. This is the 64-bit finalizer of MurmurHash3
+ * (fmix64) applied to the value combined with the seed. For a given seed, no
+ * two values give the same result.
+ *
+ * @param value the integer to scramble
+ * @param seed a seed for the hash
+ *
+ * @return a noncryptographic hash of the value
+ */
+unsigned long long
+MixInteger
+( unsigned long long value, unsigned long long seed );
+
+/**
+ * Creates a hash from a pointer by scrambling its address with MixInteger.
+ * Unlike PointerHash, the low bits of the result are as random as the high
+ * bits, even though allocated pointers all share the same few low bits due to
+ * alignment. This makes it safe to use with any folding function and any
+ * capacity. It works equally well for integer keys stored in pointers.
+ *
+ * @param pointer the pointer to hash
+ * @param seed a seed for the hash
+ *
+ * @return a noncryptographic hash of a pointer
+ */
+unsigned long long
+MixedPointerHash
+( const void *pointer, unsigned long long seed );
+
+/**
+ * Hashes a batch of pointers. Each hash is the same as the one
+ * MixedPointerHash would return for the pointer.
+ *
+ * @param pointers the pointers to hash
+ * @param count the number of pointers
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each pointer. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+MixedPointerHashBatch
+( const void * const *pointers, size_t count, unsigned long long seed, unsigned long long *hashes );
+
 /**
  * Folds a hash into a smaller value using modular arithmetic. This is a very
  * simply folding operation that is essentially truncation. This means that
@@ -69,7 +280,9 @@ ModFold
 
 /**
  * Creates a hash from a pointer. This is done by simply converting the pointer
- * to an integer.
+ * to an integer. Because allocated pointers are aligned, the low bits of the
+ * result are almost always the same, which makes for heavy clustering when the
+ * hash is folded by truncation. MixedPointerHash does not have this problem.
  *
  * @param pointer the pointer to hash
  * @param seed a seed for the hash
@@ -80,7 +293,33 @@ unsigned long long
 PointerHash
 ( const void *pointer, unsigned long long seed );
 
+/**
+ * Hashes a batch of pointers. Each hash is the same as the one PointerHash
+ * would return for the pointer.
+ *
+ * @param pointers the pointers to hash
+ * @param count the number of pointers
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each pointer. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+PointerHashBatch
+( const void * const *pointers, size_t count, unsigned long long seed, unsigned long long *hashes );
+
 #ifdef __WOODPILE_SPOOKY_HASHER
+/**
+ * The state of a Spooky hash computed a piece at a time. The fields should not
+ * be modified directly, only through the SpookyHash streaming functions.
+ */
+typedef struct spooky_state_t {
+  unsigned long long buffer[12]; /**< data waiting for a full chunk */
+  size_t buffered; /**< the number of bytes in the buffer */
+  unsigned long long state[12]; /**< the mixed state of the hash */
+} spooky_state_t;
+
 /**
  * An adaptation of Bob Jenkin's SpookyHashV2. This adaptation was made with 
  * simplicity and brevity in mind. The original code can be found
@@ -113,10 +352,128 @@ SpookyDataHash
 unsigned long long
 SpookyHash
 ( const void *str, unsigned long long seed );
+
+/**
+ * Hashes a batch of blocks of data with the Spooky hasher. Each hash is the
+ * same as the one SpookyDataHash would return for the block. On processors
+ * supporting AVX2, four blocks are mixed at a time in the lanes of the vector
+ * registers.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+SpookyDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * A 128-bit version of SpookyDataHash. After the data is mixed into the state,
+ * a final chunk holding the length of the data is mixed in, so that blocks
+ * which differ only by trailing zero bytes get different hashes. The two
+ * halves of the hash are then folded from the even and odd words of the
+ * state. Like SpookyDataHash, this skips the short-message path and the final
+ * rounds of SpookyHashV2, so its output does not match the 128-bit hash of
+ * the reference implementation.
+ *
+ * @param data the data to hash
+ * @param length the length of the data block to hash
+ * @param seed a seed for the hash
+ *
+ * @return a 128-bit noncryptographic hash of the data
+ */
+hash128_t
+SpookyDataHash128
+( const void *data, size_t length, unsigned long long seed );
+
+/**
+ * Finishes a Spooky hash computed a piece at a time. The result is the same as
+ * SpookyDataHash would return for all of the data passed to SpookyHashUpdate,
+ * in order, as one block.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ *
+ * @return a noncryptographic hash of the data
+ */
+unsigned long long
+SpookyHashFinal
+( const spooky_state_t *state );
+
+/**
+ * Starts a Spooky hash to be computed a piece at a time.
+ *
+ * @param state the state to initialize. Must not be NULL.
+ * @param seed a seed for the hash
+ *
+ * @return state
+ */
+spooky_state_t *
+SpookyHashInit
+( spooky_state_t *state, unsigned long long seed );
+
+/**
+ * Adds the next piece of data to a Spooky hash computed a piece at a time.
+ * Whole chunks of the piece are mixed straight from the data; only the bytes
+ * that do not fill a chunk are copied into the state to wait for the next
+ * piece.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ * @param data the next piece of data
+ * @param length the length of the piece
+ *
+ * @return state
+ */
+spooky_state_t *
+SpookyHashUpdate
+( spooky_state_t *state, const void *data, size_t length );
+
+/**
+ * Hashes a batch of NULL-terminated strings with the Spooky hasher. Each hash
+ * is the same as the one SpookyHash would return for the string. On processors
+ * supporting AVX2, four strings are mixed at a time in the lanes of the vector
+ * registers.
+ *
+ * @param strs the strings to hash
+ * @param count the number of strings
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each string. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+SpookyHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * A 128-bit version of SpookyHash. See SpookyDataHash128 for the details.
+ *
+ * @param str a NULL-terminated string
+ * @param seed a seed for the hash
+ *
+ * @return a 128-bit noncryptographic hash of the string
+ */
+hash128_t
+SpookyHash128
+( const void *str, unsigned long long seed );
 #endif
 
 
 #ifdef __WOODPILE_WOODPILE_HASHER
+/**
+ * The state of a Woodpile hash computed a piece at a time. The fields should
+ * not be modified directly, only through the WoodpileHash streaming functions.
+ */
+typedef struct woodpile_state_t {
+  unsigned long long seed; /**< the seed of the hash */
+  unsigned long long sum; /**< the sum of the data so far */
+} woodpile_state_t;
+
 /**
  * A simple data hashing function with a seed included.
  *
@@ -141,6 +498,108 @@ WoodpileDataHash
 unsigned long long
 WoodpileHash
 ( const void *str, unsigned long long seed );
+
+/**
+ * Hashes a batch of blocks of data with the Woodpile hasher. Each hash is the
+ * same as the one WoodpileDataHash would return for the block.
+ *
+ * @param data the blocks of data to hash
+ * @param lengths the length of each block
+ * @param count the number of blocks
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each block. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+WoodpileDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * A 128-bit hash of a block of data, suitable for fingerprinting and
+ * deduplication. Unlike WoodpileDataHash, which sums the bytes, the data is
+ * mixed 16 bytes at a time with the multiply and rotate rounds of the x64
+ * 128-bit MurmurHash3, the length is folded in, and each half is finished
+ * with the fmix64 finalizer, so that every bit of both halves depends on
+ * every byte of the data and the seed. On a little-endian processor and with
+ * a seed below 2^32, the result is that of MurmurHash3_x64_128.
+ *
+ * @param data the data to hash
+ * @param length the length of the data block to hash
+ * @param seed a seed for the hash
+ *
+ * @return a 128-bit noncryptographic hash of the data
+ */
+hash128_t
+WoodpileDataHash128
+( const void *data, size_t length, unsigned long long seed );
+
+/**
+ * Finishes a Woodpile hash computed a piece at a time. The result is the same
+ * as WoodpileDataHash would return for all of the data passed to
+ * WoodpileHashUpdate, in order, as one block.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ *
+ * @return a noncryptographic hash of the data
+ */
+unsigned long long
+WoodpileHashFinal
+( const woodpile_state_t *state );
+
+/**
+ * Starts a Woodpile hash to be computed a piece at a time.
+ *
+ * @param state the state to initialize. Must not be NULL.
+ * @param seed a seed for the hash
+ *
+ * @return state
+ */
+woodpile_state_t *
+WoodpileHashInit
+( woodpile_state_t *state, unsigned long long seed );
+
+/**
+ * Adds the next piece of data to a Woodpile hash computed a piece at a time.
+ *
+ * @param state the state of the hash. Must not be NULL.
+ * @param data the next piece of data
+ * @param length the length of the piece
+ *
+ * @return state
+ */
+woodpile_state_t *
+WoodpileHashUpdate
+( woodpile_state_t *state, const void *data, size_t length );
+
+/**
+ * Hashes a batch of NULL-terminated strings with the Woodpile hasher. Each hash
+ * is the same as the one WoodpileHash would return for the string.
+ *
+ * @param strs the strings to hash
+ * @param count the number of strings
+ * @param seed a seed for the hashes
+ * @param hashes receives the hash of each string. Must have room for count
+ * hashes.
+ *
+ * @return hashes
+ */
+unsigned long long *
+WoodpileHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * A 128-bit version of WoodpileHash. See WoodpileDataHash128 for the details.
+ *
+ * @param str a NULL-terminated string
+ * @param seed a seed for the hash
+ *
+ * @return a 128-bit noncryptographic hash of the string
+ */
+hash128_t
+WoodpileHash128
+( const void *str, unsigned long long seed );
 #endif
 
 /**
@@ -0,0 +1,160 @@
+#ifndef __WOODPILE_STATIC_BLOCKINGQUEUE_H
+#define __WOODPILE_STATIC_BLOCKINGQUEUE_H
+
+/**
+ * @file
+ * Blocking queue declaration and functions
+ */
+
+#include <stddef.h>
+
+/** the timeout to give to wait for as long as it takes */
+#define SBLOCKINGQUEUE_FOREVER ( -1L )
+
+/**
+ * @struct BlockingQueue
+ * The StaticBlockingQueue data structure is a First In First Out (FIFO) queue
+ * of a fixed capacity, shared between threads under a lock. A push to a full
+ * queue waits for room, and a pop from an empty queue waits for an element,
+ * either for as long as it takes or until a timeout passes. This keeps fast
+ * producers from running away from slow consumers.
+ *
+ * Consumers can drain many elements at once with SBlockingQueuePopBatch, which
+ * takes the lock once and wakes waiting producers once for the whole batch, so
+ * that the cost of the lock is shared between the elements. Threads are only
+ * woken when some are waiting.
+ *
+ * A queue can be closed to end a pipeline: pushes then fail, and pops take
+ * what is left and then fail, without waiting.
+ *
+ * The elements are kept in an SQueue. Where pthread.h is not available the
+ * queue may only be used by a single thread, and never waits.
+ *
+ * NULL elements are not supported, as NULL is returned when a pop fails.
+ *
+ * Memory overhead can be calculated as follows:
+ * an SQueue of capacity rounded up to a power of two, plus a mutex and two
+ * condition variables
+ */
+struct sblockingqueue_t;
+typedef struct sblockingqueue_t sblockingqueue_t;
+
+/**
+ * Gets the number of elements a blocking queue can hold.
+ *
+ * @param queue The blocking queue to get the capacity of.
+ *
+ * @return the capacity of the queue, or 0 if queue is NULL
+ */
+size_t
+SBlockingQueueCapacity
+( const sblockingqueue_t *queue );
+
+/**
+ * Closes a blocking queue, waking every waiting thread. Pushes fail from then
+ * on, and pops return the elements still in the queue and then fail without
+ * waiting.
+ *
+ * @param queue The blocking queue to close. Must not be NULL.
+ *
+ * @return queue
+ */
+sblockingqueue_t *
+SBlockingQueueClose
+( sblockingqueue_t *queue );
+
+/**
+ * Destroys a blocking queue. Does not affect the elements stored in the queue.
+ * No thread may be using or waiting on the queue.
+ *
+ * @param queue The blocking queue to destroy.
+ */
+void
+SBlockingQueueDestroy
+( sblockingqueue_t *queue );
+
+/**
+ * Checks a blocking queue to see if it's empty. While other threads are using
+ * the queue the answer may have changed by the time it is returned.
+ *
+ * @param queue The blocking queue to check.
+ *
+ * @return a positive value if the queue is NULL or empty, 0 otherwise
+ */
+unsigned short
+SBlockingQueueIsEmpty
+( sblockingqueue_t *queue );
+
+/**
+ * Creates an empty, open blocking queue.
+ *
+ * @param capacity The most elements the queue may hold. Must be greater than
+ * 0.
+ *
+ * @return a new blocking queue, or NULL on failure
+ */
+sblockingqueue_t *
+SBlockingQueueNew
+( size_t capacity );
+
+/**
+ * Removes the front element of a blocking queue and returns it, waiting for
+ * one if the queue is empty.
+ *
+ * @param queue The blocking queue to pop from. Must not be NULL.
+ * @param timeout The most milliseconds to wait, 0 to not wait at all, or
+ * SBLOCKINGQUEUE_FOREVER to wait for as long as it takes.
+ *
+ * @return the front element, or NULL if the timeout passed or the queue was
+ * closed and empty
+ */
+void *
+SBlockingQueuePop
+( sblockingqueue_t *queue, long timeout );
+
+/**
+ * Removes up to a number of elements from the front of a blocking queue at
+ * once, waiting for the first if the queue is empty. The lock is taken once,
+ * and waiting producers are woken once, for the whole batch.
+ *
+ * @param queue The blocking queue to pop from.
+ * @param out The array to put the elements in, in the order they were pushed.
+ * @param max The most elements to pop, which out must have room for.
+ * @param timeout The most milliseconds to wait for the first element, 0 to not
+ * wait at all, or SBLOCKINGQUEUE_FOREVER to wait for as long as it takes.
+ *
+ * @return the number of elements popped, or 0 if queue or out is NULL, max is
+ * 0, the timeout passed, or the queue was closed and empty
+ */
+size_t
+SBlockingQueuePopBatch
+( sblockingqueue_t *queue, void **out, size_t max, long timeout );
+
+/**
+ * Puts an element at the back of a blocking queue, waiting for room if the
+ * queue is full.
+ *
+ * @param queue The blocking queue to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ * @param timeout The most milliseconds to wait, 0 to not wait at all, or
+ * SBLOCKINGQUEUE_FOREVER to wait for as long as it takes.
+ *
+ * @return queue, or NULL if the timeout passed or the queue was closed
+ */
+sblockingqueue_t *
+SBlockingQueuePush
+( sblockingqueue_t *queue, void *element, long timeout );
+
+/**
+ * Gets the number of elements in a blocking queue. While other threads are
+ * using the queue the size may have changed by the time it is returned.
+ *
+ * @param queue The blocking queue to measure.
+ *
+ * @return the number of elements in the queue, or 0 if queue is NULL
+ */
+size_t
+SBlockingQueueSize
+( sblockingqueue_t *queue );
+
+#endif
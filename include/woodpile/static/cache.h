@@ -0,0 +1,194 @@
+#ifndef __WOODPILE_STATIC_CACHE_H
+#define __WOODPILE_STATIC_CACHE_H
+
+/**
+ * @file
+ * Cache declaration and functions
+ */
+
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+
+/**
+ * @struct Cache
+ * The StaticCache data structure is a key-value cache holding at most a fixed
+ * number of entries, evicting the least recently used entry to make room for
+ * a new one. Keys are found with an SHash mapping each key to its entry.
+ *
+ * The entries are kept in a single array allocated up front, and are threaded
+ * in recency order by the indices of their neighbors rather than by separate
+ * list nodes. Getting, putting and evicting are all constant time, and no
+ * memory is allocated after the cache is created. NULL keys and values are not
+ * supported.
+ *
+ * An evictor may be set to be told of each entry that is evicted, so that the
+ * owner of the values can free them.
+ *
+ * Memory overhead can be calculated as follows:
+ * 4 words for each entry of capacity, plus an SHash of twice the capacity
+ */
+
+struct scache_t;
+typedef struct scache_t scache_t;
+
+/**
+ * Gets the number of entries a cache can hold.
+ *
+ * @param cache The cache to get the capacity of.
+ *
+ * @return the capacity of the cache, or 0 if cache is NULL
+ */
+size_t
+SCacheCapacity
+( const scache_t *cache );
+
+/**
+ * Destroys a cache. If an evictor is set, it is called for each entry still
+ * in the cache, from least to most recently used, so that their values can be
+ * freed.
+ *
+ * @param cache The cache to destroy.
+ */
+void
+SCacheDestroy
+( const scache_t *cache );
+
+/**
+ * Gets the value of a key, making the key the most recently used.
+ *
+ * @param cache The cache to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value of the key, or NULL if it is not in the cache
+ */
+void *
+SCacheGet
+( scache_t *cache, const void *key );
+
+/**
+ * Checks a cache to see if it's empty.
+ *
+ * @param cache The cache to check.
+ *
+ * @return a positive value if the cache is NULL or empty, 0 otherwise
+ */
+unsigned short
+SCacheIsEmpty
+( const scache_t *cache );
+
+/**
+ * Creates an empty cache. Keys are compared with ComparePointers and hashed
+ * with MixedPointerHash.
+ *
+ * @param capacity The most entries the cache may hold. Must be greater than 0.
+ *
+ * @return a new cache, or NULL on failure
+ */
+scache_t *
+SCacheNew
+( size_t capacity );
+
+/**
+ * Gets the least recently used key of a cache, which is the next to be
+ * evicted.
+ *
+ * @param cache The cache to check. Must not be NULL.
+ *
+ * @return the least recently used key, or NULL if the cache is empty
+ */
+void *
+SCacheOldest
+( const scache_t *cache );
+
+/**
+ * Gets the value of a key without changing how recently it was used.
+ *
+ * @param cache The cache to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value of the key, or NULL if it is not in the cache
+ */
+void *
+SCachePeek
+( const scache_t *cache, const void *key );
+
+/**
+ * Maps a key to a value in a cache, making the key the most recently used. If
+ * the key is new and the cache is full, the least recently used entry is
+ * evicted first and given to the evictor. A NULL value is equivalent to
+ * calling SCacheRemove with the key.
+ *
+ * @param cache The cache to put into. Must not be NULL.
+ * @param key The key to map. Must not be NULL.
+ * @param value The value to map the key to.
+ *
+ * @return the previous value of the key if it was already present, which is
+ * not given to the evictor, or value if the key was new
+ */
+void *
+SCachePut
+( scache_t *cache, void *key, void *value );
+
+/**
+ * Removes a key from a cache. The evictor is not called.
+ *
+ * @param cache The cache to remove from. Must not be NULL.
+ * @param key The key to remove. Must not be NULL.
+ *
+ * @return the value the key was mapped to, or NULL if it was not present
+ */
+void *
+SCacheRemove
+( scache_t *cache, const void *key );
+
+/**
+ * Sets the function told of each entry evicted from a cache, or destroyed
+ * along with it.
+ *
+ * @param cache The cache to update. Must not be NULL.
+ * @param evict The function given the key and value of each evicted entry,
+ * along with context, or NULL to stop telling of evictions.
+ * @param context The context to pass to evict.
+ *
+ * @return cache
+ */
+scache_t *
+SCacheSetEvictor
+( scache_t *cache, void ( *evict )( void *, void *, void * ), void *context );
+
+/**
+ * Sets the hashing function for the keys of a cache.
+ *
+ * @param cache The cache to update. Must not be NULL.
+ * @param hasher The hashing function to use. Must not be NULL.
+ *
+ * @return cache, or NULL if the keys could not be rehashed
+ */
+scache_t *
+SCacheSetHasher
+( scache_t *cache, hasher_t hasher );
+
+/**
+ * Sets the comparator used to find the keys of a cache.
+ *
+ * @param cache The cache to update. Must not be NULL.
+ * @param comparator The key comparator to use. Must not be NULL.
+ *
+ * @return cache, or NULL if the keys could not be rehashed
+ */
+scache_t *
+SCacheSetKeyComparator
+( scache_t *cache, comparator_t comparator );
+
+/**
+ * Gets the number of entries in a cache.
+ *
+ * @param cache The cache to get the size of.
+ *
+ * @return the number of entries in the cache, or 0 if cache is NULL
+ */
+size_t
+SCacheSize
+( const scache_t *cache );
+
+#endif
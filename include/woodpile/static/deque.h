@@ -0,0 +1,182 @@
+#ifndef __WOODPILE_STATIC_DEQUE_H
+#define __WOODPILE_STATIC_DEQUE_H
+
+/**
+ * @file
+ * Deque declaration and functions
+ */
+
+#include <stddef.h>
+
+/**
+ * @struct Deque
+ * The StaticDeque data structure is a double-ended queue kept in a ring, in
+ * the same way as an SQueue. Elements can be pushed to and popped from either
+ * end in constant time, and any element can be read or replaced by its
+ * position from the front in constant time.
+ *
+ * The capacity of the ring is always a power of two, so that stepping around
+ * it is a mask rather than a division. When a push finds the ring full its
+ * capacity is doubled, and the elements are moved to the start of the new
+ * ring in at most two copies. No memory is allocated for each element, unlike
+ * a list.
+ *
+ * NULL elements are not supported, as NULL is returned by an empty deque.
+ *
+ * Memory overhead can be calculated as follows:
+ * sizeof( size_t ) * 3 + sizeof( void * ) * ( capacity + 1 )
+ */
+struct sdeque_t;
+typedef struct sdeque_t sdeque_t;
+
+/**
+ * Gets the number of elements a deque can hold before it grows.
+ *
+ * @param deque The deque to get the capacity of.
+ *
+ * @return the capacity of the deque, or 0 if deque is NULL
+ */
+size_t
+SDequeCapacity
+( const sdeque_t *deque );
+
+/**
+ * Destroys a deque. Does not affect the elements stored in the deque.
+ *
+ * @param deque The deque to destroy.
+ */
+void
+SDequeDestroy
+( const sdeque_t *deque );
+
+/**
+ * Gets an element of a deque by its position.
+ *
+ * @param deque The deque to read from. Must not be NULL.
+ * @param index The position of the element, where 0 is the front.
+ *
+ * @return the element at index, or NULL if index is not less than the size
+ */
+void *
+SDequeGet
+( const sdeque_t *deque, size_t index );
+
+/**
+ * Checks a deque to see if it's empty.
+ *
+ * @param deque The deque to check.
+ *
+ * @return a positive value if the deque is NULL or empty, 0 otherwise
+ */
+unsigned short
+SDequeIsEmpty
+( const sdeque_t *deque );
+
+/**
+ * Creates an empty deque.
+ *
+ * @param capacity The number of elements the deque can hold before it first
+ * grows, which is rounded up to a power of two.
+ *
+ * @return a new deque, or NULL on failure
+ */
+sdeque_t *
+SDequeNew
+( size_t capacity );
+
+/**
+ * Gets the back element of a deque without removing it.
+ *
+ * @param deque The deque to peek at.
+ *
+ * @return the back element, or NULL if deque is NULL or empty
+ */
+void *
+SDequePeekBack
+( const sdeque_t *deque );
+
+/**
+ * Gets the front element of a deque without removing it.
+ *
+ * @param deque The deque to peek at.
+ *
+ * @return the front element, or NULL if deque is NULL or empty
+ */
+void *
+SDequePeekFront
+( const sdeque_t *deque );
+
+/**
+ * Removes the back element of a deque and returns it.
+ *
+ * @param deque The deque to pop from. Must not be NULL.
+ *
+ * @return the back element, or NULL if the deque is empty
+ */
+void *
+SDequePopBack
+( sdeque_t *deque );
+
+/**
+ * Removes the front element of a deque and returns it.
+ *
+ * @param deque The deque to pop from. Must not be NULL.
+ *
+ * @return the front element, or NULL if the deque is empty
+ */
+void *
+SDequePopFront
+( sdeque_t *deque );
+
+/**
+ * Puts an element at the back of a deque, doubling its capacity if it is
+ * full.
+ *
+ * @param deque The deque to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ *
+ * @return deque, or NULL on failure
+ */
+sdeque_t *
+SDequePushBack
+( sdeque_t *deque, void *element );
+
+/**
+ * Puts an element at the front of a deque, doubling its capacity if it is
+ * full.
+ *
+ * @param deque The deque to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ *
+ * @return deque, or NULL on failure
+ */
+sdeque_t *
+SDequePushFront
+( sdeque_t *deque, void *element );
+
+/**
+ * Replaces an element of a deque by its position.
+ *
+ * @param deque The deque to write to. Must not be NULL.
+ * @param index The position of the element, where 0 is the front. Must be less
+ * than the size of the deque.
+ * @param element The new element. Must not be NULL.
+ *
+ * @return the element that was replaced, or NULL on failure
+ */
+void *
+SDequeSet
+( sdeque_t *deque, size_t index, void *element );
+
+/**
+ * Gets the number of elements in a deque.
+ *
+ * @param deque The deque to measure.
+ *
+ * @return the number of elements in the deque, or 0 if deque is NULL
+ */
+size_t
+SDequeSize
+( const sdeque_t *deque );
+
+#endif
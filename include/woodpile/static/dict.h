@@ -0,0 +1,203 @@
+#ifndef __WOODPILE_STATIC_DICT_H
+#define __WOODPILE_STATIC_DICT_H
+
+/**
+ * @file
+ * Dict declaration and functions
+ */
+
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+
+/**
+ * @struct Dict
+ * The StaticDict data structure is a compact hash map that keeps its elements
+ * in insertion order. Keys, values and key hashes are stored together in a
+ * dense array of entries, in the order the keys were first put. A separate,
+ * sparse index table of 8, 16 or 32-bit slots (the narrowest that can count
+ * the entries) maps hashes to positions in the entry array. NULL keys and
+ * values are not supported.
+ *
+ * Because only the narrow index table is sized for a low load factor, a Dict
+ * uses much less memory than an SHash holding the same elements, and iterating
+ * over it with SDictForEach walks a single contiguous array in a deterministic
+ * order.
+ *
+ * Removed entries are left as holes in the entry array until it fills up. At
+ * that point, if at least a quarter of the entries are holes, they are
+ * compacted in place, keeping their order; otherwise the capacity is doubled.
+ * Either way the index table is rebuilt from the stored hashes without
+ * rehashing any keys.
+ *
+ * Memory overhead can be calculated as follows:
+ * 3 words for each entry of capacity, plus the index table, which has the
+ * smallest power of two slots that is at least one and a half times capacity.
+ * Slots are 1 byte for a capacity under 256, 2 bytes for one under 65536, and 4
+ * bytes otherwise.
+ */
+
+struct sdict_t;
+typedef struct sdict_t sdict_t;
+
+/**
+ * Gets the number of entries a Dict can hold.
+ *
+ * @param dict The Dict to get the capacity of.
+ *
+ * @return the capacity of the Dict, or 0 if dict is NULL
+ */
+size_t
+SDictCapacity
+( const sdict_t *dict );
+
+/**
+ * Destroys a Dict. The keys and values are not affected.
+ *
+ * @param dict The Dict to destroy.
+ */
+void
+SDictDestroy
+( const sdict_t *dict );
+
+/**
+ * Calls a function on each key and value in a Dict, in the order the keys were
+ * put into it.
+ *
+ * @param dict The Dict to walk. Must not be NULL.
+ * @param action The function to call with each key, value and the context.
+ * Must not be NULL.
+ * @param context The context to pass to action.
+ *
+ * @return dict
+ */
+sdict_t *
+SDictForEach
+( sdict_t *dict, void ( *action )( void *, void *, void * ), void *context );
+
+/**
+ * Gets the value mapped to a key.
+ *
+ * @param dict The Dict to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value mapped to the key, or NULL if there is none
+ */
+void *
+SDictGet
+( const sdict_t *dict, const void *key );
+
+/**
+ * Checks a Dict to see if it's empty.
+ *
+ * @param dict The Dict to check.
+ *
+ * @return a positive value if the Dict is NULL or empty, 0 otherwise
+ */
+unsigned short
+SDictIsEmpty
+( const sdict_t *dict );
+
+/**
+ * Creates an empty Dict with a default capacity of 256. Keys are compared with
+ * ComparePointers and hashed with MixedPointerHash.
+ *
+ * @return a new Dict, or NULL on failure
+ */
+sdict_t *
+SDictNew
+( void );
+
+/**
+ * Creates an empty Dict able to hold the given number of entries. Keys are
+ * compared with ComparePointers and hashed with MixedPointerHash.
+ *
+ * @param capacity The number of entries the Dict can hold. Must be greater
+ * than 0 and less than 2^32 - 1.
+ *
+ * @return a new Dict, or NULL on failure
+ */
+sdict_t *
+SDictNewSized
+( size_t capacity );
+
+/**
+ * Maps a key to a value in a Dict. A key that is already present keeps its
+ * place in the insertion order. A NULL value is equivalent to calling
+ * SDictRemove with the key. If the entry array is full, the Dict is compacted
+ * or its capacity doubled as described for the Dict structure.
+ *
+ * @param dict The Dict to put into. Must not be NULL.
+ * @param key The key to map. Must not be NULL.
+ * @param value The value to map the key to.
+ *
+ * @return value if the key was new, the previous value if it was already
+ * present, or NULL if the Dict could not make room for a new key
+ */
+void *
+SDictPut
+( sdict_t *dict, void *key, void *value );
+
+/**
+ * Removes a key from a Dict.
+ *
+ * @param dict The Dict to remove from. Must not be NULL.
+ * @param key The key to remove. Must not be NULL.
+ *
+ * @return the value the key was mapped to, or NULL if it was not present
+ */
+void *
+SDictRemove
+( sdict_t *dict, const void *key );
+
+/**
+ * Changes the number of entries a Dict can hold. The entries are compacted in
+ * their insertion order and the index table is rebuilt.
+ *
+ * @param dict The Dict to resize. Must not be NULL.
+ * @param capacity The new capacity. Must be at least the size of the Dict and
+ * less than 2^32 - 1.
+ *
+ * @return dict, or NULL on failure, in which case the Dict is unchanged
+ */
+sdict_t *
+SDictSetCapacity
+( sdict_t *dict, size_t capacity );
+
+/**
+ * Sets the hashing function for a Dict. The stored hashes of all keys are
+ * recomputed and the index table is rebuilt.
+ *
+ * @param dict The Dict to update. Must not be NULL.
+ * @param hasher The hashing function to use. Must not be NULL.
+ *
+ * @return dict, or NULL on failure, in which case the Dict is unchanged
+ */
+sdict_t *
+SDictSetHasher
+( sdict_t *dict, hasher_t hasher );
+
+/**
+ * Sets the comparator used to find keys in a Dict. This does not change where
+ * keys are placed, so it should be done before anything is put.
+ *
+ * @param dict The Dict to update. Must not be NULL.
+ * @param comparator The key comparator to use. Must not be NULL.
+ *
+ * @return dict
+ */
+sdict_t *
+SDictSetKeyComparator
+( sdict_t *dict, comparator_t comparator );
+
+/**
+ * Gets the number of keys in a Dict.
+ *
+ * @param dict The Dict to get the size of.
+ *
+ * @return the number of keys in the Dict, or 0 if dict is NULL
+ */
+size_t
+SDictSize
+( const sdict_t *dict );
+
+#endif
@@ -21,6 +21,10 @@
  * elements to be re-hashed, in addition to the memory re-allocation. This means
  * that this process should be avoided if at all possible.
  *
+ * The slots are kept in segments of a page each. SHashSnapshot shares the
+ * segments with the snapshot rather than copying them, and a segment is only
+ * copied when one of the hashes sharing it writes to it.
+ *
  * Memory overhead can be calculated as follows:
  * depends on pending implementation
  */
@@ -28,6 +32,29 @@
 struct shash_t;
 typedef struct shash_t shash_t;
 
+/** the layout storing each key right before its value */
+#define SHASH_INTERLEAVED 0
+
+/** the layout storing all keys in one array and all values in another */
+#define SHASH_SPLIT 1
+
+/** the smallest capacity that an SHash is shrunk to by trimming */
+#define SHASH_MIN_CAPACITY 16
+
+/**
+ * A placeholder hasher that puts an SHash into automatic hasher selection when
+ * given to SHashSetHasher. It is never installed as the hasher of an SHash,
+ * and if called directly behaves the same as MixedPointerHash.
+ *
+ * @param key the key to hash
+ * @param seed the seed for the hash
+ *
+ * @return the MixedPointerHash of the key
+ */
+unsigned long long
+SHashAutoHash
+( const void *key, unsigned long long seed );
+
 /**
  * Gets the current capacity of the SHash.
  *
@@ -72,6 +99,23 @@ shash_t *
 SHashCopy
 ( const shash_t *hash );
 
+/**
+ * Gets the number of times an SHash has rehashed itself because an insertion
+ * probed too far. SHashPut triggers this when a new key probes more than
+ * four times log2( capacity ) + 1 slots while the hash is under three
+ * quarters full, picking a new seed and upgrading a hasher that ignores its
+ * seed (PointerHash to MixedPointerHash, and CityHash or WoodpileHash to a
+ * compiled-in SpookyHash or CRCHash). To keep the rehashes amortized, a hash
+ * only defends itself again once its size has doubled since the last time.
+ *
+ * @param hash The SHash to get the count of.
+ *
+ * @return the number of probe-triggered rehashes, or 0 if hash is NULL
+ */
+size_t
+SHashDefenseCount
+( const shash_t *hash );
+
 /**
  * Destroys a SHash. Does not affect the elements stored in the hash.
  *
@@ -128,6 +172,22 @@ hasher_t
 SHashGetHasher
 ( const shash_t *hash );
 
+/**
+ * Gets the value mapped to a key, putting the provided value in for the key if
+ * there is none. The key is hashed and probed for only once, making this
+ * cheaper than an SHashGet followed by an SHashPut.
+ *
+ * @param hash The SHash to look in. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ * @param value The value to put if the key is missing. Must not be NULL.
+ *
+ * @return the value already mapped to the key, or value if it was put. NULL is
+ * returned if the key was missing and the hash is full.
+ */
+void *
+SHashGetOrPut
+( shash_t *hash, void *key, void *value );
+
 /**
  * Checks a SHash to see if it's empty.
  *
@@ -151,11 +211,33 @@ SHashKeyComparator
 ( const shash_t *hash );
 
 /**
- * Creates a new SHash. The default capacity of the hash is 256. If the hashing
- * function is NULL, then a default function is used based on element's pointer
- * values. If the folding function is NULL, then a simple XOR-based function is
- * used. If the comparator is NULL, then the pointers for keys are directly
- * compared.
+ * Gets the way the slots of an SHash are laid out in memory.
+ *
+ * @param hash The SHash to get the layout of.
+ *
+ * @return SHASH_SPLIT if the keys and values are in separate arrays, or
+ * SHASH_INTERLEAVED if they alternate, which is also returned for NULL
+ */
+unsigned short
+SHashLayout
+( const shash_t *hash );
+
+/**
+ * Gets the low-water mark of an SHash, as set by SHashSetLowWater.
+ *
+ * @param hash The SHash to get the mark of.
+ *
+ * @return the load percentage below which a remove halves the capacity, or 0
+ * if removes never change the capacity or hash is NULL
+ */
+unsigned short
+SHashLowWater
+( const shash_t *hash );
+
+/**
+ * Creates a new SHash. The default capacity of the hash is 256. Keys are
+ * hashed by their pointer values with MixedPointerHash, folded with a simple
+ * XOR-based function, and compared directly by their pointer values.
  *
  * @return a new SHash or NULL on failure
  */
@@ -174,10 +256,34 @@ SHashNewDictionary
 ( void );
 
 /**
- * Creates a new SHash of the given capacity. If the hashing function is NULL,
- * then a default function is used based on element's pointer values. If the
- * folding function is NULL, then a simple XOR-based function is used. If the
- * comparator is NULL, then the pointers for keys are directly compared.
+ * Creates a new SHash holding a set of key-value pairs, with twice as many
+ * buckets as pairs. Keys are hashed and compared as in SHashNewSized, but are
+ * folded with ModFold, which spreads them across a large capacity far better.
+ * The pairs are split between worker threads where threads are available:
+ * each finds the buckets of a share of the pairs, and then fills its own range
+ * of buckets, so that no two threads write the same bucket. This can take far
+ * less time than putting each pair in turn for large sets.
+ *
+ * Pairs with a NULL key or value are skipped. If a key is given more than
+ * once, the last of its values is kept.
+ *
+ * @param keys the keys to put. Must not be NULL.
+ * @param values the values to put, where values[i] is mapped to keys[i]. Must
+ * not be NULL.
+ * @param count the number of pairs
+ * @param threads the number of threads to build with, where 0 or 1 builds on
+ * the calling thread alone
+ *
+ * @return a new SHash holding the pairs, or NULL on failure
+ */
+shash_t *
+SHashNewFromPairs
+( void **keys, void **values, size_t count, unsigned threads );
+
+/**
+ * Creates a new SHash of the given capacity. Keys are hashed by their pointer
+ * values with MixedPointerHash, folded with a simple XOR-based function, and
+ * compared directly by their pointer values.
  *
  * @param capacity the capacity to give the SHash
  *
@@ -222,14 +328,34 @@ SHashRemove
  * Changes a SHash's capacity, specifically the number of buckets.
  *
  * @param hash the SHash to resize. Must not be NULL.
- * @param capacity the new capacity of the SHash
+ * @param capacity the new capacity of the SHash. Must be at least the size of
+ * the SHash.
  *
- * @return the SHash having been resized
+ * @return the SHash having been resized, or NULL on failure, in which case the
+ * SHash is unchanged
  */
 shash_t *
 SHashSetCapacity
 ( shash_t *hash, size_t capacity );
 
+/**
+ * Changes a SHash's capacity, splitting the rehash between worker threads as
+ * SHashNewFromPairs does. The result is the same as SHashSetCapacity, but a
+ * large hash is resized in a fraction of the time. The work is only split well
+ * if the folder of the hash spreads keys across the whole capacity.
+ *
+ * @param hash the SHash to resize. Must not be NULL.
+ * @param capacity the new capacity of the SHash. Must be at least the size.
+ * @param threads the number of threads to rehash with, where 0 or 1 rehashes
+ * on the calling thread alone
+ *
+ * @return the SHash having been resized, or NULL if memory was not available,
+ * in which case the hash is unchanged
+ */
+shash_t *
+SHashSetCapacityParallel
+( shash_t *hash, size_t capacity, unsigned threads );
+
 /**
  * Sets the comparator used to compare elements held in a StaticHash. This
  * comparator is used whenever elements are compared, for things such as calls
@@ -257,6 +383,10 @@ SHashSetFolder
 /**
  * Sets the hashing function for an SHash.
  *
+ * If the hasher is SHashAutoHash then the current hasher is kept until the
+ * hash has seen enough keys to train on, at which point SHashTrainHasher is
+ * called to pick one. No rehash is done when entering this mode.
+ *
  * @param hash The SHash to update. Must not be NULL.
  * @param hasher The hashing function to use. Must not be NULL.
  *
@@ -280,6 +410,26 @@ shash_t *
 SHashSetKeyComparator
 ( shash_t *hash, comparator_t comparator );
 
+/**
+ * Sets the way the slots of an SHash are laid out in memory. New hashes use
+ * SHASH_INTERLEAVED, where each key is stored right before its value, which
+ * brings the value into the cache with the key on a hit. SHASH_SPLIT stores
+ * the keys contiguously and the values in a separate array, so twice as many
+ * keys share each cache line while probing. This favors workloads where most
+ * lookups miss or probe sequences are long, since the values of the keys that
+ * are passed over are never read.
+ *
+ * Elements keep their slots, so changing the layout does not rehash.
+ *
+ * @param hash The SHash to update. Must not be NULL.
+ * @param layout SHASH_INTERLEAVED or SHASH_SPLIT.
+ *
+ * @return hash, or NULL if memory for the new layout was not available
+ */
+shash_t *
+SHashSetLayout
+( shash_t *hash, unsigned short layout );
+
 /**
  * Sets the seed used for the SHash.
  *
@@ -292,6 +442,27 @@ shash_t *
 SHashSetSeed
 ( shash_t *hash, unsigned long long seed );
 
+/**
+ * Sets a low-water mark for an SHash, so that a table grown for a burst gives
+ * its memory back as it empties. Whenever a remove leaves the load below the
+ * mark, the capacity is halved, down to no less than SHASH_MIN_CAPACITY.
+ *
+ * Halving leaves the load at twice the mark, which is why the mark may be at
+ * most 25 percent: the table is never more than half full after shrinking, and
+ * it must lose half of its remaining elements before it shrinks again. This
+ * gap keeps a table whose size hovers around the mark from resizing on every
+ * few puts and removes.
+ *
+ * @param hash The SHash to update. Must not be NULL.
+ * @param percent The load percentage to halve the capacity below, from 0 to
+ * 25. 0 turns shrinking off, which is the default.
+ *
+ * @return hash
+ */
+shash_t *
+SHashSetLowWater
+( shash_t *hash, unsigned short percent );
+
 /**
  * Gets the number of elements in a SHash. An empty hash will return 0.
  *
@@ -303,6 +474,27 @@ size_t
 SHashSize
 ( const shash_t *hash );
 
+/**
+ * Takes a snapshot of a SHash. The snapshot shares the slots of the hash
+ * copy-on-write, with each segment of the slots holding a count of the hashes
+ * using it, so that a snapshot takes constant time and memory no matter the
+ * size of the hash. When either the hash or the snapshot is next changed, only
+ * the segments that are written to are copied, and every other segment stays
+ * shared.
+ *
+ * A snapshot is a SHash of its own, and may be read, changed, copied or
+ * snapshotted, and must be destroyed with SHashDestroy. Where stdatomic.h is
+ * available, a snapshot may be read and destroyed on a different thread than
+ * the one changing the hash it was taken of.
+ *
+ * @param hash the SHash to take a snapshot of. Must not be NULL.
+ *
+ * @return the snapshot, or NULL on failure
+ */
+shash_t *
+SHashSnapshot
+( const shash_t *hash );
+
 /**
  * Creates a string representation of the given SHash, using the provided
  * function to get the string representation of each element.
@@ -318,4 +510,61 @@ char *
 SHashToString
 ( const shash_t *hash, char * ( *element_to_string )( const void * ) );
 
+/**
+ * Picks a hasher for an SHash by sampling the keys it currently holds. Each
+ * compiled-in hasher suited to the key comparator (the string hashers for
+ * CompareStrings, the pointer hashers otherwise) is timed on the sample and
+ * checked for how evenly it spreads the sample over the buckets of the hash.
+ * A hasher that gives every key of the sample the same hash is never picked.
+ * The fastest hasher that uses at least three quarters of the buckets a
+ * uniform hasher would is installed with a single rehash. If none of them pass, the
+ * one that spreads the sample the most is used instead.
+ *
+ * A hash holding fewer than 32 keys is left unchanged, as a sample that small
+ * says too little about a hasher. Otherwise this also ends automatic selection
+ * if it was started with SHashAutoHash.
+ *
+ * @param hash The SHash to train. Must not be NULL.
+ *
+ * @return hash, or NULL if memory for the sample could not be allocated
+ */
+shash_t *
+SHashTrainHasher
+( shash_t *hash );
+
+/**
+ * Shrinks an SHash to fit the elements it holds, giving back the memory it
+ * took on to hold more. The capacity becomes twice the size, so that the
+ * table is left half full, but never less than SHASH_MIN_CAPACITY. A hash that
+ * is already that small or smaller is not changed.
+ *
+ * @param hash The SHash to trim. Must not be NULL.
+ *
+ * @return hash, or NULL if memory for the smaller table was not available, in
+ * which case the hash is unchanged
+ */
+shash_t *
+SHashTrimToSize
+( shash_t *hash );
+
+/**
+ * Gets the value mapped to a key, building and putting one in if there is none.
+ * The key is hashed and probed for only once, and build is only called when the
+ * key is missing and there is room for it, so the value it returns is always
+ * either put into the hash or not built at all.
+ *
+ * @param hash The SHash to look in. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ * @param build The function creating the value for a missing key, given the
+ * key and context. If it returns NULL nothing is put. Must not be NULL.
+ * @param context The context to pass to build.
+ *
+ * @return the value already mapped to the key, or the value built for it. NULL
+ * is returned if the key was missing and either the hash is full or build
+ * returned NULL.
+ */
+void *
+SHashUpsert
+( shash_t *hash, void *key, void * ( *build )( const void *, void * ), void *context );
+
 #endif
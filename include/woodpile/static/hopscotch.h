@@ -0,0 +1,206 @@
+#ifndef __WOODPILE_STATIC_HOPSCOTCH_H
+#define __WOODPILE_STATIC_HOPSCOTCH_H
+
+/**
+ * @file
+ * Hopscotch hash declaration and functions
+ */
+
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+
+/**
+ * @struct Hopscotch
+ * The StaticHopscotch data structure is a hash map using hopscotch hashing,
+ * meant for running at a high load. Every key is kept within a neighborhood of
+ * SHOPSCOTCH_NEIGHBORHOOD slots starting at its home slot, and each home slot
+ * has a bitmap of which slots in its neighborhood hold its keys. A lookup only
+ * checks the slots named in the bitmap, which are nearly always within a cache
+ * line or two of home, and a miss is decided without probing at all, no matter
+ * how full the table is.
+ *
+ * When the nearest empty slot is outside the neighborhood of a new key, keys
+ * closer to it are moved into it, moving the empty slot back towards the home
+ * slot. If no key can be moved, the put fails and the capacity needs to be
+ * increased with SHopscotchSetCapacity. NULL keys and values are not supported.
+ *
+ * Memory overhead can be calculated as follows:
+ * 2 words and 8 bytes for each slot of capacity
+ */
+
+struct shopscotch_t;
+typedef struct shopscotch_t shopscotch_t;
+
+/** the number of slots in the neighborhood of a home slot */
+#define SHOPSCOTCH_NEIGHBORHOOD 64
+
+/**
+ * Gets the number of slots in a Hopscotch hash.
+ *
+ * @param hash The Hopscotch hash to get the capacity of.
+ *
+ * @return the capacity of the hash, or 0 if hash is NULL
+ */
+size_t
+SHopscotchCapacity
+( const shopscotch_t *hash );
+
+/**
+ * Destroys a Hopscotch hash. The keys and values are not affected.
+ *
+ * @param hash The Hopscotch hash to destroy.
+ */
+void
+SHopscotchDestroy
+( const shopscotch_t *hash );
+
+/**
+ * Gets the value mapped to a key.
+ *
+ * @param hash The Hopscotch hash to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value mapped to the key, or NULL if there is none
+ */
+void *
+SHopscotchGet
+( const shopscotch_t *hash, const void *key );
+
+/**
+ * Checks a Hopscotch hash to see if it's empty.
+ *
+ * @param hash The Hopscotch hash to check.
+ *
+ * @return a positive value if the hash is NULL or empty, 0 otherwise
+ */
+unsigned short
+SHopscotchIsEmpty
+( const shopscotch_t *hash );
+
+/**
+ * Creates an empty Hopscotch hash with 256 slots. Keys are compared with
+ * ComparePointers, hashed with MixedPointerHash and folded with ModFold.
+ *
+ * @return a new Hopscotch hash, or NULL on failure
+ */
+shopscotch_t *
+SHopscotchNew
+( void );
+
+/**
+ * Creates an empty Hopscotch hash with the given number of slots. Keys are
+ * compared with ComparePointers, hashed with MixedPointerHash and folded with
+ * ModFold.
+ *
+ * @param capacity The number of slots. Must be greater than 0.
+ *
+ * @return a new Hopscotch hash, or NULL on failure
+ */
+shopscotch_t *
+SHopscotchNewSized
+( size_t capacity );
+
+/**
+ * Maps a key to a value in a Hopscotch hash. A NULL value is equivalent to
+ * calling SHopscotchRemove with the key.
+ *
+ * @param hash The Hopscotch hash to put into. Must not be NULL.
+ * @param key The key to map. Must not be NULL.
+ * @param value The value to map the key to.
+ *
+ * @return value if the key was new, the previous value if it was already
+ * present, or NULL if no slot could be found in the neighborhood of the key
+ */
+void *
+SHopscotchPut
+( shopscotch_t *hash, void *key, void *value );
+
+/**
+ * Removes a key from a Hopscotch hash.
+ *
+ * @param hash The Hopscotch hash to remove from. Must not be NULL.
+ * @param key The key to remove. Must not be NULL.
+ *
+ * @return the value the key was mapped to, or NULL if it was not present
+ */
+void *
+SHopscotchRemove
+( shopscotch_t *hash, const void *key );
+
+/**
+ * Changes the number of slots in a Hopscotch hash, rehashing every key.
+ *
+ * @param hash The Hopscotch hash to resize. Must not be NULL.
+ * @param capacity The new number of slots. Must be greater than 0.
+ *
+ * @return hash, or NULL if memory was not available or the keys could not all
+ * be placed, in which case the hash is unchanged
+ */
+shopscotch_t *
+SHopscotchSetCapacity
+( shopscotch_t *hash, size_t capacity );
+
+/**
+ * Sets the folding function for a Hopscotch hash, rehashing every key.
+ *
+ * @param hash The Hopscotch hash to update. Must not be NULL.
+ * @param folder The folding function to use. Must not be NULL.
+ *
+ * @return hash, or NULL if the keys could not be rehashed, in which case the
+ * hash is unchanged
+ */
+shopscotch_t *
+SHopscotchSetFolder
+( shopscotch_t *hash, folder_t folder );
+
+/**
+ * Sets the hashing function for a Hopscotch hash, rehashing every key.
+ *
+ * @param hash The Hopscotch hash to update. Must not be NULL.
+ * @param hasher The hashing function to use. Must not be NULL.
+ *
+ * @return hash, or NULL if the keys could not be rehashed, in which case the
+ * hash is unchanged
+ */
+shopscotch_t *
+SHopscotchSetHasher
+( shopscotch_t *hash, hasher_t hasher );
+
+/**
+ * Sets the comparator used to find keys in a Hopscotch hash. This does not
+ * change where keys are placed, so it should be done before anything is put.
+ *
+ * @param hash The Hopscotch hash to update. Must not be NULL.
+ * @param comparator The key comparator to use. Must not be NULL.
+ *
+ * @return hash
+ */
+shopscotch_t *
+SHopscotchSetKeyComparator
+( shopscotch_t *hash, comparator_t comparator );
+
+/**
+ * Sets the seed used for hashing keys in a Hopscotch hash, rehashing every key.
+ *
+ * @param hash The Hopscotch hash to update. Must not be NULL.
+ * @param seed The seed to use.
+ *
+ * @return hash, or NULL if the keys could not be rehashed, in which case the
+ * hash is unchanged
+ */
+shopscotch_t *
+SHopscotchSetSeed
+( shopscotch_t *hash, unsigned long long seed );
+
+/**
+ * Gets the number of keys in a Hopscotch hash.
+ *
+ * @param hash The Hopscotch hash to get the size of.
+ *
+ * @return the number of keys in the hash, or 0 if hash is NULL
+ */
+size_t
+SHopscotchSize
+( const shopscotch_t *hash );
+
+#endif
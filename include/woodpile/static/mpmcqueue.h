@@ -0,0 +1,123 @@
+#ifndef __WOODPILE_STATIC_MPMCQUEUE_H
+#define __WOODPILE_STATIC_MPMCQUEUE_H
+
+/**
+ * @file
+ * Multi-producer multi-consumer queue declaration and functions
+ */
+
+#include <stddef.h>
+
+/**
+ * @struct MPMCQueue
+ * The StaticMPMCQueue data structure is a First In First Out (FIFO) ring of a
+ * fixed capacity that any number of threads may push to and pop from at once,
+ * without a lock. It is the bounded queue described by Dmitry Vyukov.
+ *
+ * Each slot of the ring carries a sequence number saying whose turn it is. A
+ * producer claims the back of the ring with a compare-and-swap only when the
+ * sequence of its slot says the slot is free, writes the element, and then
+ * releases the sequence to the consumer of that lap. Consumers do the same at
+ * the front. Producers and consumers therefore only contend with their own
+ * kind, on an index kept on a cache line of its own, and meet each other only
+ * at the slots.
+ *
+ * A push to a full queue and a pop from an empty one fail at once rather than
+ * wait. Elements pushed by one producer are popped in the order they were
+ * pushed, but pops by different consumers may finish in any order.
+ *
+ * The queue relies on stdatomic.h. Where it is not available the queue may
+ * still be used, but only by a single thread.
+ *
+ * NULL elements are not supported, as NULL is returned by an empty queue.
+ *
+ * Memory overhead can be calculated as follows:
+ * 2 words for each slot of capacity, plus four cache lines
+ */
+struct smpmcqueue_t;
+typedef struct smpmcqueue_t smpmcqueue_t;
+
+/**
+ * Gets the number of elements an MPMC queue can hold.
+ *
+ * @param queue The MPMC queue to get the capacity of.
+ *
+ * @return the capacity of the queue, or 0 if queue is NULL
+ */
+size_t
+SMPMCQueueCapacity
+( const smpmcqueue_t *queue );
+
+/**
+ * Destroys an MPMC queue. Does not affect the elements stored in the queue.
+ * No thread may be using the queue.
+ *
+ * @param queue The MPMC queue to destroy.
+ */
+void
+SMPMCQueueDestroy
+( const smpmcqueue_t *queue );
+
+/**
+ * Checks an MPMC queue to see if it's empty. While other threads are using the
+ * queue the answer may have changed by the time it is returned.
+ *
+ * @param queue The MPMC queue to check.
+ *
+ * @return a positive value if the queue is NULL or empty, 0 otherwise
+ */
+unsigned short
+SMPMCQueueIsEmpty
+( const smpmcqueue_t *queue );
+
+/**
+ * Creates an empty MPMC queue.
+ *
+ * @param capacity The most elements the queue may hold, which is rounded up to
+ * a power of two of at least 2. Must be greater than 0.
+ *
+ * @return a new MPMC queue, or NULL on failure
+ */
+smpmcqueue_t *
+SMPMCQueueNew
+( size_t capacity );
+
+/**
+ * Gets the number of elements in an MPMC queue, counting those being pushed
+ * and popped. While other threads are using the queue the size may have
+ * changed by the time it is returned.
+ *
+ * @param queue The MPMC queue to measure.
+ *
+ * @return the number of elements in the queue, or 0 if queue is NULL
+ */
+size_t
+SMPMCQueueSize
+( const smpmcqueue_t *queue );
+
+/**
+ * Removes the front element of an MPMC queue and returns it, unless the queue
+ * is empty. Any thread may call this at any time.
+ *
+ * @param queue The MPMC queue to pop from. Must not be NULL.
+ *
+ * @return the front element, or NULL if the queue is empty
+ */
+void *
+SMPMCQueueTryPop
+( smpmcqueue_t *queue );
+
+/**
+ * Puts an element at the back of an MPMC queue, unless the queue is full. Any
+ * thread may call this at any time.
+ *
+ * @param queue The MPMC queue to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ *
+ * @return queue, or NULL if the queue is full
+ */
+smpmcqueue_t *
+SMPMCQueueTryPush
+( smpmcqueue_t *queue, void *element );
+
+#endif
@@ -12,8 +12,11 @@
  * First In First Out (FIFO) structure. Elements can only be pushed to the back
  * of the structure and pulled from the front.
  *
- * Memory for this structure is allocated in blocks. The initial capacity can be
- * set by using the NewSizedStaticQueue constructor function, and changed later
+ * The elements are kept in a ring whose capacity is always a power of two, so
+ * that stepping around it is a mask rather than a division. When a push finds
+ * the ring full its capacity is doubled, and the elements are moved to the
+ * start of the new ring in at most two copies. The initial capacity can be set
+ * by using the NewSizedStaticQueue constructor function, and changed later
  * using the SetStaticQueueCapacity and TrimStaticQueueToSize functions.
  *
  * Memory overhead can be calculated as follows:
@@ -49,7 +52,7 @@ DestroyStaticQueue
 #define SQueueDestroy DestroyStaticQueue
 
 /**
- * Creates a new Queue. The default capacity of the Queue is 100.
+ * Creates a new Queue. The default capacity of the Queue is 128.
  *
  * @return a new Queue or NULL on failure
  */
@@ -61,7 +64,8 @@ NewStaticQueue
 /**
  * Creates a new Queue of the given capacity.
  *
- * @param capacity the capacity to give the Queue
+ * @param capacity the capacity to give the Queue, which is rounded up to a
+ * power of two
  *
  * @return a new Queue of the provided capacity, or NULL on failure
  */
@@ -95,8 +99,24 @@ PopFromStaticQueue
 #define SQueuePop PopFromStaticQueue
 
 /**
- * Puts an element at the back of the Queue. If the Queue or value passed are
- * NULL then no action is taken and NULL is returned.
+ * Removes up to a number of elements from the front of the Queue at once,
+ * copying them out in at most two blocks.
+ *
+ * @param queue the Queue to pull the front values from
+ * @param out the array to put the values in, in the order they were pushed
+ * @param max the most values to pop, which out must have room for
+ *
+ * @return the number of values popped, or 0 if queue or out is NULL
+ */
+size_t
+PopNFromStaticQueue
+( StaticQueue *queue, void **out, size_t max );
+#define SQueuePopN PopNFromStaticQueue
+
+/**
+ * Puts an element at the back of the Queue, doubling its capacity if it is
+ * full. If the Queue or value passed are NULL then no action is taken and NULL
+ * is returned.
  *
  * @param queue the Queue to push to. Must not be NULL.
  * @param value the value to push to the Queue. Must not be NULL.
@@ -108,12 +128,30 @@ PushToStaticQueue
 ( StaticQueue *queue, void *value );
 #define SQueuePush PushToStaticQueue
 
+/**
+ * Puts an array of elements at the back of the Queue at once, in the order
+ * they are in the array. The Queue grows at most once to make room, and the
+ * elements are copied in in at most two blocks.
+ *
+ * @param queue the Queue to push to. Must not be NULL.
+ * @param elements the values to push, none of which may be NULL. May only be
+ * NULL if count is 0.
+ * @param count the number of values to push
+ *
+ * @return the Queue pushed to, or NULL on failure or if any of the elements is
+ * NULL, in which case nothing is pushed
+ */
+StaticQueue *
+PushNToStaticQueue
+( StaticQueue *queue, void **elements, size_t count );
+#define SQueuePushN PushNToStaticQueue
+
 /**
  * Gets the current capacity of the Queue.
  *
  * @param queue the Queue to get the capacity of
  *
- * @return the current capacity of the Queue
+ * @return the current capacity of the Queue, or 0 if queue is NULL
  */
 size_t
 StaticQueueCapacity
@@ -188,14 +226,15 @@ RemoveFromStaticQueue
 #define SQueueRemove RemoveFromStaticQueue
 
 /**
- * Changes a Queue's capacity to a new value. If the new capacity is smaller
- * than the current number of elements, then the elements at the back of the
- * Queue that no longer have room are dropped.
+ * Changes a Queue's capacity to a new value, rounded up to a power of two. If
+ * the new capacity is smaller than the current number of elements, then the
+ * elements at the back of the Queue that no longer have room are dropped.
  *
- * @param queue the Queue to resize
+ * @param queue the Queue to resize. Must not be NULL.
  * @param capacity the new capacity of the Queue
  *
- * @return the Queue having been resized
+ * @return the Queue having been resized, or NULL if memory was not available,
+ * in which case the Queue is unchanged
  */
 StaticQueue *
 SetStaticQueueCapacity
@@ -203,13 +242,14 @@ SetStaticQueueCapacity
 #define SQueueSetCapacity SetStaticQueueCapacity
 
 /**
- * Shrinks the Queue to its current size. This guarantees that the Queue is
- * using the minimum amount of memory available. If the Queue cannot be resized,
- * then the Queue is left at the original size (which is returned).
+ * Shrinks the Queue to the smallest power of two holding its current size.
+ * This guarantees that the Queue is using the minimum amount of memory
+ * available. If the Queue cannot be resized, then the Queue is left at the
+ * original capacity (which is returned).
  *
  * @param queue the Queue to resize
  *
- * @return the new size of the Queue
+ * @return the new capacity of the Queue, or 0 if queue is NULL
  */
 size_t
 TrimStaticQueueToSize
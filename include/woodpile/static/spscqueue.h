@@ -0,0 +1,133 @@
+#ifndef __WOODPILE_STATIC_SPSCQUEUE_H
+#define __WOODPILE_STATIC_SPSCQUEUE_H
+
+/**
+ * @file
+ * Single-producer single-consumer queue declaration and functions
+ */
+
+#include <stddef.h>
+
+/**
+ * @struct SPSCQueue
+ * The StaticSPSCQueue data structure is a First In First Out (FIFO) ring of a
+ * fixed capacity that passes elements from one thread to another without a
+ * lock. At any one time only one thread may push to the queue and only one
+ * thread may pop from it, which may be the same thread.
+ *
+ * The front and back of the ring are each written by only one side, with
+ * release stores that the other side reads with acquire loads, so an element
+ * is always written before the other side can see it. They are kept on cache
+ * lines of their own, and each side keeps its own copy of the other side's
+ * index, only reloading it when the copy says the ring is full or empty. In
+ * the common case a push or pop touches no cache line written by the other
+ * thread but the slot itself.
+ *
+ * The ordering relies on stdatomic.h. Where it is not available the indices
+ * are volatile, which only orders them on compilers and processors that treat
+ * volatile accesses as acquire and release, such as MSVC on x86.
+ *
+ * NULL elements are not supported, as NULL is returned by an empty queue.
+ *
+ * Memory overhead can be calculated as follows:
+ * sizeof( void * ) * capacity, plus four cache lines
+ */
+struct sspscqueue_t;
+typedef struct sspscqueue_t sspscqueue_t;
+
+/**
+ * Gets the number of elements an SPSC queue can hold.
+ *
+ * @param queue The SPSC queue to get the capacity of.
+ *
+ * @return the capacity of the queue, or 0 if queue is NULL
+ */
+size_t
+SSPSCQueueCapacity
+( const sspscqueue_t *queue );
+
+/**
+ * Destroys an SPSC queue. Does not affect the elements stored in the queue.
+ * Neither side may be using the queue.
+ *
+ * @param queue The SPSC queue to destroy.
+ */
+void
+SSPSCQueueDestroy
+( const sspscqueue_t *queue );
+
+/**
+ * Checks an SPSC queue to see if it's empty. When called by the producer the
+ * queue may have been emptied since, and when called by the consumer it may
+ * have been pushed to since.
+ *
+ * @param queue The SPSC queue to check.
+ *
+ * @return a positive value if the queue is NULL or empty, 0 otherwise
+ */
+unsigned short
+SSPSCQueueIsEmpty
+( const sspscqueue_t *queue );
+
+/**
+ * Creates an empty SPSC queue.
+ *
+ * @param capacity The most elements the queue may hold, which is rounded up to
+ * a power of two. Must be greater than 0.
+ *
+ * @return a new SPSC queue, or NULL on failure
+ */
+sspscqueue_t *
+SSPSCQueueNew
+( size_t capacity );
+
+/**
+ * Gets the front element of an SPSC queue without removing it. Only the
+ * consumer may call this.
+ *
+ * @param queue The SPSC queue to peek at. Must not be NULL.
+ *
+ * @return the front element, or NULL if the queue is empty
+ */
+void *
+SSPSCQueuePeek
+( sspscqueue_t *queue );
+
+/**
+ * Removes the front element of an SPSC queue and returns it. Only the consumer
+ * may call this.
+ *
+ * @param queue The SPSC queue to pop from. Must not be NULL.
+ *
+ * @return the front element, or NULL if the queue is empty
+ */
+void *
+SSPSCQueuePop
+( sspscqueue_t *queue );
+
+/**
+ * Puts an element at the back of an SPSC queue. Only the producer may call
+ * this. The queue does not grow, so a push to a full queue fails.
+ *
+ * @param queue The SPSC queue to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ *
+ * @return queue, or NULL if the queue is full
+ */
+sspscqueue_t *
+SSPSCQueuePush
+( sspscqueue_t *queue, void *element );
+
+/**
+ * Gets the number of elements in an SPSC queue. While the other side is
+ * running the size may have changed by the time it is returned.
+ *
+ * @param queue The SPSC queue to measure.
+ *
+ * @return the number of elements in the queue, or 0 if queue is NULL
+ */
+size_t
+SSPSCQueueSize
+( const sspscqueue_t *queue );
+
+#endif
@@ -94,6 +94,25 @@ PopFromStaticStack
 ( SStack *stack );
 #define SStackPop PopFromStaticStack
 
+/**
+ * Pops up to max elements bottom-first, the reverse of repeated SStackPop.
+ *
+ * The elements are removed from the top of the Stack at once and copied out
+ * in a single block, in the order they were pushed. The last one in out was
+ * the top of the Stack, and pushing out back with PushNToStaticStack restores
+ * the Stack.
+ *
+ * @param stack the Stack to pop the elements from
+ * @param out the array to put the elements in
+ * @param max the most elements to pop, which out must have room for
+ *
+ * @return the number of elements popped, or 0 if stack or out is NULL
+ */
+size_t
+PopNFromStaticStack
+( SStack *stack, void **out, size_t max );
+#define SStackPopN PopNFromStaticStack
+
 /**
  * Puts an element onto the top of the Stack. If the Stack or value are NULL
  * then no action is taken.
@@ -108,6 +127,24 @@ PushToStaticStack
 ( SStack *stack, void *value );
 #define SStackPush PushToStaticStack
 
+/**
+ * Pushes an array of elements in order, so that the last one ends up on top.
+ *
+ * The Stack grows at most once to make room, and the elements are copied in a
+ * single block.
+ *
+ * @param stack the Stack to push on to
+ * @param values the values to push, which may only be NULL if count is 0
+ * @param count the number of values to push
+ *
+ * @return the Stack that was pushed to, or NULL on failure, in which case
+ * nothing is pushed
+ */
+SStack *
+PushNToStaticStack
+( SStack *stack, void **values, size_t count );
+#define SStackPushN PushNToStaticStack
+
 /**
  * Resizes the given Stack to the specified capacity. If the given capacity is
  * less than the current number of elements, then the extra items at the top of
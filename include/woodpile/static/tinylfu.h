@@ -0,0 +1,213 @@
+#ifndef __WOODPILE_STATIC_TINYLFU_H
+#define __WOODPILE_STATIC_TINYLFU_H
+
+/**
+ * @file
+ * TinyLFU cache declaration and functions
+ */
+
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+
+/**
+ * @struct TinyLFU
+ * The StaticTinyLFU data structure is a key-value cache holding at most a
+ * fixed number of entries, which decides what to keep by how often keys are
+ * used as well as how recently. It follows the W-TinyLFU design: new keys
+ * enter a small window kept in least recently used order, taking about 1% of
+ * the capacity. A key pushed out of the window is only admitted to the main
+ * region if it has been used more often than the entry that would be evicted
+ * to make room for it. Otherwise the key itself is evicted. This keeps a scan
+ * over many keys used only once from flushing out the keys used most.
+ *
+ * The main region is split into a probation segment, holding keys admitted
+ * but not used since, and a protected segment of 80% of the main region,
+ * holding keys used again after being admitted. Keys are evicted from the
+ * probation segment, and keys pushed out of the protected segment go back to
+ * it.
+ *
+ * How often each key is used is estimated by a count-min sketch of four rows
+ * of 4-bit counters, indexed by the hash of the key. Every get and put of a
+ * key counts, whether the key is in the cache or not. Once there have been ten
+ * times as many counts as the sketch has columns, every counter is halved, so
+ * that the estimates follow changes in what is popular.
+ *
+ * Getting, putting and evicting are all constant time, and no memory is
+ * allocated after the cache is created. NULL keys and values are not supported.
+ *
+ * Memory overhead can be calculated as follows:
+ * 5 words and 2 to 4 bytes of sketch for each entry of capacity, plus an SHash
+ * of twice the capacity
+ */
+
+struct stinylfu_t;
+typedef struct stinylfu_t stinylfu_t;
+
+/**
+ * Gets the number of entries a TinyLFU cache can hold.
+ *
+ * @param cache The TinyLFU cache to get the capacity of.
+ *
+ * @return the capacity of the cache, or 0 if cache is NULL
+ */
+size_t
+STinyLFUCapacity
+( const stinylfu_t *cache );
+
+/**
+ * Destroys a TinyLFU cache. If an evictor is set, it is called for each entry
+ * still in the cache, so that their values can be freed.
+ *
+ * @param cache The TinyLFU cache to destroy.
+ */
+void
+STinyLFUDestroy
+( const stinylfu_t *cache );
+
+/**
+ * Gets the estimated number of times a key has been used, which is what
+ * decides whether it is admitted to the main region of the cache.
+ *
+ * @param cache The TinyLFU cache to check.
+ * @param key The key to estimate.
+ *
+ * @return the estimated use count of the key, at most 15, or 0 if cache or key
+ * is NULL
+ */
+unsigned
+STinyLFUFrequency
+( const stinylfu_t *cache, const void *key );
+
+/**
+ * Gets the value of a key, counting a use of the key and making it the most
+ * recently used of its region. A key in the probation segment is moved to the
+ * protected segment.
+ *
+ * @param cache The TinyLFU cache to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value of the key, or NULL if it is not in the cache
+ */
+void *
+STinyLFUGet
+( stinylfu_t *cache, const void *key );
+
+/**
+ * Checks a TinyLFU cache to see if it's empty.
+ *
+ * @param cache The TinyLFU cache to check.
+ *
+ * @return a positive value if the cache is NULL or empty, 0 otherwise
+ */
+unsigned short
+STinyLFUIsEmpty
+( const stinylfu_t *cache );
+
+/**
+ * Creates an empty TinyLFU cache. Keys are compared with ComparePointers and
+ * hashed with MixedPointerHash.
+ *
+ * @param capacity The most entries the cache may hold. Must be greater than 0.
+ *
+ * @return a new TinyLFU cache, or NULL on failure
+ */
+stinylfu_t *
+STinyLFUNew
+( size_t capacity );
+
+/**
+ * Gets the value of a key without counting a use or changing where the key is
+ * kept.
+ *
+ * @param cache The TinyLFU cache to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value of the key, or NULL if it is not in the cache
+ */
+void *
+STinyLFUPeek
+( const stinylfu_t *cache, const void *key );
+
+/**
+ * Maps a key to a value in a TinyLFU cache, counting a use of the key. A new
+ * key is put into the window, and if this pushes a key out of the window then
+ * either it or the next victim of the main region is evicted and given to the
+ * evictor. A key already present is treated as by STinyLFUGet. A NULL value
+ * is equivalent to calling STinyLFURemove with the key.
+ *
+ * @param cache The TinyLFU cache to put into. Must not be NULL.
+ * @param key The key to map. Must not be NULL.
+ * @param value The value to map the key to.
+ *
+ * @return the previous value of the key if it was already present, which is
+ * not given to the evictor, or value if the key was new
+ */
+void *
+STinyLFUPut
+( stinylfu_t *cache, void *key, void *value );
+
+/**
+ * Removes a key from a TinyLFU cache. The evictor is not called, and the
+ * estimated use count of the key is not changed.
+ *
+ * @param cache The TinyLFU cache to remove from. Must not be NULL.
+ * @param key The key to remove. Must not be NULL.
+ *
+ * @return the value the key was mapped to, or NULL if it was not present
+ */
+void *
+STinyLFURemove
+( stinylfu_t *cache, const void *key );
+
+/**
+ * Sets the function told of each entry evicted from a TinyLFU cache, or
+ * destroyed along with it.
+ *
+ * @param cache The TinyLFU cache to update. Must not be NULL.
+ * @param evict The function given the key and value of each evicted entry,
+ * along with context, or NULL to stop telling of evictions.
+ * @param context The context to pass to evict.
+ *
+ * @return cache
+ */
+stinylfu_t *
+STinyLFUSetEvictor
+( stinylfu_t *cache, void ( *evict )( void *, void *, void * ), void *context );
+
+/**
+ * Sets the hashing function for the keys of a TinyLFU cache. The estimated
+ * use counts are cleared, as they were counted under the old hashes.
+ *
+ * @param cache The TinyLFU cache to update. Must not be NULL.
+ * @param hasher The hashing function to use. Must not be NULL.
+ *
+ * @return cache, or NULL if the keys could not be rehashed
+ */
+stinylfu_t *
+STinyLFUSetHasher
+( stinylfu_t *cache, hasher_t hasher );
+
+/**
+ * Sets the comparator used to find the keys of a TinyLFU cache.
+ *
+ * @param cache The TinyLFU cache to update. Must not be NULL.
+ * @param comparator The key comparator to use. Must not be NULL.
+ *
+ * @return cache, or NULL if the keys could not be rehashed
+ */
+stinylfu_t *
+STinyLFUSetKeyComparator
+( stinylfu_t *cache, comparator_t comparator );
+
+/**
+ * Gets the number of entries in a TinyLFU cache.
+ *
+ * @param cache The TinyLFU cache to get the size of.
+ *
+ * @return the number of entries in the cache, or 0 if cache is NULL
+ */
+size_t
+STinyLFUSize
+( const stinylfu_t *cache );
+
+#endif
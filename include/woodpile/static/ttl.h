@@ -0,0 +1,239 @@
+#ifndef __WOODPILE_STATIC_TTL_H
+#define __WOODPILE_STATIC_TTL_H
+
+/**
+ * @file
+ * TTL map declaration and functions
+ */
+
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+
+/**
+ * @struct TTL
+ * The StaticTTL data structure is a key-value map whose entries expire once a
+ * lifetime given when they are put has passed. Time is kept by the map as a
+ * count of ticks, and only moves when the owner calls STTLAdvance with the
+ * current tick, so the map is not tied to any particular clock or resolution.
+ *
+ * Expired entries are found two ways. A lookup of an expired entry drops it
+ * and misses, so an entry is never seen after its deadline. The rest are found
+ * by a hashed timing wheel: each entry is threaded into the wheel slot of its
+ * deadline, and advancing the time visits only the slots of the ticks that
+ * passed, expiring the entries there whose deadline has come. Each call to
+ * STTLAdvance does at most a given amount of work, picking up where the last
+ * call stopped, so expiry can be spread over an event loop without a pause.
+ *
+ * The entries are kept in a single array, found through an SHash mapping each
+ * key to its entry. An evictor may be set to be told of each entry that
+ * expires, so that the owner of the values can free them. NULL keys and values
+ * are not supported.
+ *
+ * Memory overhead can be calculated as follows:
+ * 5 words for each entry of capacity, 2 words for each wheel slot, plus an
+ * SHash of twice the capacity
+ */
+
+struct sttl_t;
+typedef struct sttl_t sttl_t;
+
+/**
+ * Moves the time of a TTL map forward, and expires entries whose deadline has
+ * come until either all of them are gone or the work budget is spent. Each
+ * entry and each wheel slot visited counts as one unit of work. Entries left
+ * past their deadline are still never returned, and a later call continues
+ * where this one stopped.
+ *
+ * @param ttl The TTL map to advance.
+ * @param now The current tick. Times earlier than the time of the map are
+ * treated as the time of the map.
+ * @param budget The most units of work to do.
+ *
+ * @return the number of entries expired, or 0 if ttl is NULL
+ */
+size_t
+STTLAdvance
+( sttl_t *ttl, unsigned long long now, size_t budget );
+
+/**
+ * Gets the number of entries a TTL map can hold.
+ *
+ * @param ttl The TTL map to get the capacity of.
+ *
+ * @return the capacity of the map, or 0 if ttl is NULL
+ */
+size_t
+STTLCapacity
+( const sttl_t *ttl );
+
+/**
+ * Gets the tick at which a key expires.
+ *
+ * @param ttl The TTL map to search.
+ * @param key The key to look up.
+ *
+ * @return the deadline of the key, or 0 if ttl or key is NULL or the key is
+ * not in the map or has expired
+ */
+unsigned long long
+STTLDeadline
+( const sttl_t *ttl, const void *key );
+
+/**
+ * Destroys a TTL map. If an evictor is set, it is called for each entry still
+ * in the map, so that their values can be freed.
+ *
+ * @param ttl The TTL map to destroy.
+ */
+void
+STTLDestroy
+( const sttl_t *ttl );
+
+/**
+ * Gets the value of a key. If the key has expired it is dropped from the map
+ * and given to the evictor.
+ *
+ * @param ttl The TTL map to search. Must not be NULL.
+ * @param key The key to look up. Must not be NULL.
+ *
+ * @return the value of the key, or NULL if it is not in the map or has expired
+ */
+void *
+STTLGet
+( sttl_t *ttl, const void *key );
+
+/**
+ * Checks a TTL map to see if it's empty.
+ *
+ * @param ttl The TTL map to check.
+ *
+ * @return a positive value if the map is NULL or empty, 0 otherwise
+ */
+unsigned short
+STTLIsEmpty
+( const sttl_t *ttl );
+
+/**
+ * Creates an empty TTL map at tick 0. Keys are compared with ComparePointers
+ * and hashed with MixedPointerHash.
+ *
+ * @param capacity The most entries the map may hold. Must be greater than 0.
+ * @param slots The number of slots in the timing wheel, which is rounded up
+ * to a power of two. Must be greater than 0. Entries are expired with the
+ * least wasted work when this is close to the longest lifetime used, in ticks.
+ *
+ * @return a new TTL map, or NULL on failure
+ */
+sttl_t *
+STTLNew
+( size_t capacity, size_t slots );
+
+/**
+ * Gets the current tick of a TTL map.
+ *
+ * @param ttl The TTL map to check.
+ *
+ * @return the last tick passed to STTLAdvance, or 0 if ttl is NULL
+ */
+unsigned long long
+STTLNow
+( const sttl_t *ttl );
+
+/**
+ * Maps a key to a value in a TTL map until a number of ticks have passed. If
+ * the key is already present, its value and deadline are both replaced. A NULL
+ * value is equivalent to calling STTLRemove with the key.
+ *
+ * @param ttl The TTL map to put into. Must not be NULL.
+ * @param key The key to map. Must not be NULL.
+ * @param value The value to map the key to.
+ * @param lifetime The number of ticks until the entry expires. Must be
+ * greater than 0.
+ *
+ * @return the previous value of the key if it was present, which is not given
+ * to the evictor, value if the key was new, or NULL if the map is full
+ */
+void *
+STTLPut
+( sttl_t *ttl, void *key, void *value, unsigned long long lifetime );
+
+/**
+ * Removes a key from a TTL map. The evictor is not called unless the key is
+ * found to have expired, in which case it is dropped as by STTLGet.
+ *
+ * @param ttl The TTL map to remove from. Must not be NULL.
+ * @param key The key to remove. Must not be NULL.
+ *
+ * @return the value the key was mapped to, or NULL if it was not present or
+ * had expired
+ */
+void *
+STTLRemove
+( sttl_t *ttl, const void *key );
+
+/**
+ * Increases the number of entries a TTL map can hold.
+ *
+ * @param ttl The TTL map to grow. Must not be NULL.
+ * @param capacity The new capacity. Must not be less than the current
+ * capacity.
+ *
+ * @return ttl, or NULL if memory was not available, in which case the map is
+ * unchanged
+ */
+sttl_t *
+STTLSetCapacity
+( sttl_t *ttl, size_t capacity );
+
+/**
+ * Sets the function told of each entry that expires from a TTL map, or is
+ * destroyed along with it.
+ *
+ * @param ttl The TTL map to update. Must not be NULL.
+ * @param evict The function given the key and value of each expired entry,
+ * along with context, or NULL to stop telling of expiry.
+ * @param context The context to pass to evict.
+ *
+ * @return ttl
+ */
+sttl_t *
+STTLSetEvictor
+( sttl_t *ttl, void ( *evict )( void *, void *, void * ), void *context );
+
+/**
+ * Sets the hashing function for the keys of a TTL map.
+ *
+ * @param ttl The TTL map to update. Must not be NULL.
+ * @param hasher The hashing function to use. Must not be NULL.
+ *
+ * @return ttl, or NULL if the keys could not be rehashed
+ */
+sttl_t *
+STTLSetHasher
+( sttl_t *ttl, hasher_t hasher );
+
+/**
+ * Sets the comparator used to find the keys of a TTL map.
+ *
+ * @param ttl The TTL map to update. Must not be NULL.
+ * @param comparator The key comparator to use. Must not be NULL.
+ *
+ * @return ttl, or NULL if the keys could not be rehashed
+ */
+sttl_t *
+STTLSetKeyComparator
+( sttl_t *ttl, comparator_t comparator );
+
+/**
+ * Gets the number of entries in a TTL map. This includes entries that have
+ * expired but not yet been found by a lookup or STTLAdvance.
+ *
+ * @param ttl The TTL map to get the size of.
+ *
+ * @return the number of entries in the map, or 0 if ttl is NULL
+ */
+size_t
+STTLSize
+( const sttl_t *ttl );
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef __WOODPILE_STATIC_WSDEQUE_H
+#define __WOODPILE_STATIC_WSDEQUE_H
+
+/**
+ * @file
+ * Work-stealing deque declaration and functions
+ */
+
+#include <stddef.h>
+
+/**
+ * @struct WSDeque
+ * The StaticWSDeque data structure is a lock-free double-ended queue for task
+ * schedulers, in which each worker thread owns a deque of the tasks it has
+ * forked. It is the deque described by Chase and Lev, in the C11 atomics
+ * formulation given by Le, Pop, Cohen and Zappa Nardelli.
+ *
+ * Only the thread owning the deque may push and pop, both at the bottom, so
+ * the owner works on its tasks in Last In First Out order, keeping the data of
+ * the task it just forked warm in its cache. Any other thread may steal from
+ * the top, taking the oldest task, which in a fork/join program is usually the
+ * largest. The owner and the thieves only contend for the last element; the
+ * owner does not need a compare-and-swap otherwise.
+ *
+ * The elements are kept in a ring whose capacity is a power of two. When a
+ * push finds it full, the owner moves the elements into a ring of twice the
+ * capacity. As a thief may still be reading the old ring, it is kept until the
+ * deque is destroyed, which costs at most as much memory as the current ring.
+ *
+ * The deque relies on stdatomic.h. Where it is not available the deque may
+ * still be used, but only by a single thread.
+ *
+ * NULL elements are not supported, as NULL is returned by an empty deque.
+ *
+ * Memory overhead can be calculated as follows:
+ * 2 words for each slot of capacity, plus three cache lines
+ */
+struct swsdeque_t;
+typedef struct swsdeque_t swsdeque_t;
+
+/**
+ * Gets the number of elements a work-stealing deque can hold before it has to
+ * grow. May only be called by the owner of the deque.
+ *
+ * @param deque The work-stealing deque to get the capacity of.
+ *
+ * @return the capacity of the deque, or 0 if deque is NULL
+ */
+size_t
+SWSDequeCapacity
+( const swsdeque_t *deque );
+
+/**
+ * Destroys a work-stealing deque, along with every ring it has outgrown. Does
+ * not affect the elements stored in the deque. No thread may be using the
+ * deque.
+ *
+ * @param deque The work-stealing deque to destroy.
+ */
+void
+SWSDequeDestroy
+( const swsdeque_t *deque );
+
+/**
+ * Checks a work-stealing deque to see if it's empty. As other threads may be
+ * stealing, the answer may be out of date by the time it is returned.
+ *
+ * @param deque The work-stealing deque to check.
+ *
+ * @return a positive value if the deque is NULL or empty, 0 otherwise
+ */
+unsigned short
+SWSDequeIsEmpty
+( const swsdeque_t *deque );
+
+/**
+ * Creates a new empty work-stealing deque.
+ *
+ * @param capacity The starting capacity of the deque, which is rounded up to a
+ * power of two. Must be greater than 0.
+ *
+ * @return a new work-stealing deque, or NULL on failure
+ */
+swsdeque_t *
+SWSDequeNew
+( size_t capacity );
+
+/**
+ * Removes the bottom element of a work-stealing deque, which is the one most
+ * recently pushed. May only be called by the owner of the deque.
+ *
+ * @param deque The work-stealing deque to pop from. Must not be NULL.
+ *
+ * @return the bottom element, or NULL if the deque is empty or a thief stole
+ * the last element first
+ */
+void *
+SWSDequePop
+( swsdeque_t *deque );
+
+/**
+ * Adds an element to the bottom of a work-stealing deque, doubling its
+ * capacity if it is full. May only be called by the owner of the deque.
+ *
+ * @param deque The work-stealing deque to push to. Must not be NULL.
+ * @param element The element to push. Must not be NULL.
+ *
+ * @return deque, or NULL if the deque had to grow and memory was not
+ * available, in which case the deque is unchanged
+ */
+swsdeque_t *
+SWSDequePush
+( swsdeque_t *deque, void *element );
+
+/**
+ * Gets the number of elements in a work-stealing deque. As other threads may
+ * be stealing, the answer may be out of date by the time it is returned.
+ *
+ * @param deque The work-stealing deque to get the size of.
+ *
+ * @return the number of elements in the deque, or 0 if deque is NULL
+ */
+size_t
+SWSDequeSize
+( const swsdeque_t *deque );
+
+/**
+ * Removes the top element of a work-stealing deque, which is the oldest. May
+ * be called by any thread.
+ *
+ * @param deque The work-stealing deque to steal from. Must not be NULL.
+ *
+ * @return the top element, or NULL if the deque is empty or another thread
+ * took the top element first, in which case the caller may try again
+ */
+void *
+SWSDequeSteal
+( swsdeque_t *deque );
+
+#endif
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <woodpile/dynamic/queue.h>
+#include "lib/validate.h"
+#include "private/dynamic/queue.h"
+
+void
+DQueueDestroy
+( const dqueue_t *queue )
+{
+  struct dqueue_block_t *block, *next;
+
+  if( queue ){
+    for( block = queue->first; block; block = next ){
+      next = block->next;
+      free( block );
+    }
+
+    for( block = queue->spare; block; block = next ){
+      next = block->next;
+      free( block );
+    }
+
+    free( (void *) queue );
+  }
+
+  return;
+}
+
+unsigned short
+DQueueIsEmpty
+( const dqueue_t *queue )
+{
+  return queue == NULL || queue->size == 0;
+}
+
+dqueue_t *
+DQueueNew
+( void )
+{
+  dqueue_t *queue;
+
+  queue = malloc( sizeof( dqueue_t ) );
+  VALIDATE_ALLOCATION( queue )
+
+  queue->back = queue->front = 0;
+  queue->first = queue->last = queue->spare = NULL;
+  queue->size = queue->spare_count = 0;
+
+  return queue;
+}
+
+void *
+DQueuePeek
+( const dqueue_t *queue )
+{
+  if( DQueueIsEmpty( queue ) )
+    return NULL;
+
+  return queue->first->elements[queue->front];
+}
+
+void *
+DQueuePop
+( dqueue_t *queue )
+{
+  struct dqueue_block_t *block;
+  void *element;
+
+  VALIDATE_PARAMETERS( queue )
+
+  if( queue->size == 0 )
+    return NULL;
+
+  element = queue->first->elements[queue->front++];
+  queue->size--;
+
+  if( queue->size == 0 ){
+    // the only block left is reused from its start rather than released
+    queue->back = queue->front = 0;
+  } else if( queue->front == DQUEUE_BLOCK_SIZE ){
+    block = queue->first;
+    queue->first = block->next;
+    queue->front = 0;
+    DQueueRelease( queue, block );
+  }
+
+  return element;
+}
+
+dqueue_t *
+DQueuePush
+( dqueue_t *queue, void *element )
+{
+  struct dqueue_block_t *block;
+
+  VALIDATE_PARAMETERS( queue && element )
+
+  if( !queue->last || queue->back == DQUEUE_BLOCK_SIZE ){
+    if( queue->spare ){
+      block = queue->spare;
+      queue->spare = block->next;
+      queue->spare_count--;
+    } else {
+      block = malloc( sizeof( struct dqueue_block_t ) );
+      VALIDATE_ALLOCATION( block )
+    }
+
+    block->next = NULL;
+    if( queue->last )
+      queue->last->next = block;
+    else
+      queue->first = block;
+
+    queue->back = 0;
+    queue->last = block;
+  }
+
+  queue->last->elements[queue->back++] = element;
+  queue->size++;
+
+  return queue;
+}
+
+size_t
+DQueueSize
+( const dqueue_t *queue )
+{
+  if( !queue )
+    return 0;
+
+  return queue->size;
+}
+
+static
+void
+DQueueRelease
+( dqueue_t *queue, struct dqueue_block_t *block )
+{
+  if( queue->spare_count < DQUEUE_SPARE_BLOCKS ){
+    block->next = queue->spare;
+    queue->spare = block;
+    queue->spare_count++;
+  } else {
+    free( block );
+  }
+}
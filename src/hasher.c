@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
@@ -5,6 +6,24 @@
 #include <woodpile/hasher.h>
 #include "private/hasher.h"
 
+#ifdef HASHER_X86
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+# include <immintrin.h>
+# include <nmmintrin.h>
+#endif
+
+/** the number of string lengths measured at a time by HashStringBatch */
+#define STRING_BATCH_SIZE 64
+
+#if defined( HASHER_ARM ) && defined( __linux__ )
+# include <sys/auxv.h>
+# ifndef HWCAP_CRC32
+#  define HWCAP_CRC32 (1 << 7)
+# endif
+#endif
+
 #ifdef __WOODPILE_CITY_HASHER
 unsigned long long
 CityDataHash
@@ -13,14 +32,471 @@ CityDataHash
   return 0;
 }
 
+unsigned long long *
+CityDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashBatchSerially( CityDataHash, data, lengths, count, seed, hashes );
+}
+
 unsigned long long
 CityHash
 ( const void *str, unsigned long long seed )
 {
   return 0;
 }
+
+unsigned long long *
+CityHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashStringBatch( CityDataHashBatch, strs, count, seed, hashes );
+}
 #endif
 
+#ifdef __WOODPILE_CRC_HASHER
+
+typedef unsigned ( *crc_updater_t )( const void *, size_t, unsigned );
+
+/**
+ * Picks the fastest CRC32C implementation supported by the processor and
+ * installs it as the one used by CRCDataHash, then uses it to compute the
+ * checksum. This is only called the first time a CRC hash is computed.
+ */
+static
+unsigned
+CRCResolveUpdate
+( const void *data, size_t length, unsigned crc );
+
+/**
+ * Picks the fastest CRC batch implementation supported by the processor and
+ * installs it as the one used by CRCDataHashBatch, then uses it to hash the
+ * batch. This is only called the first time a CRC batch is hashed.
+ */
+static
+unsigned long long *
+CRCResolveDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Hashes a batch of blocks one at a time with CRCDataHash.
+ */
+static
+unsigned long long *
+CRCSerialDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+// replaced with the best available implementations on the first call
+static HASHER_DISPATCH( crc_updater_t ) crc_update = CRCResolveUpdate;
+static HASHER_DISPATCH( data_batch_hasher_t ) crc_data_hash_batch = CRCResolveDataHashBatch;
+
+static const unsigned crc_table[256] = {
+  0x00000000u, 0xf26b8303u, 0xe13b70f7u, 0x1350f3f4u,
+  0xc79a971fu, 0x35f1141cu, 0x26a1e7e8u, 0xd4ca64ebu,
+  0x8ad958cfu, 0x78b2dbccu, 0x6be22838u, 0x9989ab3bu,
+  0x4d43cfd0u, 0xbf284cd3u, 0xac78bf27u, 0x5e133c24u,
+  0x105ec76fu, 0xe235446cu, 0xf165b798u, 0x030e349bu,
+  0xd7c45070u, 0x25afd373u, 0x36ff2087u, 0xc494a384u,
+  0x9a879fa0u, 0x68ec1ca3u, 0x7bbcef57u, 0x89d76c54u,
+  0x5d1d08bfu, 0xaf768bbcu, 0xbc267848u, 0x4e4dfb4bu,
+  0x20bd8edeu, 0xd2d60dddu, 0xc186fe29u, 0x33ed7d2au,
+  0xe72719c1u, 0x154c9ac2u, 0x061c6936u, 0xf477ea35u,
+  0xaa64d611u, 0x580f5512u, 0x4b5fa6e6u, 0xb93425e5u,
+  0x6dfe410eu, 0x9f95c20du, 0x8cc531f9u, 0x7eaeb2fau,
+  0x30e349b1u, 0xc288cab2u, 0xd1d83946u, 0x23b3ba45u,
+  0xf779deaeu, 0x05125dadu, 0x1642ae59u, 0xe4292d5au,
+  0xba3a117eu, 0x4851927du, 0x5b016189u, 0xa96ae28au,
+  0x7da08661u, 0x8fcb0562u, 0x9c9bf696u, 0x6ef07595u,
+  0x417b1dbcu, 0xb3109ebfu, 0xa0406d4bu, 0x522bee48u,
+  0x86e18aa3u, 0x748a09a0u, 0x67dafa54u, 0x95b17957u,
+  0xcba24573u, 0x39c9c670u, 0x2a993584u, 0xd8f2b687u,
+  0x0c38d26cu, 0xfe53516fu, 0xed03a29bu, 0x1f682198u,
+  0x5125dad3u, 0xa34e59d0u, 0xb01eaa24u, 0x42752927u,
+  0x96bf4dccu, 0x64d4cecfu, 0x77843d3bu, 0x85efbe38u,
+  0xdbfc821cu, 0x2997011fu, 0x3ac7f2ebu, 0xc8ac71e8u,
+  0x1c661503u, 0xee0d9600u, 0xfd5d65f4u, 0x0f36e6f7u,
+  0x61c69362u, 0x93ad1061u, 0x80fde395u, 0x72966096u,
+  0xa65c047du, 0x5437877eu, 0x4767748au, 0xb50cf789u,
+  0xeb1fcbadu, 0x197448aeu, 0x0a24bb5au, 0xf84f3859u,
+  0x2c855cb2u, 0xdeeedfb1u, 0xcdbe2c45u, 0x3fd5af46u,
+  0x7198540du, 0x83f3d70eu, 0x90a324fau, 0x62c8a7f9u,
+  0xb602c312u, 0x44694011u, 0x5739b3e5u, 0xa55230e6u,
+  0xfb410cc2u, 0x092a8fc1u, 0x1a7a7c35u, 0xe811ff36u,
+  0x3cdb9bddu, 0xceb018deu, 0xdde0eb2au, 0x2f8b6829u,
+  0x82f63b78u, 0x709db87bu, 0x63cd4b8fu, 0x91a6c88cu,
+  0x456cac67u, 0xb7072f64u, 0xa457dc90u, 0x563c5f93u,
+  0x082f63b7u, 0xfa44e0b4u, 0xe9141340u, 0x1b7f9043u,
+  0xcfb5f4a8u, 0x3dde77abu, 0x2e8e845fu, 0xdce5075cu,
+  0x92a8fc17u, 0x60c37f14u, 0x73938ce0u, 0x81f80fe3u,
+  0x55326b08u, 0xa759e80bu, 0xb4091bffu, 0x466298fcu,
+  0x1871a4d8u, 0xea1a27dbu, 0xf94ad42fu, 0x0b21572cu,
+  0xdfeb33c7u, 0x2d80b0c4u, 0x3ed04330u, 0xccbbc033u,
+  0xa24bb5a6u, 0x502036a5u, 0x4370c551u, 0xb11b4652u,
+  0x65d122b9u, 0x97baa1bau, 0x84ea524eu, 0x7681d14du,
+  0x2892ed69u, 0xdaf96e6au, 0xc9a99d9eu, 0x3bc21e9du,
+  0xef087a76u, 0x1d63f975u, 0x0e330a81u, 0xfc588982u,
+  0xb21572c9u, 0x407ef1cau, 0x532e023eu, 0xa145813du,
+  0x758fe5d6u, 0x87e466d5u, 0x94b49521u, 0x66df1622u,
+  0x38cc2a06u, 0xcaa7a905u, 0xd9f75af1u, 0x2b9cd9f2u,
+  0xff56bd19u, 0x0d3d3e1au, 0x1e6dcdeeu, 0xec064eedu,
+  0xc38d26c4u, 0x31e6a5c7u, 0x22b65633u, 0xd0ddd530u,
+  0x0417b1dbu, 0xf67c32d8u, 0xe52cc12cu, 0x1747422fu,
+  0x49547e0bu, 0xbb3ffd08u, 0xa86f0efcu, 0x5a048dffu,
+  0x8ecee914u, 0x7ca56a17u, 0x6ff599e3u, 0x9d9e1ae0u,
+  0xd3d3e1abu, 0x21b862a8u, 0x32e8915cu, 0xc083125fu,
+  0x144976b4u, 0xe622f5b7u, 0xf5720643u, 0x07198540u,
+  0x590ab964u, 0xab613a67u, 0xb831c993u, 0x4a5a4a90u,
+  0x9e902e7bu, 0x6cfbad78u, 0x7fab5e8cu, 0x8dc0dd8fu,
+  0xe330a81au, 0x115b2b19u, 0x020bd8edu, 0xf0605beeu,
+  0x24aa3f05u, 0xd6c1bc06u, 0xc5914ff2u, 0x37faccf1u,
+  0x69e9f0d5u, 0x9b8273d6u, 0x88d28022u, 0x7ab90321u,
+  0xae7367cau, 0x5c18e4c9u, 0x4f48173du, 0xbd23943eu,
+  0xf36e6f75u, 0x0105ec76u, 0x12551f82u, 0xe03e9c81u,
+  0x34f4f86au, 0xc69f7b69u, 0xd5cf889du, 0x27a40b9eu,
+  0x79b737bau, 0x8bdcb4b9u, 0x988c474du, 0x6ae7c44eu,
+  0xbe2da0a5u, 0x4c4623a6u, 0x5f16d052u, 0xad7d5351u
+};
+
+#ifdef HASHER_ARM
+HASHER_TARGET_ARM_CRC32
+unsigned
+CRCARMUpdate
+( const void *data, size_t length, unsigned crc )
+{
+  const unsigned char *bytes = data;
+  unsigned long long word;
+
+  while( length >= sizeof( word ) ){
+    memcpy( &word, bytes, sizeof( word ) );
+    __asm__( "crc32cx %w0, %w0, %x1" : "+r"( crc ) : "r"( word ) );
+    bytes += sizeof( word );
+    length -= sizeof( word );
+  }
+
+  while( length > 0 ){
+    __asm__( "crc32cb %w0, %w0, %w1" : "+r"( crc ) : "r"( (unsigned) *bytes ) );
+    bytes++;
+    length--;
+  }
+
+  return crc;
+}
+#endif
+
+unsigned long long
+CRCDataHash
+( const void *data, size_t length, unsigned long long seed )
+{
+  unsigned crc;
+
+  crc = ~((unsigned) (seed ^ (seed >> 32)));
+
+  return ~HASHER_DISPATCH_LOAD( crc_update )( data, length, crc ) & 0xffffffffuLL;
+}
+
+unsigned long long *
+CRCDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HASHER_DISPATCH_LOAD( crc_data_hash_batch )( data, lengths, count, seed, hashes );
+}
+
+unsigned long long
+CRCHash
+( const void *str, unsigned long long seed )
+{
+  return CRCDataHash( str, strlen( str ), seed );
+}
+
+unsigned long long *
+CRCHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashStringBatch( CRCDataHashBatch, strs, count, seed, hashes );
+}
+
+unsigned long long
+CRCHashFinal
+( const crc_state_t *state )
+{
+  return ~state->crc & 0xffffffffuLL;
+}
+
+crc_state_t *
+CRCHashInit
+( crc_state_t *state, unsigned long long seed )
+{
+  state->crc = ~((unsigned) (seed ^ (seed >> 32)));
+
+  return state;
+}
+
+crc_state_t *
+CRCHashUpdate
+( crc_state_t *state, const void *data, size_t length )
+{
+  state->crc = HASHER_DISPATCH_LOAD( crc_update )( data, length, state->crc );
+
+  return state;
+}
+
+static
+unsigned long long *
+CRCResolveDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  data_batch_hasher_t batch_hasher = CRCSerialDataHashBatch;
+
+#ifdef HASHER_X86_64
+  if( HasherCPUFeatures() & HASHER_CPU_SSE42 )
+    batch_hasher = CRCSSE42DataHashBatch;
+#endif
+
+  HASHER_DISPATCH_STORE( crc_data_hash_batch, batch_hasher );
+
+  return batch_hasher( data, lengths, count, seed, hashes );
+}
+
+static
+unsigned
+CRCResolveUpdate
+( const void *data, size_t length, unsigned crc )
+{
+  unsigned features;
+  crc_updater_t updater = CRCSoftwareUpdate;
+
+  features = HasherCPUFeatures();
+
+#ifdef HASHER_X86
+  if( features & HASHER_CPU_SSE42 )
+    updater = CRCSSE42Update;
+#endif
+
+#ifdef HASHER_ARM
+  if( features & HASHER_CPU_ARM_CRC32 )
+    updater = CRCARMUpdate;
+#endif
+
+  HASHER_DISPATCH_STORE( crc_update, updater );
+
+  return updater( data, length, crc );
+}
+
+static
+unsigned long long *
+CRCSerialDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashBatchSerially( CRCDataHash, data, lengths, count, seed, hashes );
+}
+
+unsigned
+CRCSoftwareUpdate
+( const void *data, size_t length, unsigned crc )
+{
+  const unsigned char *bytes = data;
+
+  while( length > 0 ){
+    crc = crc_table[(crc ^ *bytes) & 0xff] ^ (crc >> 8);
+    bytes++;
+    length--;
+  }
+
+  return crc;
+}
+
+#ifdef HASHER_X86
+HASHER_TARGET_SSE42
+unsigned
+CRCSSE42Update
+( const void *data, size_t length, unsigned crc )
+{
+  const unsigned char *bytes = data;
+#if defined( __x86_64__ ) || defined( _M_X64 )
+  unsigned long long crc64, word;
+
+  crc64 = crc;
+  while( length >= sizeof( word ) ){
+    memcpy( &word, bytes, sizeof( word ) );
+    crc64 = _mm_crc32_u64( crc64, word );
+    bytes += sizeof( word );
+    length -= sizeof( word );
+  }
+  crc = (unsigned) crc64;
+#else
+  unsigned word;
+
+  while( length >= sizeof( word ) ){
+    memcpy( &word, bytes, sizeof( word ) );
+    crc = _mm_crc32_u32( crc, word );
+    bytes += sizeof( word );
+    length -= sizeof( word );
+  }
+#endif
+
+  while( length > 0 ){
+    crc = _mm_crc32_u8( crc, *bytes );
+    bytes++;
+    length--;
+  }
+
+  return crc;
+}
+#endif
+
+#ifdef HASHER_X86_64
+HASHER_TARGET_SSE42
+unsigned long long *
+CRCSSE42DataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  const unsigned char *bytes[4];
+  unsigned long long crcs[4], words[4];
+  unsigned initial;
+  size_t i, j, offset, shortest;
+
+  initial = ~((unsigned) (seed ^ (seed >> 32)));
+
+  for( i = 0; i + 4 <= count; i += 4 ){
+    shortest = lengths[i];
+    for( j = 0; j < 4; j++ ){
+      bytes[j] = data[i+j];
+      crcs[j] = initial;
+      if( lengths[i+j] < shortest )
+        shortest = lengths[i+j];
+    }
+
+    // the common prefix of the four blocks is done in lockstep
+    for( offset = 0; offset + sizeof( words[0] ) <= shortest; offset += sizeof( words[0] ) ){
+      memcpy( &words[0], bytes[0] + offset, sizeof( words[0] ) );
+      memcpy( &words[1], bytes[1] + offset, sizeof( words[1] ) );
+      memcpy( &words[2], bytes[2] + offset, sizeof( words[2] ) );
+      memcpy( &words[3], bytes[3] + offset, sizeof( words[3] ) );
+      crcs[0] = _mm_crc32_u64( crcs[0], words[0] );
+      crcs[1] = _mm_crc32_u64( crcs[1], words[1] );
+      crcs[2] = _mm_crc32_u64( crcs[2], words[2] );
+      crcs[3] = _mm_crc32_u64( crcs[3], words[3] );
+    }
+
+    for( j = 0; j < 4; j++ ){
+      crcs[j] = CRCSSE42Update( bytes[j] + offset, lengths[i+j] - offset, (unsigned) crcs[j] );
+      hashes[i+j] = ~crcs[j] & 0xffffffffuLL;
+    }
+  }
+
+  for( ; i < count; i++ )
+    hashes[i] = ~CRCSSE42Update( data[i], lengths[i], initial ) & 0xffffffffuLL;
+
+  return hashes;
+}
+#endif
+
+#endif
+
+unsigned long long *
+HashBatchSerially
+( data_hasher_t hasher, const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  size_t i;
+
+  for( i = 0; i < count; i++ )
+    hashes[i] = hasher( data[i], lengths[i], seed );
+
+  return hashes;
+}
+
+unsigned long long *
+HashStringBatch
+( data_batch_hasher_t hasher, const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  size_t block, i, lengths[STRING_BATCH_SIZE];
+  unsigned long long *result = hashes;
+
+  while( count > 0 ){
+    block = count < STRING_BATCH_SIZE ? count : STRING_BATCH_SIZE;
+
+    for( i = 0; i < block; i++ )
+      lengths[i] = strlen( strs[i] );
+
+    hasher( strs, lengths, block, seed, hashes );
+
+    strs += block;
+    hashes += block;
+    count -= block;
+  }
+
+  return result;
+}
+
+unsigned
+HasherCPUFeatures
+( void )
+{
+  unsigned features = 0;
+
+#if defined( HASHER_X86 ) && defined( _MSC_VER )
+  int info[4];
+
+  __cpuid( info, 1 );
+  if( info[2] & (1 << 20) )
+    features |= HASHER_CPU_SSE42;
+
+  // AVX2 also needs the operating system to save the ymm registers
+  if( (info[2] & (1 << 27)) && (_xgetbv( 0 ) & 0x6) == 0x6 ){
+    __cpuidex( info, 7, 0 );
+    if( info[1] & (1 << 5) )
+      features |= HASHER_CPU_AVX2;
+  }
+#elif defined( HASHER_X86 )
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "sse4.2" ) )
+    features |= HASHER_CPU_SSE42;
+  if( __builtin_cpu_supports( "avx2" ) )
+    features |= HASHER_CPU_AVX2;
+#elif defined( HASHER_ARM ) && defined( __linux__ )
+  if( getauxval( AT_HWCAP ) & HWCAP_CRC32 )
+    features |= HASHER_CPU_ARM_CRC32;
+#elif defined( HASHER_ARM ) && defined( __APPLE__ )
+  features |= HASHER_CPU_ARM_CRC32;
+#endif
+
+  return features;
+}
+
+unsigned long long
+MixInteger
+( unsigned long long value, unsigned long long seed )
+{
+  value ^= seed;
+
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccduLL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53uLL;
+  value ^= value >> 33;
+
+  return value;
+}
+
+unsigned long long
+MixedPointerHash
+( const void *pointer, unsigned long long seed )
+{
+  return MixInteger( (unsigned long long) (uintptr_t) pointer, seed );
+}
+
+unsigned long long *
+MixedPointerHashBatch
+( const void * const *pointers, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  size_t i;
+
+  for( i = 0; i < count; i++ )
+    hashes[i] = MixedPointerHash( pointers[i], seed );
+
+  return hashes;
+}
+
 unsigned long long
 ModFold
 ( unsigned long long hash, unsigned long long max )
@@ -35,17 +511,158 @@ PointerHash
   return (unsigned long long) pointer;
 }
 
+unsigned long long *
+PointerHashBatch
+( const void * const *pointers, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  size_t i;
+
+  for( i = 0; i < count; i++ )
+    hashes[i] = PointerHash( pointers[i], seed );
+
+  return hashes;
+}
+
 #ifdef __WOODPILE_SPOOKY_HASHER
 
 #include <limits.h>
 
+/**
+ * Picks the fastest Spooky batch implementation supported by the processor
+ * and installs it as the one used by SpookyDataHashBatch, then uses it to hash
+ * the batch. This is only called the first time a Spooky batch is hashed.
+ */
+static
+unsigned long long *
+SpookyResolveDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+/**
+ * Hashes a batch of blocks one at a time with SpookyDataHash.
+ */
+static
+unsigned long long *
+SpookySerialDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes );
+
+// replaced with the best available implementation on the first call
+static HASHER_DISPATCH( data_batch_hasher_t ) spooky_data_hash_batch = SpookyResolveDataHashBatch;
+
+#ifdef HASHER_X86
+
+// one step of SpookyMix applied to four states at once
+#define SPOOKY_AVX2_STEP( i, bits )                                            \
+state[i] = _mm256_add_epi64( state[i], chunk[i] );                             \
+state[(i+2)%12] = _mm256_xor_si256( state[(i+2)%12], state[(i+10)%12] );       \
+state[(i+11)%12] = _mm256_xor_si256( state[(i+11)%12], state[i] );             \
+state[i] = _mm256_or_si256( _mm256_slli_epi64( state[i], bits ),               \
+                            _mm256_srli_epi64( state[i], 64 - bits ) );        \
+state[(i+11)%12] = _mm256_add_epi64( state[(i+11)%12], state[(i+1)%12] );
+
+HASHER_TARGET_AVX2
+unsigned long long *
+SpookyAVX2DataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  static const unsigned long long zeros[12] = { 0 };
+  unsigned long long buffers[4][12];
+  const unsigned long long *lanes[4];
+  size_t chunk_counts[4], i, j, k, most_chunks, offset;
+  __m256i active, chunk[12], previous[12], result, rows[4], state[12], t[4];
+  int all_active;
+
+  for( i = 0; i + 4 <= count; i += 4 ){
+    most_chunks = 0;
+    for( j = 0; j < 4; j++ ){
+      chunk_counts[j] = (lengths[i+j] + SPOOKY_CHUNK_SIZE - 1) / SPOOKY_CHUNK_SIZE;
+      if( chunk_counts[j] > most_chunks )
+        most_chunks = chunk_counts[j];
+    }
+
+    for( k = 0; k < 12; k += 2 ){
+      state[k] = _mm256_set1_epi64x( (long long) 0xdeadbeefdeadbeefuLL );
+      state[k+1] = _mm256_set1_epi64x( (long long) seed );
+    }
+
+    for( offset = 0; offset < most_chunks; offset++ ){
+      all_active = 1;
+      for( j = 0; j < 4; j++ ){
+        if( offset >= chunk_counts[j] ){
+          lanes[j] = zeros;
+          all_active = 0;
+        } else if( lengths[i+j] - offset * SPOOKY_CHUNK_SIZE >= SPOOKY_CHUNK_SIZE ){
+          lanes[j] = (const unsigned long long *) (((const char *) data[i+j]) + offset * SPOOKY_CHUNK_SIZE);
+        } else {
+          memcpy( buffers[j], ((const char *) data[i+j]) + offset * SPOOKY_CHUNK_SIZE, lengths[i+j] - offset * SPOOKY_CHUNK_SIZE );
+          memset( ((char *) buffers[j]) + lengths[i+j] - offset * SPOOKY_CHUNK_SIZE, 0, SPOOKY_CHUNK_SIZE - (lengths[i+j] - offset * SPOOKY_CHUNK_SIZE) );
+          lanes[j] = buffers[j];
+        }
+      }
+
+      // transpose the chunks so that each vector holds one word of each
+      for( k = 0; k < 12; k += 4 ){
+        for( j = 0; j < 4; j++ )
+          rows[j] = _mm256_loadu_si256( (const __m256i *) (lanes[j] + k) );
+
+        t[0] = _mm256_unpacklo_epi64( rows[0], rows[1] );
+        t[1] = _mm256_unpackhi_epi64( rows[0], rows[1] );
+        t[2] = _mm256_unpacklo_epi64( rows[2], rows[3] );
+        t[3] = _mm256_unpackhi_epi64( rows[2], rows[3] );
+        chunk[k] = _mm256_permute2x128_si256( t[0], t[2], 0x20 );
+        chunk[k+1] = _mm256_permute2x128_si256( t[1], t[3], 0x20 );
+        chunk[k+2] = _mm256_permute2x128_si256( t[0], t[2], 0x31 );
+        chunk[k+3] = _mm256_permute2x128_si256( t[1], t[3], 0x31 );
+      }
+
+      if( !all_active )
+        for( k = 0; k < 12; k++ )
+          previous[k] = state[k];
+
+      SPOOKY_AVX2_STEP( 0, 11 )
+      SPOOKY_AVX2_STEP( 1, 32 )
+      SPOOKY_AVX2_STEP( 2, 43 )
+      SPOOKY_AVX2_STEP( 3, 31 )
+      SPOOKY_AVX2_STEP( 4, 17 )
+      SPOOKY_AVX2_STEP( 5, 28 )
+      SPOOKY_AVX2_STEP( 6, 39 )
+      SPOOKY_AVX2_STEP( 7, 57 )
+      SPOOKY_AVX2_STEP( 8, 55 )
+      SPOOKY_AVX2_STEP( 9, 54 )
+      SPOOKY_AVX2_STEP( 10, 22 )
+      SPOOKY_AVX2_STEP( 11, 46 )
+
+      // lanes that have run out of chunks keep their previous state
+      if( !all_active ){
+        active = _mm256_set_epi64x( offset < chunk_counts[3] ? -1 : 0,
+                                    offset < chunk_counts[2] ? -1 : 0,
+                                    offset < chunk_counts[1] ? -1 : 0,
+                                    offset < chunk_counts[0] ? -1 : 0 );
+        for( k = 0; k < 12; k++ )
+          state[k] = _mm256_blendv_epi8( previous[k], state[k], active );
+      }
+    }
+
+    result = state[0];
+    for( k = 1; k < 12; k++ )
+      result = _mm256_xor_si256( result, state[k] );
+
+    _mm256_storeu_si256( (__m256i *) (hashes + i), result );
+  }
+
+  for( ; i < count; i++ )
+    hashes[i] = SpookyDataHash( data[i], lengths[i], seed );
+
+  return hashes;
+}
+
+#endif
+
 unsigned long long
 SpookyDataHash
 ( const void *data, size_t length, unsigned long long seed )
 {
   unsigned long long state[12];
   unsigned long long buffer[12];
-  size_t remainder;
 
   // initialize state
   state[0] = state[2] = state[4] = state[6] = state[8] = state[10] = 0xdeadbeefdeadbeefuLL;
@@ -61,7 +678,7 @@ SpookyDataHash
   // deal with the remainder
   if( length > 0 ){
     memcpy( buffer, data, length );
-    memset( buffer+length, 0, SPOOKY_CHUNK_SIZE-length );
+    memset( ((char *) buffer) + length, 0, SPOOKY_CHUNK_SIZE-length );
     SpookyMix( buffer, state );
   }
 
@@ -70,6 +687,49 @@ SpookyDataHash
        ^ state[6] ^ state[7] ^ state[8] ^ state[9] ^ state[10] ^ state[11];
 }
 
+hash128_t
+SpookyDataHash128
+( const void *data, size_t length, unsigned long long seed )
+{
+  unsigned long long state[12];
+  unsigned long long buffer[12];
+  hash128_t result;
+  size_t remaining;
+
+  state[0] = state[2] = state[4] = state[6] = state[8] = state[10] = 0xdeadbeefdeadbeefuLL;
+  state[1] = state[3] = state[5] = state[7] = state[9] = state[11] = seed;
+
+  remaining = length;
+  while( remaining >= SPOOKY_CHUNK_SIZE ){
+    SpookyMix( data, state );
+    data = ((( char * ) data ) + SPOOKY_CHUNK_SIZE );
+    remaining -= SPOOKY_CHUNK_SIZE;
+  }
+
+  if( remaining > 0 ){
+    memcpy( buffer, data, remaining );
+    memset( ((char *) buffer) + remaining, 0, SPOOKY_CHUNK_SIZE-remaining );
+    SpookyMix( buffer, state );
+  }
+
+  // the length chunk tells trailing zeros apart from padding
+  memset( buffer, 0, SPOOKY_CHUNK_SIZE );
+  buffer[0] = (unsigned long long) length;
+  SpookyMix( buffer, state );
+
+  result.low = state[0] ^ state[2] ^ state[4] ^ state[6] ^ state[8] ^ state[10];
+  result.high = state[1] ^ state[3] ^ state[5] ^ state[7] ^ state[9] ^ state[11];
+
+  return result;
+}
+
+unsigned long long *
+SpookyDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HASHER_DISPATCH_LOAD( spooky_data_hash_batch )( data, lengths, count, seed, hashes );
+}
+
 unsigned long long
 SpookyHash
 ( const void *str, unsigned long long seed )
@@ -77,6 +737,89 @@ SpookyHash
   return SpookyDataHash( str, strlen( str ), seed );
 }
 
+hash128_t
+SpookyHash128
+( const void *str, unsigned long long seed )
+{
+  return SpookyDataHash128( str, strlen( str ), seed );
+}
+
+unsigned long long *
+SpookyHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashStringBatch( SpookyDataHashBatch, strs, count, seed, hashes );
+}
+
+unsigned long long
+SpookyHashFinal
+( const spooky_state_t *state )
+{
+  unsigned long long buffer[12], final_state[12];
+
+  memcpy( final_state, state->state, sizeof( final_state ) );
+
+  // the remainder is padded and mixed just like in SpookyDataHash
+  if( state->buffered > 0 ){
+    memcpy( buffer, state->buffer, state->buffered );
+    memset( ((char *) buffer) + state->buffered, 0, SPOOKY_CHUNK_SIZE - state->buffered );
+    SpookyMix( buffer, final_state );
+  }
+
+  return final_state[0] ^ final_state[1] ^ final_state[2] ^ final_state[3]
+       ^ final_state[4] ^ final_state[5] ^ final_state[6] ^ final_state[7]
+       ^ final_state[8] ^ final_state[9] ^ final_state[10] ^ final_state[11];
+}
+
+spooky_state_t *
+SpookyHashInit
+( spooky_state_t *state, unsigned long long seed )
+{
+  state->state[0] = state->state[2] = state->state[4] = 0xdeadbeefdeadbeefuLL;
+  state->state[6] = state->state[8] = state->state[10] = 0xdeadbeefdeadbeefuLL;
+  state->state[1] = state->state[3] = state->state[5] = seed;
+  state->state[7] = state->state[9] = state->state[11] = seed;
+  state->buffered = 0;
+
+  return state;
+}
+
+spooky_state_t *
+SpookyHashUpdate
+( spooky_state_t *state, const void *data, size_t length )
+{
+  size_t needed;
+
+  // top off a partially filled chunk first
+  if( state->buffered > 0 ){
+    needed = SPOOKY_CHUNK_SIZE - state->buffered;
+    if( length < needed ){
+      memcpy( ((char *) state->buffer) + state->buffered, data, length );
+      state->buffered += length;
+      return state;
+    }
+
+    memcpy( ((char *) state->buffer) + state->buffered, data, needed );
+    SpookyMix( state->buffer, state->state );
+    state->buffered = 0;
+    data = ((( char * ) data ) + needed );
+    length -= needed;
+  }
+
+  while( length >= SPOOKY_CHUNK_SIZE ){
+    SpookyMix( data, state->state );
+    data = ((( char * ) data ) + SPOOKY_CHUNK_SIZE );
+    length -= SPOOKY_CHUNK_SIZE;
+  }
+
+  if( length > 0 ){
+    memcpy( state->buffer, data, length );
+    state->buffered = length;
+  }
+
+  return state;
+}
+
 unsigned long long
 SpookyLeftRotate
 ( unsigned long long value, size_t bits )
@@ -84,6 +827,31 @@ SpookyLeftRotate
   return (value << bits) | (value >> ((sizeof( unsigned long long ) * CHAR_BIT) - bits));
 }
 
+static
+unsigned long long *
+SpookyResolveDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  data_batch_hasher_t batch_hasher = SpookySerialDataHashBatch;
+
+#ifdef HASHER_X86
+  if( HasherCPUFeatures() & HASHER_CPU_AVX2 )
+    batch_hasher = SpookyAVX2DataHashBatch;
+#endif
+
+  HASHER_DISPATCH_STORE( spooky_data_hash_batch, batch_hasher );
+
+  return batch_hasher( data, lengths, count, seed, hashes );
+}
+
+static
+unsigned long long *
+SpookySerialDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashBatchSerially( SpookyDataHash, data, lengths, count, seed, hashes );
+}
+
 void
 SpookyMix
 ( const unsigned long long *chunk, unsigned long long *state )
@@ -169,7 +937,70 @@ unsigned long long
 WoodpileDataHash
 ( const void *data, size_t length, unsigned long long seed )
 {
-  return 0;
+  size_t i;
+  const char *data_cast;
+  unsigned long long sum=0;
+
+  data_cast = data;
+  for( i=0; i < length; i++ ){
+    sum += data_cast[i];
+  }
+
+  return sum ^ seed;
+}
+
+hash128_t
+WoodpileDataHash128
+( const void *data, size_t length, unsigned long long seed )
+{
+  size_t i, j;
+  const unsigned char *bytes;
+  unsigned long long high = seed, k1, k2, low = seed;
+  hash128_t result;
+
+  // the block and tail rounds are those of the x64 128-bit MurmurHash3
+  bytes = data;
+  for( i = 0; i + 16 <= length; i += 16 ){
+    memcpy( &k1, bytes + i, sizeof( k1 ) );
+    memcpy( &k2, bytes + i + 8, sizeof( k2 ) );
+
+    low ^= WoodpileLeftRotate( k1 * WOODPILE_C1, 31 ) * WOODPILE_C2;
+    low = ( WoodpileLeftRotate( low, 27 ) + high ) * 5 + 0x52dce729uLL;
+
+    high ^= WoodpileLeftRotate( k2 * WOODPILE_C2, 33 ) * WOODPILE_C1;
+    high = ( WoodpileLeftRotate( high, 31 ) + low ) * 5 + 0x38495ab5uLL;
+  }
+
+  k1 = k2 = 0;
+  for( j = 0; i + j < length; j++ )
+    if( j < 8 )
+      k1 |= (unsigned long long) bytes[i+j] << ( 8 * j );
+    else
+      k2 |= (unsigned long long) bytes[i+j] << ( 8 * ( j - 8 ) );
+
+  if( j > 8 )
+    high ^= WoodpileLeftRotate( k2 * WOODPILE_C2, 33 ) * WOODPILE_C1;
+  if( j > 0 )
+    low ^= WoodpileLeftRotate( k1 * WOODPILE_C1, 31 ) * WOODPILE_C2;
+
+  low ^= (unsigned long long) length;
+  high ^= (unsigned long long) length;
+  low += high;
+  high += low;
+
+  low = MixInteger( low, 0 );
+  high = MixInteger( high, 0 );
+  result.low = low + high;
+  result.high = high + result.low;
+
+  return result;
+}
+
+unsigned long long *
+WoodpileDataHashBatch
+( const void * const *data, const size_t *lengths, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashBatchSerially( WoodpileDataHash, data, lengths, count, seed, hashes );
 }
 
 unsigned long long
@@ -188,6 +1019,59 @@ WoodpileHash
   return ((unsigned long long) sum) ^ ((unsigned long long) seed);
 }
 
+hash128_t
+WoodpileHash128
+( const void *str, unsigned long long seed )
+{
+  return WoodpileDataHash128( str, strlen( str ), seed );
+}
+
+unsigned long long *
+WoodpileHashBatch
+( const void * const *strs, size_t count, unsigned long long seed, unsigned long long *hashes )
+{
+  return HashStringBatch( WoodpileDataHashBatch, strs, count, seed, hashes );
+}
+
+unsigned long long
+WoodpileHashFinal
+( const woodpile_state_t *state )
+{
+  return state->sum ^ state->seed;
+}
+
+woodpile_state_t *
+WoodpileHashInit
+( woodpile_state_t *state, unsigned long long seed )
+{
+  state->seed = seed;
+  state->sum = 0;
+
+  return state;
+}
+
+woodpile_state_t *
+WoodpileHashUpdate
+( woodpile_state_t *state, const void *data, size_t length )
+{
+  size_t i;
+  const char *data_cast;
+
+  data_cast = data;
+  for( i=0; i < length; i++ ){
+    state->sum += data_cast[i];
+  }
+
+  return state;
+}
+
+unsigned long long
+WoodpileLeftRotate
+( unsigned long long value, size_t bits )
+{
+  return (value << bits) | (value >> ((sizeof( unsigned long long ) * CHAR_BIT) - bits));
+}
+
 #endif
 
 unsigned long long
@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/blockingqueue.h>
+#include <woodpile/static/queue.h>
+#include "lib/validate.h"
+#include "private/static/blockingqueue.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+size_t
+SBlockingQueueCapacity
+( const sblockingqueue_t *queue )
+{
+  if( !queue )
+    return 0;
+
+  return queue->capacity;
+}
+
+sblockingqueue_t *
+SBlockingQueueClose
+( sblockingqueue_t *queue )
+{
+  VALIDATE_PARAMETERS( queue )
+
+  SBLOCKINGQUEUE_LOCK( queue )
+  queue->closed = 1;
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  pthread_cond_broadcast( &queue->not_empty );
+  pthread_cond_broadcast( &queue->not_full );
+#endif
+  SBLOCKINGQUEUE_UNLOCK( queue )
+
+  return queue;
+}
+
+void
+SBlockingQueueDestroy
+( sblockingqueue_t *queue )
+{
+  if( queue ){
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+    pthread_cond_destroy( &queue->not_full );
+    pthread_cond_destroy( &queue->not_empty );
+    pthread_mutex_destroy( &queue->lock );
+#endif
+    SQueueDestroy( queue->elements );
+    free( queue );
+  }
+
+  return;
+}
+
+unsigned short
+SBlockingQueueIsEmpty
+( sblockingqueue_t *queue )
+{
+  return SBlockingQueueSize( queue ) == 0;
+}
+
+sblockingqueue_t *
+SBlockingQueueNew
+( size_t capacity )
+{
+  sblockingqueue_t *queue;
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  pthread_condattr_t attributes;
+  int result;
+#endif
+
+  VALIDATE_PARAMETERS( capacity > 0 )
+
+  queue = malloc( sizeof( sblockingqueue_t ) );
+  VALIDATE_ALLOCATION( queue )
+
+  // the SQueue is made big enough up front, so that it never grows
+  queue->elements = SQueueNewSized( capacity );
+  VALIDATE_ALLOCATION_AND_FREE( queue->elements, queue )
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  if( pthread_mutex_init( &queue->lock, NULL ) != 0 ){
+    SQueueDestroy( queue->elements );
+    free( queue );
+    return NULL;
+  }
+
+  if( pthread_condattr_init( &attributes ) != 0 ){
+    pthread_mutex_destroy( &queue->lock );
+    SQueueDestroy( queue->elements );
+    free( queue );
+    return NULL;
+  }
+
+  // timeouts are measured on a clock that setting the system time can't move
+#ifdef __WOODPILE_HAVE_PTHREAD_CONDATTR_SETCLOCK
+  result = pthread_condattr_setclock( &attributes, CLOCK_MONOTONIC );
+#else
+  result = 0;
+#endif
+  if( result == 0 && pthread_cond_init( &queue->not_empty, &attributes ) != 0 )
+    result = -1;
+  if( result == 0 && pthread_cond_init( &queue->not_full, &attributes ) != 0 ){
+    pthread_cond_destroy( &queue->not_empty );
+    result = -1;
+  }
+
+  pthread_condattr_destroy( &attributes );
+  if( result != 0 ){
+    pthread_mutex_destroy( &queue->lock );
+    SQueueDestroy( queue->elements );
+    free( queue );
+    return NULL;
+  }
+#endif
+
+  queue->capacity = capacity;
+  queue->closed = 0;
+  queue->waiting_consumers = 0;
+  queue->waiting_producers = 0;
+
+  return queue;
+}
+
+void *
+SBlockingQueuePop
+( sblockingqueue_t *queue, long timeout )
+{
+  void *element;
+
+  VALIDATE_PARAMETERS( queue )
+
+  if( SBlockingQueuePopBatch( queue, &element, 1, timeout ) == 0 )
+    return NULL;
+
+  return element;
+}
+
+size_t
+SBlockingQueuePopBatch
+( sblockingqueue_t *queue, void **out, size_t max, long timeout )
+{
+  size_t count;
+  struct timespec deadline;
+
+  if( !queue || !out || max == 0 )
+    return 0;
+
+  if( timeout > 0 )
+    SBlockingQueueDeadline( timeout, &deadline );
+
+  SBLOCKINGQUEUE_LOCK( queue )
+
+  while( SQueueIsEmpty( queue->elements ) && !queue->closed )
+    if( !SBlockingQueueWait( queue, 0, timeout, &deadline ) )
+      break;
+
+  count = SQueuePopN( queue->elements, out, max );
+
+  // one wakeup covers the batch: each woken producer has a slot waiting
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  if( count > 0 && queue->waiting_producers > 0 ){
+    if( count == 1 )
+      pthread_cond_signal( &queue->not_full );
+    else
+      pthread_cond_broadcast( &queue->not_full );
+  }
+#endif
+
+  SBLOCKINGQUEUE_UNLOCK( queue )
+
+  return count;
+}
+
+sblockingqueue_t *
+SBlockingQueuePush
+( sblockingqueue_t *queue, void *element, long timeout )
+{
+  struct timespec deadline;
+  sblockingqueue_t *result = NULL;
+
+  VALIDATE_PARAMETERS( queue && element )
+
+  if( timeout > 0 )
+    SBlockingQueueDeadline( timeout, &deadline );
+
+  SBLOCKINGQUEUE_LOCK( queue )
+
+  while( SQueueSize( queue->elements ) == queue->capacity && !queue->closed )
+    if( !SBlockingQueueWait( queue, 1, timeout, &deadline ) )
+      break;
+
+  if( !queue->closed && SQueueSize( queue->elements ) < queue->capacity
+      && SQueuePush( queue->elements, element ) ){
+    result = queue;
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+    if( queue->waiting_consumers > 0 )
+      pthread_cond_signal( &queue->not_empty );
+#endif
+  }
+
+  SBLOCKINGQUEUE_UNLOCK( queue )
+
+  return result;
+}
+
+size_t
+SBlockingQueueSize
+( sblockingqueue_t *queue )
+{
+  size_t size;
+
+  if( !queue )
+    return 0;
+
+  SBLOCKINGQUEUE_LOCK( queue )
+  size = SQueueSize( queue->elements );
+  SBLOCKINGQUEUE_UNLOCK( queue )
+
+  return size;
+}
+
+static
+void
+SBlockingQueueDeadline
+( long timeout, struct timespec *deadline )
+{
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+#ifdef __WOODPILE_HAVE_PTHREAD_CONDATTR_SETCLOCK
+  clock_gettime( CLOCK_MONOTONIC, deadline );
+#else
+  // without a choice of clock, condition variables time out on the realtime one
+  clock_gettime( CLOCK_REALTIME, deadline );
+#endif
+
+  deadline->tv_sec += timeout / 1000;
+  deadline->tv_nsec += ( timeout % 1000 ) * 1000000L;
+  if( deadline->tv_nsec >= 1000000000L ){
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+#else
+  // without threads nothing can change while waiting, so there is no deadline
+  deadline->tv_sec = 0;
+  deadline->tv_nsec = 0;
+#endif
+}
+
+static
+unsigned short
+SBlockingQueueWait
+( sblockingqueue_t *queue, unsigned short for_room, long timeout, const struct timespec *deadline )
+{
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  pthread_cond_t *condition = for_room ? &queue->not_full : &queue->not_empty;
+  size_t *waiting = for_room ? &queue->waiting_producers : &queue->waiting_consumers;
+  int result = 0;
+
+  if( timeout == 0 )
+    return 0;
+
+  ( *waiting )++;
+  if( timeout < 0 )
+    pthread_cond_wait( condition, &queue->lock );
+  else
+    result = pthread_cond_timedwait( condition, &queue->lock, deadline );
+  ( *waiting )--;
+
+  return result == 0;
+#else
+  return 0;
+#endif
+}
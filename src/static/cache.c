@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/cache.h>
+#include <woodpile/static/hash.h>
+#include "lib/validate.h"
+#include "private/static/cache.h"
+
+size_t
+SCacheCapacity
+( const scache_t *cache )
+{
+  if( !cache )
+    return 0;
+
+  return cache->capacity;
+}
+
+void
+SCacheDestroy
+( const scache_t *cache )
+{
+  size_t i;
+
+  if( cache ){
+    if( cache->evict )
+      for( i = cache->oldest; i != SCACHE_NONE; i = cache->entries[i].newer )
+        cache->evict( cache->entries[i].key, cache->entries[i].value, cache->context );
+
+    SHashDestroy( cache->index );
+    free( cache->entries );
+    free( (void *) cache );
+  }
+
+  return;
+}
+
+void *
+SCacheGet
+( scache_t *cache, const void *key )
+{
+  size_t i;
+  struct scache_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashGet( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  i = (size_t) ( entry - cache->entries );
+  if( i != cache->newest ){
+    SCacheUnlink( cache, i );
+    SCacheLink( cache, i );
+  }
+
+  return entry->value;
+}
+
+unsigned short
+SCacheIsEmpty
+( const scache_t *cache )
+{
+  return cache == NULL || cache->size == 0;
+}
+
+scache_t *
+SCacheNew
+( size_t capacity )
+{
+  scache_t *cache;
+  size_t i;
+
+  VALIDATE_PARAMETERS( capacity > 0 )
+
+  cache = malloc( sizeof( scache_t ) );
+  VALIDATE_ALLOCATION( cache )
+
+  cache->entries = malloc( capacity * sizeof( struct scache_entry_t ) );
+  VALIDATE_ALLOCATION_AND_FREE( cache->entries, cache )
+
+  // the index is kept at most half full so that probes stay short
+  cache->index = SHashNewSized( capacity * 2 );
+  if( !cache->index || !SHashSetFolder( cache->index, ModFold ) ){
+    SHashDestroy( cache->index );
+    free( cache->entries );
+    free( cache );
+    return NULL;
+  }
+
+  for( i = 0; i < capacity; i++ )
+    cache->entries[i].older = i + 1 < capacity ? i + 1 : SCACHE_NONE;
+
+  cache->capacity = capacity;
+  cache->context = NULL;
+  cache->evict = NULL;
+  cache->free = 0;
+  cache->newest = cache->oldest = SCACHE_NONE;
+  cache->size = 0;
+
+  return cache;
+}
+
+void *
+SCacheOldest
+( const scache_t *cache )
+{
+  VALIDATE_PARAMETERS( cache )
+
+  if( cache->oldest == SCACHE_NONE )
+    return NULL;
+
+  return cache->entries[cache->oldest].key;
+}
+
+void *
+SCachePeek
+( const scache_t *cache, const void *key )
+{
+  struct scache_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashGet( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  return entry->value;
+}
+
+void *
+SCachePut
+( scache_t *cache, void *key, void *value )
+{
+  size_t i;
+  struct scache_entry_t *entry;
+  void *result;
+
+  if( !value )
+    return SCacheRemove( cache, key );
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashGet( cache->index, key );
+  if( entry ){
+    i = (size_t) ( entry - cache->entries );
+    result = entry->value;
+    entry->key = key;
+    entry->value = value;
+
+    // the index keeps the key it was given, which may be an equal copy
+    SHashPut( cache->index, key, entry );
+
+    if( i != cache->newest ){
+      SCacheUnlink( cache, i );
+      SCacheLink( cache, i );
+    }
+
+    return result;
+  }
+
+  if( cache->free == SCACHE_NONE ){
+    i = cache->oldest;
+    SCacheUnlink( cache, i );
+    SHashRemove( cache->index, cache->entries[i].key );
+    cache->size--;
+
+    if( cache->evict )
+      cache->evict( cache->entries[i].key, cache->entries[i].value, cache->context );
+  } else {
+    i = cache->free;
+    cache->free = cache->entries[i].older;
+  }
+
+  cache->entries[i].key = key;
+  cache->entries[i].value = value;
+  if( !SHashPut( cache->index, key, &cache->entries[i] ) ){
+    cache->entries[i].older = cache->free;
+    cache->free = i;
+    return NULL;
+  }
+
+  SCacheLink( cache, i );
+  cache->size++;
+
+  return value;
+}
+
+void *
+SCacheRemove
+( scache_t *cache, const void *key )
+{
+  size_t i;
+  struct scache_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashRemove( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  i = (size_t) ( entry - cache->entries );
+  SCacheUnlink( cache, i );
+  entry->older = cache->free;
+  cache->free = i;
+  cache->size--;
+
+  return entry->value;
+}
+
+scache_t *
+SCacheSetEvictor
+( scache_t *cache, void ( *evict )( void *, void *, void * ), void *context )
+{
+  VALIDATE_PARAMETERS( cache )
+
+  cache->context = context;
+  cache->evict = evict;
+
+  return cache;
+}
+
+scache_t *
+SCacheSetHasher
+( scache_t *cache, hasher_t hasher )
+{
+  VALIDATE_PARAMETERS( cache && hasher )
+
+  if( !SHashSetHasher( cache->index, hasher ) )
+    return NULL;
+
+  return cache;
+}
+
+scache_t *
+SCacheSetKeyComparator
+( scache_t *cache, comparator_t comparator )
+{
+  VALIDATE_PARAMETERS( cache && comparator )
+
+  if( !SHashSetKeyComparator( cache->index, comparator ) )
+    return NULL;
+
+  return cache;
+}
+
+size_t
+SCacheSize
+( const scache_t *cache )
+{
+  if( !cache )
+    return 0;
+
+  return cache->size;
+}
+
+static
+void
+SCacheLink
+( scache_t *cache, size_t entry )
+{
+  cache->entries[entry].newer = SCACHE_NONE;
+  cache->entries[entry].older = cache->newest;
+
+  if( cache->newest == SCACHE_NONE )
+    cache->oldest = entry;
+  else
+    cache->entries[cache->newest].newer = entry;
+
+  cache->newest = entry;
+}
+
+static
+void
+SCacheUnlink
+( scache_t *cache, size_t entry )
+{
+  size_t newer = cache->entries[entry].newer, older = cache->entries[entry].older;
+
+  if( newer == SCACHE_NONE )
+    cache->newest = older;
+  else
+    cache->entries[newer].older = older;
+
+  if( older == SCACHE_NONE )
+    cache->oldest = newer;
+  else
+    cache->entries[older].newer = newer;
+}
@@ -0,0 +1,198 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <woodpile/static/deque.h>
+#include "lib/validate.h"
+#include "private/static/deque.h"
+
+size_t
+SDequeCapacity
+( const sdeque_t *deque )
+{
+  if( !deque )
+    return 0;
+
+  return deque->capacity;
+}
+
+void
+SDequeDestroy
+( const sdeque_t *deque )
+{
+  if( deque ){
+    free( deque->elements );
+    free( (void *) deque );
+  }
+
+  return;
+}
+
+void *
+SDequeGet
+( const sdeque_t *deque, size_t index )
+{
+  VALIDATE_PARAMETERS( deque )
+
+  if( index >= deque->back - deque->front )
+    return NULL;
+
+  return deque->elements[( deque->front + index ) & ( deque->capacity - 1 )];
+}
+
+unsigned short
+SDequeIsEmpty
+( const sdeque_t *deque )
+{
+  return deque == NULL || deque->front == deque->back;
+}
+
+sdeque_t *
+SDequeNew
+( size_t capacity )
+{
+  size_t rounded = 1;
+  sdeque_t *deque;
+
+  VALIDATE_PARAMETERS( capacity <= SIZE_MAX / 2 + 1 )
+
+  while( rounded < capacity )
+    rounded <<= 1;
+
+  deque = malloc( sizeof( sdeque_t ) );
+  VALIDATE_ALLOCATION( deque )
+
+  deque->elements = malloc( sizeof( void * ) * rounded );
+  VALIDATE_ALLOCATION_AND_FREE( deque->elements, deque )
+
+  deque->back = deque->front = 0;
+  deque->capacity = rounded;
+
+  return deque;
+}
+
+void *
+SDequePeekBack
+( const sdeque_t *deque )
+{
+  if( SDequeIsEmpty( deque ) )
+    return NULL;
+
+  return deque->elements[( deque->back - 1 ) & ( deque->capacity - 1 )];
+}
+
+void *
+SDequePeekFront
+( const sdeque_t *deque )
+{
+  if( SDequeIsEmpty( deque ) )
+    return NULL;
+
+  return deque->elements[deque->front & ( deque->capacity - 1 )];
+}
+
+void *
+SDequePopBack
+( sdeque_t *deque )
+{
+  VALIDATE_PARAMETERS( deque )
+
+  if( deque->front == deque->back )
+    return NULL;
+
+  return deque->elements[--deque->back & ( deque->capacity - 1 )];
+}
+
+void *
+SDequePopFront
+( sdeque_t *deque )
+{
+  VALIDATE_PARAMETERS( deque )
+
+  if( deque->front == deque->back )
+    return NULL;
+
+  return deque->elements[deque->front++ & ( deque->capacity - 1 )];
+}
+
+sdeque_t *
+SDequePushBack
+( sdeque_t *deque, void *element )
+{
+  VALIDATE_PARAMETERS( deque && element )
+
+  if( deque->back - deque->front == deque->capacity )
+    if( !SDequeGrow( deque ) )
+      return NULL;
+
+  deque->elements[deque->back++ & ( deque->capacity - 1 )] = element;
+
+  return deque;
+}
+
+sdeque_t *
+SDequePushFront
+( sdeque_t *deque, void *element )
+{
+  VALIDATE_PARAMETERS( deque && element )
+
+  if( deque->back - deque->front == deque->capacity )
+    if( !SDequeGrow( deque ) )
+      return NULL;
+
+  deque->elements[--deque->front & ( deque->capacity - 1 )] = element;
+
+  return deque;
+}
+
+void *
+SDequeSet
+( sdeque_t *deque, size_t index, void *element )
+{
+  void **slot;
+  void *previous;
+
+  VALIDATE_PARAMETERS( deque && element && index < deque->back - deque->front )
+
+  slot = &deque->elements[( deque->front + index ) & ( deque->capacity - 1 )];
+  previous = *slot;
+  *slot = element;
+
+  return previous;
+}
+
+size_t
+SDequeSize
+( const sdeque_t *deque )
+{
+  if( !deque )
+    return 0;
+
+  return deque->back - deque->front;
+}
+
+static
+sdeque_t *
+SDequeGrow
+( sdeque_t *deque )
+{
+  size_t first, start;
+  void **elements;
+
+  elements = malloc( sizeof( void * ) * deque->capacity * 2 );
+  VALIDATE_ALLOCATION( elements )
+
+  // a full ring runs from start to the end of the array, then wraps to start
+  start = deque->front & ( deque->capacity - 1 );
+  first = deque->capacity - start;
+
+  memcpy( elements, deque->elements + start, sizeof( void * ) * first );
+  memcpy( elements + first, deque->elements, sizeof( void * ) * start );
+
+  free( deque->elements );
+  deque->back = deque->capacity;
+  deque->capacity *= 2;
+  deque->elements = elements;
+  deque->front = 0;
+
+  return deque;
+}
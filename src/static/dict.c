@@ -0,0 +1,316 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/dict.h>
+#include "lib/validate.h"
+#include "private/static/dict.h"
+
+size_t
+SDictCapacity
+( const sdict_t *dict )
+{
+  if( !dict )
+    return 0;
+
+  return dict->capacity;
+}
+
+void
+SDictDestroy
+( const sdict_t *dict )
+{
+  if( dict ){
+    free( dict->entries );
+    free( dict->indices );
+    free( (void *) dict );
+  }
+
+  return;
+}
+
+sdict_t *
+SDictForEach
+( sdict_t *dict, void ( *action )( void *, void *, void * ), void *context )
+{
+  size_t i;
+
+  VALIDATE_PARAMETERS( dict && action )
+
+  for( i = 0; i < dict->next; i++ )
+    if( dict->entries[i].key )
+      action( dict->entries[i].key, dict->entries[i].value, context );
+
+  return dict;
+}
+
+void *
+SDictGet
+( const sdict_t *dict, const void *key )
+{
+  size_t entry;
+
+  VALIDATE_PARAMETERS( dict && key )
+
+  entry = SDictGetSlot( dict, SDictFindSlot( dict, key, dict->hash( key, dict->seed ) ) );
+  if( !entry )
+    return NULL;
+
+  return dict->entries[entry-1].value;
+}
+
+unsigned short
+SDictIsEmpty
+( const sdict_t *dict )
+{
+  return dict == NULL || dict->size == 0;
+}
+
+sdict_t *
+SDictNew
+( void )
+{
+  return SDictNewSized( 256 );
+}
+
+sdict_t *
+SDictNewSized
+( size_t capacity )
+{
+  sdict_t *dict;
+
+  VALIDATE_PARAMETERS( capacity > 0 && capacity <= SDICT_MAX_CAPACITY )
+
+  dict = malloc( sizeof( sdict_t ) );
+  VALIDATE_ALLOCATION( dict )
+
+  dict->capacity = 0;
+  dict->compare_keys = ComparePointers;
+  dict->entries = NULL;
+  dict->hash = MixedPointerHash;
+  dict->indices = NULL;
+  dict->next = 0;
+  dict->seed = time( NULL );
+  dict->size = 0;
+
+  if( !SDictRebuild( dict, capacity, dict->hash ) ){
+    free( dict );
+    return NULL;
+  }
+
+  return dict;
+}
+
+void *
+SDictPut
+( sdict_t *dict, void *key, void *value )
+{
+  size_t capacity, entry, slot;
+  unsigned long long hash;
+  void *result;
+
+  if( !value )
+    return SDictRemove( dict, key );
+
+  VALIDATE_PARAMETERS( dict && key )
+
+  hash = dict->hash( key, dict->seed );
+  slot = SDictFindSlot( dict, key, hash );
+  entry = SDictGetSlot( dict, slot );
+  if( entry ){
+    result = dict->entries[entry-1].value;
+    dict->entries[entry-1].key = key;
+    dict->entries[entry-1].value = value;
+
+    return result;
+  }
+
+  if( dict->next == dict->capacity ){
+    // compacting only pays off when enough of the entries are holes, otherwise
+    // each put after a remove would rebuild the whole table
+    if( ( dict->next - dict->size ) * 4 >= dict->capacity
+        || dict->capacity == SDICT_MAX_CAPACITY )
+      capacity = dict->capacity;
+    else if( dict->capacity > SDICT_MAX_CAPACITY / 2 )
+      capacity = SDICT_MAX_CAPACITY;
+    else
+      capacity = dict->capacity * 2;
+
+    if( dict->size == capacity || !SDictRebuild( dict, capacity, dict->hash ) )
+      return NULL;
+
+    slot = SDictFindSlot( dict, key, hash );
+  }
+
+  dict->entries[dict->next].hash = hash;
+  dict->entries[dict->next].key = key;
+  dict->entries[dict->next].value = value;
+  dict->next++;
+  dict->size++;
+  SDictSetSlot( dict, slot, dict->next );
+
+  return value;
+}
+
+void *
+SDictRemove
+( sdict_t *dict, const void *key )
+{
+  size_t entry;
+
+  VALIDATE_PARAMETERS( dict && key )
+
+  entry = SDictGetSlot( dict, SDictFindSlot( dict, key, dict->hash( key, dict->seed ) ) );
+  if( !entry )
+    return NULL;
+
+  // the slot stays in use so that later keys in the probe are still found
+  dict->entries[entry-1].key = NULL;
+  dict->size--;
+
+  return dict->entries[entry-1].value;
+}
+
+sdict_t *
+SDictSetCapacity
+( sdict_t *dict, size_t capacity )
+{
+  VALIDATE_PARAMETERS( dict && capacity > 0 && capacity >= dict->size && capacity <= SDICT_MAX_CAPACITY )
+
+  return SDictRebuild( dict, capacity, dict->hash );
+}
+
+sdict_t *
+SDictSetHasher
+( sdict_t *dict, hasher_t hasher )
+{
+  VALIDATE_PARAMETERS( dict && hasher )
+
+  return SDictRebuild( dict, dict->capacity, hasher );
+}
+
+sdict_t *
+SDictSetKeyComparator
+( sdict_t *dict, comparator_t comparator )
+{
+  VALIDATE_PARAMETERS( dict && comparator )
+
+  dict->compare_keys = comparator;
+
+  return dict;
+}
+
+size_t
+SDictSize
+( const sdict_t *dict )
+{
+  if( !dict )
+    return 0;
+
+  return dict->size;
+}
+
+static
+size_t
+SDictFindSlot
+( const sdict_t *dict, const void *key, unsigned long long hash )
+{
+  size_t entry, slot;
+  const struct sdict_entry_t *candidate;
+
+  slot = hash & dict->index_mask;
+  while( ( entry = SDictGetSlot( dict, slot ) ) ){
+    candidate = &dict->entries[entry-1];
+    if( candidate->key
+        && candidate->hash == hash
+        && dict->compare_keys( key, candidate->key ) == 0 )
+      return slot;
+
+    slot = ( slot + 1 ) & dict->index_mask;
+  }
+
+  return slot;
+}
+
+static
+size_t
+SDictGetSlot
+( const sdict_t *dict, size_t slot )
+{
+  switch( dict->index_width ){
+    case 1:
+      return ( (const uint8_t *) dict->indices )[slot];
+    case 2:
+      return ( (const uint16_t *) dict->indices )[slot];
+    default:
+      return ( (const uint32_t *) dict->indices )[slot];
+  }
+}
+
+static
+sdict_t *
+SDictRebuild
+( sdict_t *dict, size_t capacity, hasher_t hasher )
+{
+  size_t i, index_slots = 8, next = 0, slot;
+  struct sdict_entry_t *entries;
+  void *indices;
+
+  while( index_slots < capacity + capacity / 2 )
+    index_slots <<= 1;
+
+  entries = malloc( capacity * sizeof( struct sdict_entry_t ) );
+  VALIDATE_ALLOCATION( entries )
+
+  indices = calloc( index_slots, capacity <= 0xff ? 1 : capacity <= 0xffff ? 2 : 4 );
+  VALIDATE_ALLOCATION_AND_FREE( indices, entries )
+
+  for( i = 0; i < dict->next; i++ )
+    if( dict->entries[i].key ){
+      entries[next] = dict->entries[i];
+      if( hasher != dict->hash )
+        entries[next].hash = hasher( entries[next].key, dict->seed );
+      next++;
+    }
+
+  free( dict->entries );
+  free( dict->indices );
+  dict->capacity = capacity;
+  dict->entries = entries;
+  dict->hash = hasher;
+  dict->index_mask = index_slots - 1;
+  dict->index_width = capacity <= 0xff ? 1 : capacity <= 0xffff ? 2 : 4;
+  dict->indices = indices;
+  dict->next = next;
+
+  // keys are known to be distinct, so each only needs an empty slot
+  for( i = 0; i < next; i++ ){
+    slot = entries[i].hash & dict->index_mask;
+    while( SDictGetSlot( dict, slot ) )
+      slot = ( slot + 1 ) & dict->index_mask;
+
+    SDictSetSlot( dict, slot, i + 1 );
+  }
+
+  return dict;
+}
+
+static
+void
+SDictSetSlot
+( sdict_t *dict, size_t slot, size_t value )
+{
+  switch( dict->index_width ){
+    case 1:
+      ( (uint8_t *) dict->indices )[slot] = (uint8_t) value;
+      break;
+    case 2:
+      ( (uint16_t *) dict->indices )[slot] = (uint16_t) value;
+      break;
+    default:
+      ( (uint32_t *) dict->indices )[slot] = (uint32_t) value;
+      break;
+  }
+}
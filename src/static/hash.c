@@ -2,11 +2,23 @@
 #include <string.h>
 #include <time.h>
 #include <woodpile/comparator.h>
+#include <woodpile/config.h>
 #include <woodpile/hasher.h>
 #include <woodpile/static/hash.h>
 #include "lib/validate.h"
 #include "private/static/hash.h"
 
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+unsigned long long
+SHashAutoHash
+( const void *key, unsigned long long seed )
+{
+  return MixedPointerHash( key, seed );
+}
+
 size_t
 SHashCapacity
 ( const shash_t *hash )
@@ -28,12 +40,12 @@ SHashContains
   if( SHashIsEmpty( hash ) )
     return NULL;
 
-  for( i=0; i < hash->capacity*2; i+=2 ){
-    if( !hash->values[i] )
+  for( i=0; i < hash->capacity*hash->stride; i+=hash->stride ){
+    if( !SHASH_SLOT( hash, i ) )
       continue;
 
-    if( hash->compare_elements( element, hash->values[i+1] ) == 0 )
-      return hash->values[i];
+    if( hash->compare_elements( element, SHASH_SLOT( hash, i+hash->value_offset ) ) == 0 )
+      return SHASH_SLOT( hash, i );
   }
 
   return NULL;
@@ -44,33 +56,41 @@ SHashCopy
 ( const shash_t *hash )
 {
   shash_t *copy;
+  size_t i;
 
   VALIDATE_PARAMETERS( hash )
 
   copy = malloc( sizeof( shash_t ) );
   VALIDATE_ALLOCATION( copy )
 
-  copy->values = calloc( hash->capacity * 2, sizeof( void * ) );
-  VALIDATE_ALLOCATION_AND_FREE( copy->values, copy )
+  // the seed is kept along with the slots, or no key could be found again
+  *copy = *hash;
+  copy->table = SHashNewTable( hash->capacity * 2 );
+  VALIDATE_ALLOCATION_AND_FREE( copy->table, copy )
 
-  memcpy( copy->values, hash->values, hash->capacity );
-  copy->capacity = hash->capacity;
-  copy->compare_keys = hash->compare_keys;
-  copy->compare_elements = hash->compare_elements;
-  copy->fold = hash->fold;
-  copy->hash = hash->hash;
-  copy->seed = time( NULL );
-  copy->size = hash->size;
+  copy->segments = copy->table->segments;
+  for( i = 0; i < copy->table->count; i++ )
+    memcpy( copy->segments[i]->slots, hash->segments[i]->slots, sizeof( copy->segments[i]->slots ) );
 
   return copy;
 }
 
+size_t
+SHashDefenseCount
+( const shash_t *hash )
+{
+  if( !hash )
+    return 0;
+
+  return hash->defenses;
+}
+
 void
 SHashDestroy
 ( const shash_t *hash )
 {
   if( hash ){
-    free( hash->values );
+    SHashReleaseTable( hash->table );
     free( (void *) hash );
   }
 
@@ -100,21 +120,27 @@ SHashGet
 ( const shash_t *hash, const void *key )
 {
   unsigned long long start, i;
+  void **slots;
 
   VALIDATE_PARAMETERS( hash && key )
 
   i = start = SHashGetIndex( hash, key );
-  if( !hash->values[i] )
+  slots = hash->segments[i >> SHASH_SEGMENT_SHIFT]->slots;
+  if( !slots[i & SHASH_SEGMENT_MASK] )
     return NULL;
 
   do{
-    if( hash->compare_keys( key, hash->values[i] ) == 0 ){
-      return hash->values[i+1];
+    if( hash->compare_keys( key, slots[i & SHASH_SEGMENT_MASK] ) == 0 ){
+      return SHASH_SLOT( hash, i+hash->value_offset );
     }
 
-    i = (i+2)%(hash->capacity*2);
+    i = (i+hash->stride)%(hash->capacity*hash->stride);
 
-  } while( hash->values[i] && i != start );
+    // the segment only changes when the probe crosses into the next one
+    if( ( i & SHASH_SEGMENT_MASK ) == 0 )
+      slots = hash->segments[i >> SHASH_SEGMENT_SHIFT]->slots;
+
+  } while( slots[i & SHASH_SEGMENT_MASK] && i != start );
 
   return NULL;
 }
@@ -128,6 +154,15 @@ SHashGetHasher
   return hash->hash;
 }
 
+void *
+SHashGetOrPut
+( shash_t *hash, void *key, void *value )
+{
+  VALIDATE_PARAMETERS( value )
+
+  return SHashUpsert( hash, key, SHashReturnContext, value );
+}
+
 unsigned short
 SHashIsEmpty
 ( const shash_t *hash )
@@ -143,6 +178,26 @@ SHashKeyComparator
   return hash->compare_keys;
 }
 
+unsigned short
+SHashLayout
+( const shash_t *hash )
+{
+  if( hash && hash->stride == 1 )
+    return SHASH_SPLIT;
+
+  return SHASH_INTERLEAVED;
+}
+
+unsigned short
+SHashLowWater
+( const shash_t *hash )
+{
+  if( !hash )
+    return 0;
+
+  return hash->low_water;
+}
+
 shash_t *
 SHashNew
 ( void )
@@ -163,6 +218,28 @@ SHashNewDictionary
   return hash;
 }
 
+shash_t *
+SHashNewFromPairs
+( void **keys, void **values, size_t count, unsigned threads )
+{
+  shash_t *hash;
+
+  VALIDATE_PARAMETERS( keys && values )
+
+  hash = SHashNewSized( count < 128 ? 256 : count * 2 );
+  if( !hash )
+    return NULL;
+
+  hash->fold = ModFold;
+
+  if( !SHashBuild( hash, NULL, keys, values, count, threads ) ){
+    SHashDestroy( hash );
+    return NULL;
+  }
+
+  return hash;
+}
+
 shash_t *
 SHashNewSized
 ( size_t capacity )
@@ -172,14 +249,21 @@ SHashNewSized
   hash = malloc( sizeof( shash_t ) );
   VALIDATE_ALLOCATION( hash )
 
-  hash->values = calloc( capacity * 2, sizeof( void * ) );
-  VALIDATE_ALLOCATION_AND_FREE( hash->values, hash )
+  hash->table = SHashNewTable( capacity * 2 );
+  VALIDATE_ALLOCATION_AND_FREE( hash->table, hash )
 
+  hash->segments = hash->table->segments;
   hash->capacity = capacity;
   hash->seed = time( NULL );
   hash->size = 0;
-
-  hash->hash = PointerHash;
+  hash->training = 0;
+  hash->defended_size = 0;
+  hash->defenses = 0;
+  hash->low_water = 0;
+  hash->stride = 2;
+  hash->value_offset = 1;
+
+  hash->hash = MixedPointerHash;
   hash->fold = XORFold;
   hash->compare_elements = hash->compare_keys = ComparePointers;
 
@@ -191,6 +275,7 @@ SHashPut
 ( shash_t *hash, void *key, void *value )
 {
   unsigned long long i, start;
+  size_t probes = 0;
   void *result;
 
   if( !value )
@@ -201,23 +286,20 @@ SHashPut
   i = start = SHashGetIndex( hash, key );
 
   do {
-    if( !hash->values[i] ){
-      hash->size++;
-      hash->values[i] = key;
-      hash->values[i+1] = value;
+    probes++;
 
-      return value;
-    }
+    if( !SHASH_SLOT( hash, i ) )
+      return SHashInsert( hash, i, key, value, probes );
 
-    if( hash->compare_keys( key, hash->values[i] ) == 0 ){
-      result = hash->values[i+1];
-      hash->values[i] = key;
-      hash->values[i+1] = value;
+    if( hash->compare_keys( key, SHASH_SLOT( hash, i ) ) == 0 ){
+      result = SHASH_SLOT( hash, i+hash->value_offset );
+      if( !SHashStore( hash, i, key, value ) )
+        return NULL;
 
       return result;
     }
 
-    i = (i+2)%(hash->capacity*2);
+    i = (i+hash->stride)%(hash->capacity*hash->stride);
   } while( i != start );
 
   return NULL;
@@ -227,35 +309,58 @@ void *
 SHashRemove
 ( shash_t *hash, const void *key )
 {
-  unsigned long long i, start, previous;
+  unsigned long long home, hole, i, j, start, slots;
   void *result;
 
   VALIDATE_PARAMETERS( hash && key )
 
-  i = start = hash->fold( hash->hash( key, hash->seed ), hash->capacity )*2;
-  if( !hash->values[i] )
+  i = start = SHashGetIndex( hash, key );
+  if( !SHASH_SLOT( hash, i ) )
     return NULL;
 
-  while( hash->compare_keys( key, hash->values[i] ) != 0 ){
-    i = (i+2)%(hash->capacity*2);
+  while( hash->compare_keys( key, SHASH_SLOT( hash, i ) ) != 0 ){
+    i = (i+hash->stride)%(hash->capacity*hash->stride);
 
-    if( !hash->values[i] || i == start )
+    if( !SHASH_SLOT( hash, i ) || i == start )
       return NULL;
   }
 
-  result = hash->values[i+1];
-  hash->values[i] = hash->values[i+1] = NULL;
-  previous = i;
-  i = (i+2)%(hash->capacity*2);
+  result = SHASH_SLOT( hash, i+hash->value_offset );
+  slots = hash->capacity*hash->stride;
 
-  while( hash->values[i] && SHashGetIndex( hash, key ) == start ){
-    hash->values[previous] = hash->values[i];
-    hash->values[previous+1] = hash->values[i+1];
+  // the shift only writes within the run, so owning it first means it can't fail
+  j = i;
+  do {
+    if( !SHashOwn( hash, j ) || !SHashOwn( hash, j+hash->value_offset ) )
+      return NULL;
 
-    previous = i;
-    i = (i+2)%(hash->capacity*2);
+    j = (j+hash->stride)%slots;
+  } while( SHASH_SLOT( hash, j ) && j != i );
+
+  hole = i;
+  i = (i+hash->stride)%slots;
+
+  // a later key in the run fills the hole if the hole is between it and home
+  while( SHASH_SLOT( hash, i ) && i != hole ){
+    home = SHashGetIndex( hash, SHASH_SLOT( hash, i ) );
+    if( (i+slots-home)%slots >= (i+slots-hole)%slots ){
+      SHASH_SLOT( hash, hole ) = SHASH_SLOT( hash, i );
+      SHASH_SLOT( hash, hole+hash->value_offset ) = SHASH_SLOT( hash, i+hash->value_offset );
+      hole = i;
+    }
+
+    i = (i+hash->stride)%slots;
   }
 
+  SHASH_SLOT( hash, hole ) = NULL;
+  SHASH_SLOT( hash, hole+hash->value_offset ) = NULL;
+
+  hash->size--;
+  if( hash->low_water
+      && hash->capacity / 2 >= SHASH_MIN_CAPACITY
+      && hash->size * 100 < hash->capacity * hash->low_water )
+    SHashSetCapacity( hash, hash->capacity / 2 );
+
   return result;
 }
 
@@ -263,38 +368,72 @@ shash_t *
 SHashSetCapacity
 ( shash_t *hash, size_t capacity )
 {
-  size_t old_capacity;
   unsigned long long i, j, start;
-  void **old_values;
+  shash_t old;
 
-  VALIDATE_PARAMETERS( hash )
+  VALIDATE_PARAMETERS( hash && capacity > 0 && capacity >= hash->size )
 
-  old_values = hash->values;
-  hash->values = calloc( capacity*2, sizeof( void * ) );
-  VALIDATE_ALLOCATION( hash->values )
+  old = *hash;
+  hash->table = SHashNewTable( capacity*2 );
+  if( !hash->table ){
+    *hash = old;
+    return NULL;
+  }
 
-  old_capacity = hash->capacity;
+  hash->segments = hash->table->segments;
   hash->capacity = capacity;
+  if( hash->stride == 1 )
+    hash->value_offset = capacity;
+
   hash->size = 0;
-  for( i=0; i < old_capacity*2; i+=2 ){
-    if( !old_values[i] )
+  for( i=0; i < old.capacity*hash->stride; i+=hash->stride ){
+    if( !SHASH_SLOT( &old, i ) )
       continue;
 
-    j = start = SHashGetIndex( hash, old_values[i] );
+    j = start = SHashGetIndex( hash, SHASH_SLOT( &old, i ) );
     do {
-      if( !hash->values[j] ){
+      if( !SHASH_SLOT( hash, j ) ){
         hash->size++;
-        hash->values[j] = old_values[i];
-        hash->values[j+1] = old_values[i+1];
+        SHASH_SLOT( hash, j ) = SHASH_SLOT( &old, i );
+        SHASH_SLOT( hash, j+hash->value_offset ) = SHASH_SLOT( &old, i+old.value_offset );
 
         break;
       }
 
-      j = (j+2)%(capacity*2);
+      j = (j+hash->stride)%(capacity*hash->stride);
     } while( j != start );
   }
 
-  free( old_values );
+  SHashReleaseTable( old.table );
+
+  return hash;
+}
+
+shash_t *
+SHashSetCapacityParallel
+( shash_t *hash, size_t capacity, unsigned threads )
+{
+  shash_t resized;
+
+  VALIDATE_PARAMETERS( hash && capacity > 0 && capacity >= hash->size )
+
+  resized = *hash;
+  resized.capacity = capacity;
+  resized.size = 0;
+  if( resized.stride == 1 )
+    resized.value_offset = capacity;
+
+  resized.table = SHashNewTable( capacity*2 );
+  VALIDATE_ALLOCATION( resized.table )
+
+  resized.segments = resized.table->segments;
+  if( !SHashBuild( &resized, hash, NULL, NULL, hash->capacity, threads ) ){
+    SHashReleaseTable( resized.table );
+    return NULL;
+  }
+
+  SHashReleaseTable( hash->table );
+  *hash = resized;
 
   return hash;
 }
@@ -314,11 +453,18 @@ shash_t *
 SHashSetFolder
 ( shash_t *hash, folder_t folder )
 {
+  folder_t old_folder;
+
   VALIDATE_PARAMETERS( hash && folder )
 
+  old_folder = hash->fold;
   hash->fold = folder;
+  if( !SHashRehash( hash, hash->hash, hash->seed ) ){
+    hash->fold = old_folder;
+    return NULL;
+  }
 
-  return SHashRehash( hash );
+  return hash;
 }
 
 shash_t *
@@ -327,20 +473,79 @@ SHashSetHasher
 {
   VALIDATE_PARAMETERS( hash && hasher )
 
-  hash->hash = hasher;
+  if( hasher == SHashAutoHash ){
+    hash->training = 1;
 
-  return SHashRehash( hash );
+    return hash;
+  }
+
+  if( !SHashRehash( hash, hasher, hash->seed ) )
+    return NULL;
+
+  hash->training = 0;
+
+  return hash;
 }
 
 shash_t *
 SHashSetKeyComparator
 ( shash_t *hash, comparator_t comparator )
 {
+  comparator_t old_comparator;
+
   VALIDATE_PARAMETERS( hash && comparator )
 
+  old_comparator = hash->compare_keys;
   hash->compare_keys = comparator;
+  if( !SHashRehash( hash, hash->hash, hash->seed ) ){
+    hash->compare_keys = old_comparator;
+    return NULL;
+  }
 
-  return SHashRehash( hash );
+  return hash;
+}
+
+shash_t *
+SHashSetLayout
+( shash_t *hash, unsigned short layout )
+{
+  size_t i, stride, value_offset;
+  struct shash_table_t *table;
+
+  VALIDATE_PARAMETERS( hash && ( layout == SHASH_INTERLEAVED || layout == SHASH_SPLIT ) )
+
+  stride = layout == SHASH_SPLIT ? 1 : 2;
+  value_offset = layout == SHASH_SPLIT ? hash->capacity : 1;
+  if( stride == hash->stride )
+    return hash;
+
+  table = SHashNewTable( hash->capacity*2 );
+  VALIDATE_ALLOCATION( table )
+
+  // each element keeps its slot, so nothing needs to be rehashed
+  for( i=0; i < hash->capacity; i++ ){
+    SHASH_SLOT( table, i*stride ) = SHASH_SLOT( hash, i*hash->stride );
+    SHASH_SLOT( table, i*stride+value_offset ) = SHASH_SLOT( hash, i*hash->stride+hash->value_offset );
+  }
+
+  SHashReleaseTable( hash->table );
+  hash->table = table;
+  hash->segments = table->segments;
+  hash->stride = stride;
+  hash->value_offset = value_offset;
+
+  return hash;
+}
+
+shash_t *
+SHashSetLowWater
+( shash_t *hash, unsigned short percent )
+{
+  VALIDATE_PARAMETERS( hash && percent <= 25 )
+
+  hash->low_water = percent;
+
+  return hash;
 }
 
 shash_t *
@@ -349,9 +554,7 @@ SHashSetSeed
 {
   VALIDATE_PARAMETERS( hash )
 
-  hash->seed = seed;
-
-  return SHashRehash( hash );
+  return SHashRehash( hash, hash->hash, seed );
 }
 
 size_t
@@ -364,6 +567,23 @@ SHashSize
   return hash->size;
 }
 
+shash_t *
+SHashSnapshot
+( const shash_t *hash )
+{
+  shash_t *snapshot;
+
+  VALIDATE_PARAMETERS( hash )
+
+  snapshot = malloc( sizeof( shash_t ) );
+  VALIDATE_ALLOCATION( snapshot )
+
+  *snapshot = *hash;
+  hash->table->references++;
+
+  return snapshot;
+}
+
 char *
 SHashToString
 ( const shash_t *hash, char * ( *element_to_string )( const void * ) )
@@ -371,53 +591,666 @@ SHashToString
   return NULL;
 }
 
+shash_t *
+SHashTrainHasher
+( shash_t *hash )
+{
+  clock_t clocks, fastest_clocks = 0;
+  double expected = 1.0;
+  hasher_t candidates[3], fastest = NULL, widest = NULL;
+  size_t candidate_count = 0, count, i, seen = 0, skip, used, widest_used = 0;
+  unsigned char *buckets;
+  void **keys;
+
+  VALIDATE_PARAMETERS( hash )
+
+  // automatic selection stays on until there are enough keys to judge by
+  if( hash->size < SHASH_TRAINING_MIN_SIZE )
+    return hash;
+
+  hash->training = 0;
+
+  // CityHash is left out, as it is still a stub giving every key the same hash
+  if( hash->compare_keys == CompareStrings ){
+#ifdef __WOODPILE_CRC_HASHER
+    candidates[candidate_count++] = CRCHash;
+#endif
+#ifdef __WOODPILE_SPOOKY_HASHER
+    candidates[candidate_count++] = SpookyHash;
+#endif
+#ifdef __WOODPILE_WOODPILE_HASHER
+    candidates[candidate_count++] = WoodpileHash;
+#endif
+  } else {
+    candidates[candidate_count++] = MixedPointerHash;
+    candidates[candidate_count++] = PointerHash;
+  }
+
+  if( candidate_count == 0 )
+    return hash;
+
+  count = hash->size < SHASH_TRAINING_SIZE ? hash->size : SHASH_TRAINING_SIZE;
+  keys = malloc( count * sizeof( void * ) );
+  VALIDATE_ALLOCATION( keys )
+
+  buckets = malloc( hash->capacity );
+  VALIDATE_ALLOCATION_AND_FREE( buckets, keys )
+
+  // sample keys spread over the whole table rather than just its front
+  skip = hash->size / count;
+  for( i = 0, count = 0; i < hash->capacity*hash->stride && count < SHASH_TRAINING_SIZE; i+=hash->stride )
+    if( SHASH_SLOT( hash, i ) && seen++ % skip == 0 )
+      keys[count++] = SHASH_SLOT( hash, i );
+
+  // the buckets a uniform hasher is expected to use for this many keys
+  for( i = 0; i < count; i++ )
+    expected *= 1.0 - 1.0 / hash->capacity;
+  expected = hash->capacity * ( 1.0 - expected );
+
+  for( i = 0; i < candidate_count; i++ ){
+    if( SHashHashesAlike( hash, candidates[i], keys, count ) )
+      continue;
+
+    memset( buckets, 0, hash->capacity );
+    used = SHashCountBuckets( hash, candidates[i], keys, count, buckets );
+    clocks = SHashTimeHasher( candidates[i], keys, count, hash->seed );
+
+    if( used * 4 >= expected * 3 && ( !fastest || clocks < fastest_clocks ) ){
+      fastest = candidates[i];
+      fastest_clocks = clocks;
+    }
+
+    if( !widest || used > widest_used ){
+      widest = candidates[i];
+      widest_used = used;
+    }
+  }
+
+  free( buckets );
+  free( keys );
+
+  if( !fastest )
+    fastest = widest;
+
+  if( !fastest || fastest == hash->hash )
+    return hash;
+
+  return SHashRehash( hash, fastest, hash->seed );
+}
+
+shash_t *
+SHashTrimToSize
+( shash_t *hash )
+{
+  size_t capacity;
+
+  VALIDATE_PARAMETERS( hash )
+
+  capacity = hash->size * 2;
+  if( capacity < SHASH_MIN_CAPACITY )
+    capacity = SHASH_MIN_CAPACITY;
+
+  if( capacity >= hash->capacity )
+    return hash;
+
+  return SHashSetCapacity( hash, capacity );
+}
+
+void *
+SHashUpsert
+( shash_t *hash, void *key, void * ( *build )( const void *, void * ), void *context )
+{
+  unsigned long long i, start;
+  size_t probes = 0;
+  void *value;
+
+  VALIDATE_PARAMETERS( hash && key && build )
+
+  i = start = SHashGetIndex( hash, key );
+
+  do {
+    probes++;
+
+    if( !SHASH_SLOT( hash, i ) ){
+      value = build( key, context );
+      if( !value )
+        return NULL;
+
+      return SHashInsert( hash, i, key, value, probes );
+    }
+
+    if( hash->compare_keys( key, SHASH_SLOT( hash, i ) ) == 0 )
+      return SHASH_SLOT( hash, i+hash->value_offset );
+
+    i = (i+hash->stride)%(hash->capacity*hash->stride);
+  } while( i != start );
+
+  return NULL;
+}
+
+static
+shash_t *
+SHashBuild
+( shash_t *hash, const shash_t *source, void **keys, void **values, size_t pairs, unsigned threads )
+{
+  unsigned long long *homes;
+  size_t i, k, *order, pair, span, start;
+  void *key;
+  unsigned short failed = 0;
+  unsigned t;
+  struct shash_worker_t *workers;
+
+#ifndef __WOODPILE_HAVE_PTHREAD_H
+  threads = 1;
+#endif
+  if( threads == 0 )
+    threads = 1;
+  if( threads > SHASH_MAX_THREADS )
+    threads = SHASH_MAX_THREADS;
+  if( threads > hash->capacity )
+    threads = hash->capacity;
+
+  homes = malloc( ( pairs ? pairs : 1 ) * sizeof( unsigned long long ) );
+  VALIDATE_ALLOCATION( homes )
+
+  order = malloc( ( pairs ? pairs : 1 ) * sizeof( size_t ) );
+  VALIDATE_ALLOCATION_AND_FREE( order, homes )
+
+  workers = calloc( threads, sizeof( struct shash_worker_t ) );
+  if( !workers ){
+    free( order );
+    free( homes );
+    return NULL;
+  }
+
+  for( t = 0; t < threads; t++ ){
+    workers[t].begin = hash->capacity / threads * t;
+    workers[t].end = t == threads - 1 ? hash->capacity : hash->capacity / threads * ( t + 1 );
+    workers[t].first = pairs / threads * t;
+    workers[t].last = t == threads - 1 ? pairs : pairs / threads * ( t + 1 );
+    workers[t].hash = hash;
+    workers[t].homes = homes;
+    workers[t].keys = keys;
+    workers[t].order = order;
+    workers[t].source = source;
+    workers[t].values = values;
+  }
+
+  SHashRunWorkers( workers, threads, SHashComputeHomes );
+
+  // a stable counting sort groups the pairs by the worker owning their home,
+  // so that no worker has to scan the pairs of the others
+  span = hash->capacity / threads;
+  for( k = 0; k < pairs; k++ )
+    if( homes[k] < hash->capacity )
+      workers[homes[k] / span < threads ? homes[k] / span : threads - 1].fill_last++;
+
+  for( t = 0, i = 0; t < threads; t++ ){
+    workers[t].fill_first = i;
+    i += workers[t].fill_last;
+    workers[t].fill_last = workers[t].fill_first;
+  }
+
+  for( k = 0; k < pairs; k++ )
+    if( homes[k] < hash->capacity )
+      order[workers[homes[k] / span < threads ? homes[k] / span : threads - 1].fill_last++] = k;
+
+  SHashRunWorkers( workers, threads, SHashFillRange );
+
+  // overflow is placed in worker order, keeping later duplicates last
+  for( t = 0; t < threads; t++ ){
+    hash->size += workers[t].inserted;
+    failed |= workers[t].failed;
+
+    for( k = 0; !failed && k < workers[t].overflow_count; k++ ){
+      pair = workers[t].overflow[k];
+      key = SHashPairKey( &workers[t], pair );
+      i = start = homes[pair] * hash->stride;
+      do {
+        if( !SHASH_SLOT( hash, i ) ){
+          hash->size++;
+          SHASH_SLOT( hash, i ) = key;
+          SHASH_SLOT( hash, i+hash->value_offset ) = SHashPairValue( &workers[t], pair );
+
+          break;
+        }
+
+        if( hash->compare_keys( SHASH_SLOT( hash, i ), key ) == 0 ){
+          SHASH_SLOT( hash, i ) = key;
+          SHASH_SLOT( hash, i+hash->value_offset ) = SHashPairValue( &workers[t], pair );
+
+          break;
+        }
+
+        i = (i+hash->stride)%(hash->capacity*hash->stride);
+      } while( i != start );
+    }
+
+    free( workers[t].overflow );
+  }
+
+  free( workers );
+  free( order );
+  free( homes );
+
+  if( failed )
+    return NULL;
+
+  return hash;
+}
+
+static
+void *
+SHashComputeHomes
+( void *worker )
+{
+  size_t i;
+  struct shash_worker_t *share = worker;
+  const shash_t *hash = share->hash;
+  void *key;
+
+  for( i = share->first; i < share->last; i++ ){
+    key = SHashPairKey( share, i );
+    if( key && SHashPairValue( share, i ) )
+      share->homes[i] = hash->fold( hash->hash( key, hash->seed ), hash->capacity );
+    else
+      share->homes[i] = hash->capacity;
+  }
+
+  return NULL;
+}
+
+static
+size_t
+SHashCountBuckets
+( const shash_t *hash, hasher_t hasher, void **keys, size_t count, unsigned char *buckets )
+{
+  size_t i, used = 0;
+  unsigned long long bucket;
+
+  for( i = 0; i < count; i++ ){
+    bucket = hash->fold( hasher( keys[i], hash->seed ), hash->capacity );
+    if( !buckets[bucket] ){
+      buckets[bucket] = 1;
+      used++;
+    }
+  }
+
+  return used;
+}
+
+static
+shash_t *
+SHashDefend
+( shash_t *hash )
+{
+  hasher_t hasher, keyed = NULL;
+  unsigned long long seed;
+
+#if defined( __WOODPILE_SPOOKY_HASHER )
+  keyed = SpookyHash;
+#elif defined( __WOODPILE_CRC_HASHER )
+  keyed = CRCHash;
+#endif
+
+  hasher = hash->hash;
+  if( hasher == PointerHash )
+    hasher = MixedPointerHash;
+#ifdef __WOODPILE_CITY_HASHER
+  else if( keyed && hasher == CityHash )
+    hasher = keyed;
+#endif
+#ifdef __WOODPILE_WOODPILE_HASHER
+  else if( keyed && hasher == WoodpileHash )
+    hasher = keyed;
+#endif
+
+  seed = MixInteger( hash->seed ^ (unsigned long long) time( NULL ),
+                     (unsigned long long) clock() ^ (unsigned long long) (size_t) hash );
+
+  // a failed rehash leaves the hash as it was, to be defended again later
+  if( !SHashRehash( hash, hasher, seed ) )
+    return NULL;
+
+  hash->defended_size = hash->size;
+  hash->defenses++;
+
+  return hash;
+}
+
+static
+void *
+SHashFillRange
+( void *worker )
+{
+  size_t i, j, k, *overflow, slot;
+  struct shash_worker_t *share = worker;
+  shash_t *hash = share->hash;
+  void *key;
+
+  for( j = share->fill_first; j < share->fill_last; j++ ){
+    k = share->order[j];
+    key = SHashPairKey( share, k );
+    for( slot = share->homes[k]; slot < share->end; slot++ ){
+      i = slot*hash->stride;
+      if( !SHASH_SLOT( hash, i ) ){
+        share->inserted++;
+        SHASH_SLOT( hash, i ) = key;
+        SHASH_SLOT( hash, i+hash->value_offset ) = SHashPairValue( share, k );
+
+        break;
+      }
+
+      if( hash->compare_keys( SHASH_SLOT( hash, i ), key ) == 0 ){
+        SHASH_SLOT( hash, i ) = key;
+        SHASH_SLOT( hash, i+hash->value_offset ) = SHashPairValue( share, k );
+
+        break;
+      }
+    }
+
+    if( slot < share->end )
+      continue;
+
+    if( share->overflow_count == share->overflow_capacity ){
+      overflow = realloc( share->overflow, ( share->overflow_capacity * 2 + 64 ) * sizeof( size_t ) );
+      if( !overflow ){
+        share->failed = 1;
+        return NULL;
+      }
+
+      share->overflow = overflow;
+      share->overflow_capacity = share->overflow_capacity * 2 + 64;
+    }
+
+    share->overflow[share->overflow_count++] = k;
+  }
+
+  return NULL;
+}
+
 static
 unsigned long long
 SHashGetIndex
 ( const shash_t *hash, const void *key )
 {
-  return hash->fold( hash->hash( key, hash->seed ), hash->capacity )*2;
+  return hash->fold( hash->hash( key, hash->seed ), hash->capacity )*hash->stride;
+}
+
+static
+unsigned short
+SHashHashesAlike
+( const shash_t *hash, hasher_t hasher, void **keys, size_t count )
+{
+  unsigned long long first;
+  size_t i;
+
+  first = hasher( keys[0], hash->seed );
+  for( i = 1; i < count; i++ )
+    if( hasher( keys[i], hash->seed ) != first )
+      return 0;
+
+  return 1;
+}
+
+static
+void *
+SHashInsert
+( shash_t *hash, unsigned long long i, void *key, void *value, size_t probes )
+{
+  if( !SHashStore( hash, i, key, value ) )
+    return NULL;
+
+  hash->size++;
+
+  if( hash->training
+      && ( hash->size >= SHASH_TRAINING_SIZE
+           || hash->size * 2 >= hash->capacity ) )
+    SHashTrainHasher( hash );
+  else if( probes > SHashProbeLimit( hash )
+           && hash->size >= hash->defended_size * 2
+           && hash->size * 4 < hash->capacity * 3 )
+    SHashDefend( hash );
+
+  return value;
+}
+
+static
+struct shash_table_t *
+SHashNewTable
+( size_t slots )
+{
+  size_t count, i;
+  struct shash_table_t *table;
+
+  count = ( slots + SHASH_SEGMENT_MASK ) >> SHASH_SEGMENT_SHIFT;
+  table = malloc( sizeof( struct shash_table_t ) + count * sizeof( struct shash_segment_t * ) );
+  VALIDATE_ALLOCATION( table )
+
+  table->count = count;
+  table->references = 1;
+  table->segments = (struct shash_segment_t **) ( table + 1 );
+  for( i = 0; i < count; i++ ){
+    table->segments[i] = calloc( 1, sizeof( struct shash_segment_t ) );
+    if( !table->segments[i] ){
+      table->count = i;
+      SHashReleaseTable( table );
+      return NULL;
+    }
+
+    table->segments[i]->references = 1;
+  }
+
+  return table;
 }
 
 static
 shash_t *
-SHashRehash
-( shash_t *hash )
+SHashOwn
+( shash_t *hash, unsigned long long i )
 {
-  unsigned long long i, j, start;
-  void **old_values;
+  size_t s;
+  struct shash_segment_t *segment;
+  struct shash_table_t *table;
+
+  if( hash->table->references > 1 ){
+    table = malloc( sizeof( struct shash_table_t ) + hash->table->count * sizeof( struct shash_segment_t * ) );
+    VALIDATE_ALLOCATION( table )
+
+    table->count = hash->table->count;
+    table->references = 1;
+    table->segments = (struct shash_segment_t **) ( table + 1 );
+    for( s = 0; s < table->count; s++ ){
+      table->segments[s] = hash->segments[s];
+      table->segments[s]->references++;
+    }
 
-  old_values = hash->values;
-  hash->values = calloc( hash->capacity*2, sizeof( void * ) );
-  VALIDATE_ALLOCATION( hash->values )
+    SHashReleaseTable( hash->table );
+    hash->table = table;
+    hash->segments = table->segments;
+  }
 
-  hash->size = 0;
-  for( i=0; i < hash->capacity*2; i+=2 ){
-    if( !old_values[i] )
+  s = i >> SHASH_SEGMENT_SHIFT;
+  if( hash->segments[s]->references > 1 ){
+    segment = malloc( sizeof( struct shash_segment_t ) );
+    VALIDATE_ALLOCATION( segment )
+
+    memcpy( segment->slots, hash->segments[s]->slots, sizeof( segment->slots ) );
+    segment->references = 1;
+
+    // the other holders may have let go since the check
+    if( --hash->segments[s]->references == 0 )
+      free( hash->segments[s] );
+
+    hash->segments[s] = segment;
+  }
+
+  return hash;
+}
+
+static
+void *
+SHashPairKey
+( const struct shash_worker_t *worker, size_t pair )
+{
+  if( worker->source )
+    return SHASH_SLOT( worker->source, pair*worker->source->stride );
+
+  return worker->keys[pair];
+}
+
+static
+void *
+SHashPairValue
+( const struct shash_worker_t *worker, size_t pair )
+{
+  if( worker->source )
+    return SHASH_SLOT( worker->source, pair*worker->source->stride+worker->source->value_offset );
+
+  return worker->values[pair];
+}
+
+static
+size_t
+SHashProbeLimit
+( const shash_t *hash )
+{
+  size_t capacity, log = 1;
+
+  for( capacity = hash->capacity; capacity > 1; capacity >>= 1 )
+    log++;
+
+  return SHASH_PROBE_FACTOR * log;
+}
+
+static
+shash_t *
+SHashRehash
+( shash_t *hash, hasher_t hasher, unsigned long long seed )
+{
+  unsigned long long i, j, start;
+  shash_t rehashed;
+
+  rehashed = *hash;
+  rehashed.hash = hasher;
+  rehashed.seed = seed;
+  rehashed.table = SHashNewTable( hash->capacity*2 );
+  VALIDATE_ALLOCATION( rehashed.table )
+
+  rehashed.segments = rehashed.table->segments;
+  rehashed.size = 0;
+  for( i=0; i < hash->capacity*hash->stride; i+=hash->stride ){
+    if( !SHASH_SLOT( hash, i ) )
       continue;
 
-    j = start = SHashGetIndex( hash, old_values[i] );
+    j = start = SHashGetIndex( &rehashed, SHASH_SLOT( hash, i ) );
     do {
-      if( !hash->values[j] ){
-        hash->size++;
-        hash->values[j] = old_values[i];
-        hash->values[j+1] = old_values[i+1];
+      if( !SHASH_SLOT( &rehashed, j ) ){
+        rehashed.size++;
+        SHASH_SLOT( &rehashed, j ) = SHASH_SLOT( hash, i );
+        SHASH_SLOT( &rehashed, j+hash->value_offset ) = SHASH_SLOT( hash, i+hash->value_offset );
 
         break;
       }
 
-      if( hash->compare_keys( hash->values[j], old_values[i] ) == 0 ){
-        hash->values[j] = old_values[i];
-        hash->values[j+1] = old_values[i+1];
+      if( rehashed.compare_keys( SHASH_SLOT( &rehashed, j ), SHASH_SLOT( hash, i ) ) == 0 ){
+        SHASH_SLOT( &rehashed, j ) = SHASH_SLOT( hash, i );
+        SHASH_SLOT( &rehashed, j+hash->value_offset ) = SHASH_SLOT( hash, i+hash->value_offset );
 
         break;
       }
 
-      j = (j+2)%(hash->capacity*2);
+      j = (j+hash->stride)%(hash->capacity*hash->stride);
     } while( j != start );
   }
 
-  free( old_values );
+  SHashReleaseTable( hash->table );
+  *hash = rehashed;
+
+  return hash;
+}
+
+static
+void
+SHashReleaseTable
+( struct shash_table_t *table )
+{
+  size_t i;
+
+  if( --table->references > 0 )
+    return;
+
+  for( i = 0; i < table->count; i++ )
+    if( --table->segments[i]->references == 0 )
+      free( table->segments[i] );
+
+  free( table );
+}
+
+static
+void *
+SHashReturnContext
+( const void *key, void *context )
+{
+  (void) key;
+
+  return context;
+}
+
+static
+void
+SHashRunWorkers
+( struct shash_worker_t *workers, unsigned count, void *( *pass )( void * ) )
+{
+  unsigned t;
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  unsigned short started[SHASH_MAX_THREADS];
+  pthread_t threads[SHASH_MAX_THREADS];
+
+  for( t = 1; t < count; t++ )
+    started[t] = pthread_create( &threads[t], NULL, pass, &workers[t] ) == 0;
+
+  pass( &workers[0] );
+
+  for( t = 1; t < count; t++ ){
+    if( started[t] )
+      pthread_join( threads[t], NULL );
+    else
+      pass( &workers[t] );
+  }
+#else
+  for( t = 0; t < count; t++ )
+    pass( &workers[t] );
+#endif
+}
+
+static
+shash_t *
+SHashStore
+( shash_t *hash, unsigned long long i, void *key, void *value )
+{
+  if( !SHashOwn( hash, i ) || !SHashOwn( hash, i+hash->value_offset ) )
+    return NULL;
+
+  SHASH_SLOT( hash, i ) = key;
+  SHASH_SLOT( hash, i+hash->value_offset ) = value;
 
   return hash;
 }
+
+static
+clock_t
+SHashTimeHasher
+( hasher_t hasher, void **keys, size_t count, unsigned long long seed )
+{
+  clock_t begin;
+  size_t i, round;
+  volatile unsigned long long sink = 0;
+
+  begin = clock();
+  for( round = 0; round < SHASH_TRAINING_ROUNDS; round++ )
+    for( i = 0; i < count; i++ )
+      sink ^= hasher( keys[i], seed );
+
+  return clock() - begin;
+}
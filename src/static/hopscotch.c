@@ -0,0 +1,331 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hopscotch.h>
+#include "lib/validate.h"
+#include "private/static/hopscotch.h"
+
+size_t
+SHopscotchCapacity
+( const shopscotch_t *hash )
+{
+  if( !hash )
+    return 0;
+
+  return hash->capacity;
+}
+
+void
+SHopscotchDestroy
+( const shopscotch_t *hash )
+{
+  if( hash ){
+    free( hash->hops );
+    free( hash->values );
+    free( (void *) hash );
+  }
+
+  return;
+}
+
+void *
+SHopscotchGet
+( const shopscotch_t *hash, const void *key )
+{
+  size_t slot;
+
+  VALIDATE_PARAMETERS( hash && key )
+
+  slot = SHopscotchFind( hash, key, SHopscotchHome( hash, key ) );
+  if( slot == hash->capacity )
+    return NULL;
+
+  return hash->values[slot*2+1];
+}
+
+unsigned short
+SHopscotchIsEmpty
+( const shopscotch_t *hash )
+{
+  return hash == NULL || hash->size == 0;
+}
+
+shopscotch_t *
+SHopscotchNew
+( void )
+{
+  return SHopscotchNewSized( 256 );
+}
+
+shopscotch_t *
+SHopscotchNewSized
+( size_t capacity )
+{
+  shopscotch_t *hash;
+
+  VALIDATE_PARAMETERS( capacity > 0 )
+
+  hash = malloc( sizeof( shopscotch_t ) );
+  VALIDATE_ALLOCATION( hash )
+
+  hash->capacity = 0;
+  hash->compare_keys = ComparePointers;
+  hash->fold = ModFold;
+  hash->hash = MixedPointerHash;
+  hash->hops = NULL;
+  hash->seed = time( NULL );
+  hash->size = 0;
+  hash->values = NULL;
+
+  if( !SHopscotchRehash( hash, capacity ) ){
+    free( hash );
+    return NULL;
+  }
+
+  return hash;
+}
+
+void *
+SHopscotchPut
+( shopscotch_t *hash, void *key, void *value )
+{
+  size_t home, slot;
+  void *result;
+
+  if( !value )
+    return SHopscotchRemove( hash, key );
+
+  VALIDATE_PARAMETERS( hash && key )
+
+  home = SHopscotchHome( hash, key );
+  slot = SHopscotchFind( hash, key, home );
+  if( slot != hash->capacity ){
+    result = hash->values[slot*2+1];
+    hash->values[slot*2] = key;
+    hash->values[slot*2+1] = value;
+
+    return result;
+  }
+
+  return SHopscotchPlace( hash, key, value, home );
+}
+
+void *
+SHopscotchRemove
+( shopscotch_t *hash, const void *key )
+{
+  size_t home, slot;
+  void *result;
+
+  VALIDATE_PARAMETERS( hash && key )
+
+  home = SHopscotchHome( hash, key );
+  slot = SHopscotchFind( hash, key, home );
+  if( slot == hash->capacity )
+    return NULL;
+
+  result = hash->values[slot*2+1];
+  hash->values[slot*2] = hash->values[slot*2+1] = NULL;
+  hash->hops[home] &= ~( (uint64_t) 1 << ( ( slot + hash->capacity - home ) % hash->capacity ) );
+  hash->size--;
+
+  return result;
+}
+
+shopscotch_t *
+SHopscotchSetCapacity
+( shopscotch_t *hash, size_t capacity )
+{
+  VALIDATE_PARAMETERS( hash && capacity > 0 )
+
+  return SHopscotchRehash( hash, capacity );
+}
+
+shopscotch_t *
+SHopscotchSetFolder
+( shopscotch_t *hash, folder_t folder )
+{
+  folder_t old_folder;
+
+  VALIDATE_PARAMETERS( hash && folder )
+
+  old_folder = hash->fold;
+  hash->fold = folder;
+  if( !SHopscotchRehash( hash, hash->capacity ) ){
+    hash->fold = old_folder;
+    return NULL;
+  }
+
+  return hash;
+}
+
+shopscotch_t *
+SHopscotchSetHasher
+( shopscotch_t *hash, hasher_t hasher )
+{
+  hasher_t old_hasher;
+
+  VALIDATE_PARAMETERS( hash && hasher )
+
+  old_hasher = hash->hash;
+  hash->hash = hasher;
+  if( !SHopscotchRehash( hash, hash->capacity ) ){
+    hash->hash = old_hasher;
+    return NULL;
+  }
+
+  return hash;
+}
+
+shopscotch_t *
+SHopscotchSetKeyComparator
+( shopscotch_t *hash, comparator_t comparator )
+{
+  VALIDATE_PARAMETERS( hash && comparator )
+
+  hash->compare_keys = comparator;
+
+  return hash;
+}
+
+shopscotch_t *
+SHopscotchSetSeed
+( shopscotch_t *hash, unsigned long long seed )
+{
+  unsigned long long old_seed;
+
+  VALIDATE_PARAMETERS( hash )
+
+  old_seed = hash->seed;
+  hash->seed = seed;
+  if( !SHopscotchRehash( hash, hash->capacity ) ){
+    hash->seed = old_seed;
+    return NULL;
+  }
+
+  return hash;
+}
+
+size_t
+SHopscotchSize
+( const shopscotch_t *hash )
+{
+  if( !hash )
+    return 0;
+
+  return hash->size;
+}
+
+static
+size_t
+SHopscotchFind
+( const shopscotch_t *hash, const void *key, size_t home )
+{
+  size_t offset, slot;
+  uint64_t hops;
+
+  for( hops = hash->hops[home], offset = 0; hops; hops >>= 1, offset++ ){
+    if( !( hops & 1 ) )
+      continue;
+
+    slot = ( home + offset ) % hash->capacity;
+    if( hash->compare_keys( key, hash->values[slot*2] ) == 0 )
+      return slot;
+  }
+
+  return hash->capacity;
+}
+
+static
+size_t
+SHopscotchHome
+( const shopscotch_t *hash, const void *key )
+{
+  return hash->fold( hash->hash( key, hash->seed ), hash->capacity );
+}
+
+static
+void *
+SHopscotchPlace
+( shopscotch_t *hash, void *key, void *value, size_t home )
+{
+  size_t bucket, distance = 0, empty = home, j, k, slot;
+
+  while( hash->values[empty*2] ){
+    empty = ( empty + 1 ) % hash->capacity;
+    if( ++distance == hash->capacity )
+      return NULL;
+  }
+
+  // hop the empty slot back until it is in the neighborhood of home
+  while( distance >= SHOPSCOTCH_NEIGHBORHOOD ){
+    for( j = SHOPSCOTCH_NEIGHBORHOOD - 1; j > 0; j-- ){
+      bucket = ( empty + hash->capacity - j ) % hash->capacity;
+      for( k = 0; k < j; k++ )
+        if( hash->hops[bucket] & ( (uint64_t) 1 << k ) )
+          break;
+
+      if( k < j )
+        break;
+    }
+
+    if( j == 0 )
+      return NULL;
+
+    slot = ( bucket + k ) % hash->capacity;
+    hash->values[empty*2] = hash->values[slot*2];
+    hash->values[empty*2+1] = hash->values[slot*2+1];
+    hash->values[slot*2] = hash->values[slot*2+1] = NULL;
+    hash->hops[bucket] |= (uint64_t) 1 << j;
+    hash->hops[bucket] &= ~( (uint64_t) 1 << k );
+
+    empty = slot;
+    distance -= j - k;
+  }
+
+  hash->values[empty*2] = key;
+  hash->values[empty*2+1] = value;
+  hash->hops[home] |= (uint64_t) 1 << distance;
+  hash->size++;
+
+  return value;
+}
+
+static
+shopscotch_t *
+SHopscotchRehash
+( shopscotch_t *hash, size_t capacity )
+{
+  size_t i;
+  shopscotch_t rehashed;
+
+  rehashed = *hash;
+  rehashed.capacity = capacity;
+  rehashed.size = 0;
+
+  rehashed.values = calloc( capacity * 2, sizeof( void * ) );
+  VALIDATE_ALLOCATION( rehashed.values )
+
+  rehashed.hops = calloc( capacity, sizeof( uint64_t ) );
+  VALIDATE_ALLOCATION_AND_FREE( rehashed.hops, rehashed.values )
+
+  for( i = 0; i < hash->capacity; i++ ){
+    if( !hash->values[i*2] )
+      continue;
+
+    if( !SHopscotchPlace( &rehashed, hash->values[i*2], hash->values[i*2+1],
+                          SHopscotchHome( &rehashed, hash->values[i*2] ) ) ){
+      free( rehashed.hops );
+      free( rehashed.values );
+      return NULL;
+    }
+  }
+
+  free( hash->hops );
+  free( hash->values );
+  *hash = rehashed;
+
+  return hash;
+}
@@ -0,0 +1,146 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+#include "lib/validate.h"
+#include "private/static/mpmcqueue.h"
+
+size_t
+SMPMCQueueCapacity
+( const smpmcqueue_t *queue )
+{
+  if( !queue )
+    return 0;
+
+  return queue->capacity;
+}
+
+void
+SMPMCQueueDestroy
+( const smpmcqueue_t *queue )
+{
+  if( queue ){
+    free( queue->cells );
+    free( (void *) queue );
+  }
+
+  return;
+}
+
+unsigned short
+SMPMCQueueIsEmpty
+( const smpmcqueue_t *queue )
+{
+  return SMPMCQueueSize( queue ) == 0;
+}
+
+smpmcqueue_t *
+SMPMCQueueNew
+( size_t capacity )
+{
+  size_t i, rounded = 2;
+  smpmcqueue_t *queue;
+
+  VALIDATE_PARAMETERS( capacity > 0 && capacity <= SIZE_MAX / 2 + 1 )
+
+  // with a single slot, the next lap's push would take the slot as free
+  while( rounded < capacity )
+    rounded <<= 1;
+
+  queue = malloc( sizeof( smpmcqueue_t ) );
+  VALIDATE_ALLOCATION( queue )
+
+  queue->cells = malloc( sizeof( struct smpmcqueue_cell_t ) * rounded );
+  VALIDATE_ALLOCATION_AND_FREE( queue->cells, queue )
+
+  for( i = 0; i < rounded; i++ )
+    SMPMCQUEUE_INIT( queue->cells[i].sequence, i );
+
+  queue->capacity = rounded;
+  queue->mask = rounded - 1;
+  SMPMCQUEUE_INIT( queue->back, 0 );
+  SMPMCQUEUE_INIT( queue->front, 0 );
+
+  return queue;
+}
+
+size_t
+SMPMCQueueSize
+( const smpmcqueue_t *queue )
+{
+  size_t back, front;
+
+  if( !queue )
+    return 0;
+
+  // a pop is only claimed after its push, so the back loaded last is never behind
+  front = SMPMCQUEUE_LOAD( ( (smpmcqueue_t *) queue )->front, acquire );
+  back = SMPMCQUEUE_LOAD( ( (smpmcqueue_t *) queue )->back, acquire );
+
+  return back - front > queue->capacity ? queue->capacity : back - front;
+}
+
+void *
+SMPMCQueueTryPop
+( smpmcqueue_t *queue )
+{
+  struct smpmcqueue_cell_t *cell;
+  intptr_t lag;
+  size_t position;
+  void *element;
+
+  VALIDATE_PARAMETERS( queue )
+
+  position = SMPMCQUEUE_LOAD( queue->front, relaxed );
+  for( ;; ){
+    cell = &queue->cells[position & queue->mask];
+    lag = (intptr_t) ( SMPMCQUEUE_LOAD( cell->sequence, acquire ) - ( position + 1 ) );
+
+    if( lag == 0 ){
+      // a failed claim loads the position another consumer left
+      if( SMPMCQUEUE_CLAIM( queue->front, position ) )
+        break;
+    } else if( lag < 0 ){
+      return NULL;
+    } else {
+      position = SMPMCQUEUE_LOAD( queue->front, relaxed );
+    }
+  }
+
+  element = cell->element;
+  SMPMCQUEUE_STORE( cell->sequence, position + queue->capacity );
+
+  return element;
+}
+
+smpmcqueue_t *
+SMPMCQueueTryPush
+( smpmcqueue_t *queue, void *element )
+{
+  struct smpmcqueue_cell_t *cell;
+  intptr_t lag;
+  size_t position;
+
+  VALIDATE_PARAMETERS( queue && element )
+
+  position = SMPMCQUEUE_LOAD( queue->back, relaxed );
+  for( ;; ){
+    cell = &queue->cells[position & queue->mask];
+    lag = (intptr_t) ( SMPMCQUEUE_LOAD( cell->sequence, acquire ) - position );
+
+    if( lag == 0 ){
+      if( SMPMCQUEUE_CLAIM( queue->back, position ) )
+        break;
+    } else if( lag < 0 ){
+      // the slot still holds the element pushed a lap ago
+      return NULL;
+    } else {
+      position = SMPMCQUEUE_LOAD( queue->back, relaxed );
+    }
+  }
+
+  cell->element = element;
+  SMPMCQUEUE_STORE( cell->sequence, position + 1 );
+
+  return queue;
+}
@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <woodpile/static/queue.h>
@@ -16,9 +17,9 @@ SQueueCopy
   VALIDATE_ALLOCATION( copy )
 
   copy->elements = malloc( sizeof( void * ) * original->capacity );
-  VALIDATE_ALLOCATION( copy )
+  VALIDATE_ALLOCATION_AND_FREE( copy->elements, copy )
 
-  memcpy( copy->elements, original->elements, original->capacity );
+  memcpy( copy->elements, original->elements, sizeof( void * ) * original->capacity );
 
   copy->back = original->back;
   copy->capacity = original->capacity;
@@ -43,26 +44,26 @@ SQueueDestroy
 SQueue *
 SQueueNew
 ( void )
+{
+  return SQueueNewSized( SQUEUE_DEFAULT_CAPACITY );
+}
+
+SQueue *
+SQueueNewSized
+( size_t capacity )
 {
   SQueue *queue = malloc( sizeof( SQueue ) );
   VALIDATE_ALLOCATION( queue )
 
   queue->front = queue->back = 0;
-  queue->capacity = 100;
+  queue->capacity = SQueueRoundCapacity( capacity );
 
   queue->elements = malloc( sizeof( void * ) * queue->capacity );
-  VALIDATE_ALLOCATION( queue->elements )
+  VALIDATE_ALLOCATION_AND_FREE( queue->elements, queue )
 
   return queue;
 }
 
-SQueue *
-SQueueNewSized
-( size_t capacity )
-{
-  return NULL;
-}
-
 void *
 SQueuePeek
 ( const SQueue *queue )
@@ -70,41 +71,89 @@ SQueuePeek
   if( SQueueIsEmpty( queue ) )
     return NULL;
   else
-    return queue->elements[ queue->front ];
+    return queue->elements[queue->front & ( queue->capacity - 1 )];
 }
 
 void *
 SQueuePop
 ( SQueue *queue )
 {
-  void *value;
-
   VALIDATE_PARAMETERS( queue && queue->elements )
 
   if( queue->front == queue->back )
     return NULL;
 
-  value = queue->elements[ queue->front ];
+  return queue->elements[queue->front++ & ( queue->capacity - 1 )];
+}
+
+size_t
+SQueuePopN
+( SQueue *queue, void **out, size_t max )
+{
+  size_t count, first, start;
+
+  if( !queue || !out )
+    return 0;
+
+  count = queue->back - queue->front;
+  if( count > max )
+    count = max;
+
+  start = queue->front & ( queue->capacity - 1 );
+  first = queue->capacity - start;
+  if( first > count )
+    first = count;
 
-  queue->front = (queue->front + 1) % queue->capacity;
+  memcpy( out, queue->elements + start, sizeof( void * ) * first );
+  memcpy( out + first, queue->elements, sizeof( void * ) * ( count - first ) );
+  queue->front += count;
 
-  return value;
+  return count;
 }
 
 SQueue *
 SQueuePush
 ( SQueue *queue, void *element )
 {
-  size_t new_back;
-
   VALIDATE_PARAMETERS( queue && element )
 
-  new_back = (queue->back + 1) % queue->capacity;
-  if( new_back == queue->front )
-    return NULL;
+  if( queue->back - queue->front == queue->capacity )
+    if( !SQueueResize( queue, queue->capacity * 2 ) )
+      return NULL;
+
+  queue->elements[queue->back++ & ( queue->capacity - 1 )] = element;
+
+  return queue;
+}
+
+SQueue *
+SQueuePushN
+( SQueue *queue, void **elements, size_t count )
+{
+  size_t capacity, first, i, needed, start;
+
+  VALIDATE_PARAMETERS( queue && ( elements || count == 0 ) )
+  for( i = 0; i < count; i++ )
+    VALIDATE_PARAMETERS( elements[i] )
+
+  needed = queue->back - queue->front + count;
+  if( needed > queue->capacity ){
+    capacity = queue->capacity * 2;
+    if( capacity < needed )
+      capacity = SQueueRoundCapacity( needed );
+
+    if( !SQueueResize( queue, capacity ) )
+      return NULL;
+  }
+
+  start = queue->back & ( queue->capacity - 1 );
+  first = queue->capacity - start;
+  if( first > count )
+    first = count;
 
-  queue->elements[ queue->back ] = element;
-  queue->back = new_back;
+  memcpy( queue->elements + start, elements, sizeof( void * ) * first );
+  memcpy( queue->elements, elements + first, sizeof( void * ) * ( count - first ) );
+  queue->back += count;
 
   return queue;
 }
@@ -113,7 +162,10 @@ size_t
 SQueueCapacity
 ( const SQueue *queue )
 {
-  return 0;
+  if( !queue )
+    return 0;
+
+  return queue->capacity;
 }
 
 size_t
@@ -125,14 +177,10 @@ SQueueContains
   if( SQueueIsEmpty( queue ) )
     return 0;
 
-  current = queue->front;
-  while( current != queue->back ){
-    if( queue->elements[current] == element )
+  for( current = queue->front; current != queue->back; current++ )
+    if( queue->elements[current & ( queue->capacity - 1 )] == element )
       count++;
 
-    current = ( current + 1 ) % queue->capacity;
-  }
-
   return count;
 }
 
@@ -149,10 +197,8 @@ SQueueSize
 {
   if( !queue )
     return 0;
-  if( queue->back >= queue->front )
-    return queue->back - queue->front;
-  else
-    return queue->back + queue->capacity - queue->front;
+
+  return queue->back - queue->front;
 }
 
 char *
@@ -166,28 +212,24 @@ void *
 SQueueRemove
 ( SQueue *queue, const void *value )
 {
-  size_t current;
+  size_t current, mask;
   void *queue_value;
 
   if( SQueueIsEmpty( queue ) )
     return NULL;
 
-  current = queue->front;
-  while( current != queue->back ){
-    queue_value = queue->elements[current];
+  mask = queue->capacity - 1;
+  for( current = queue->front; current != queue->back; current++ ){
+    queue_value = queue->elements[current & mask];
 
     if( queue_value == value ){
-      queue->back = queue->back == 0 ? queue->capacity - 1 : queue->back - 1;
+      queue->back--;
 
-      while( current != queue->back ){
-        queue->elements[current] = queue->elements[( current + 1 ) % queue->capacity];
-        current = (current + 1 ) % queue->capacity;
-      }
+      for( ; current != queue->back; current++ )
+        queue->elements[current & mask] = queue->elements[( current + 1 ) & mask];
 
       return queue_value;
     }
-
-    current = ( current + 1 ) % queue->capacity;
   }
 
   return NULL;
@@ -197,12 +239,70 @@ SQueue *
 SQueueSetCapacity
 ( SQueue *queue, size_t capacity )
 {
-  return NULL;
+  VALIDATE_PARAMETERS( queue )
+
+  capacity = SQueueRoundCapacity( capacity );
+  if( capacity == queue->capacity )
+    return queue;
+
+  return SQueueResize( queue, capacity );
 }
 
 size_t
 SQueueTrimToSize
 ( SQueue *queue )
 {
-  return 0;
+  if( !queue )
+    return 0;
+
+  SQueueSetCapacity( queue, SQueueSize( queue ) );
+
+  return queue->capacity;
+}
+
+static
+size_t
+SQueueRoundCapacity
+( size_t capacity )
+{
+  size_t rounded = 1;
+
+  // past the top power of two the allocation fails anyway
+  while( rounded < capacity && rounded <= SIZE_MAX / 2 )
+    rounded <<= 1;
+
+  return rounded;
+}
+
+static
+SQueue *
+SQueueResize
+( SQueue *queue, size_t capacity )
+{
+  size_t first, size, start;
+  void **elements;
+
+  size = queue->back - queue->front;
+  if( size > capacity )
+    size = capacity;
+
+  elements = malloc( sizeof( void * ) * capacity );
+  VALIDATE_ALLOCATION( elements )
+
+  // the elements run from start to the end of the array, then wrap to the start
+  start = queue->front & ( queue->capacity - 1 );
+  first = queue->capacity - start;
+  if( first > size )
+    first = size;
+
+  memcpy( elements, queue->elements + start, sizeof( void * ) * first );
+  memcpy( elements + first, queue->elements, sizeof( void * ) * ( size - first ) );
+
+  free( queue->elements );
+  queue->back = size;
+  queue->capacity = capacity;
+  queue->elements = elements;
+  queue->front = 0;
+
+  return queue;
 }
@@ -0,0 +1,148 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <woodpile/config.h>
+#include <woodpile/static/spscqueue.h>
+#include "lib/validate.h"
+#include "private/static/spscqueue.h"
+
+size_t
+SSPSCQueueCapacity
+( const sspscqueue_t *queue )
+{
+  if( !queue )
+    return 0;
+
+  return queue->capacity;
+}
+
+void
+SSPSCQueueDestroy
+( const sspscqueue_t *queue )
+{
+  if( queue ){
+    free( queue->elements );
+    free( (void *) queue );
+  }
+
+  return;
+}
+
+unsigned short
+SSPSCQueueIsEmpty
+( const sspscqueue_t *queue )
+{
+  return SSPSCQueueSize( queue ) == 0;
+}
+
+sspscqueue_t *
+SSPSCQueueNew
+( size_t capacity )
+{
+  size_t rounded = 1;
+  sspscqueue_t *queue;
+
+  VALIDATE_PARAMETERS( capacity > 0 && capacity <= SIZE_MAX / 2 + 1 )
+
+  while( rounded < capacity )
+    rounded <<= 1;
+
+  queue = malloc( sizeof( sspscqueue_t ) );
+  VALIDATE_ALLOCATION( queue )
+
+  queue->elements = malloc( sizeof( void * ) * rounded );
+  VALIDATE_ALLOCATION_AND_FREE( queue->elements, queue )
+
+  queue->capacity = rounded;
+  queue->mask = rounded - 1;
+  queue->back.other = queue->front.other = 0;
+
+#ifdef __WOODPILE_HAVE_STDATOMIC_H
+  atomic_init( &queue->back.index, 0 );
+  atomic_init( &queue->front.index, 0 );
+#else
+  queue->back.index = queue->front.index = 0;
+#endif
+
+  return queue;
+}
+
+void *
+SSPSCQueuePeek
+( sspscqueue_t *queue )
+{
+  size_t front;
+
+  VALIDATE_PARAMETERS( queue )
+
+  front = SSPSCQUEUE_LOAD( queue->front.index, relaxed );
+
+  if( front == queue->front.other ){
+    queue->front.other = SSPSCQUEUE_LOAD( queue->back.index, acquire );
+    if( front == queue->front.other )
+      return NULL;
+  }
+
+  return queue->elements[front & queue->mask];
+}
+
+void *
+SSPSCQueuePop
+( sspscqueue_t *queue )
+{
+  size_t front;
+  void *element;
+
+  VALIDATE_PARAMETERS( queue )
+
+  // only this side writes the front, so it can be read without ordering
+  front = SSPSCQUEUE_LOAD( queue->front.index, relaxed );
+
+  if( front == queue->front.other ){
+    queue->front.other = SSPSCQUEUE_LOAD( queue->back.index, acquire );
+    if( front == queue->front.other )
+      return NULL;
+  }
+
+  element = queue->elements[front & queue->mask];
+  SSPSCQUEUE_STORE( queue->front.index, front + 1 );
+
+  return element;
+}
+
+sspscqueue_t *
+SSPSCQueuePush
+( sspscqueue_t *queue, void *element )
+{
+  size_t back;
+
+  VALIDATE_PARAMETERS( queue && element )
+
+  back = SSPSCQUEUE_LOAD( queue->back.index, relaxed );
+
+  if( back - queue->back.other == queue->capacity ){
+    queue->back.other = SSPSCQUEUE_LOAD( queue->front.index, acquire );
+    if( back - queue->back.other == queue->capacity )
+      return NULL;
+  }
+
+  queue->elements[back & queue->mask] = element;
+  SSPSCQUEUE_STORE( queue->back.index, back + 1 );
+
+  return queue;
+}
+
+size_t
+SSPSCQueueSize
+( const sspscqueue_t *queue )
+{
+  size_t back, front;
+
+  if( !queue )
+    return 0;
+
+  // the front is loaded first so that it can never pass the back loaded after
+  front = SSPSCQUEUE_LOAD( ( (sspscqueue_t *) queue )->front.index, acquire );
+  back = SSPSCQUEUE_LOAD( ( (sspscqueue_t *) queue )->back.index, acquire );
+
+  return back - front;
+}
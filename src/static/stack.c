@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <string.h>
 #include <woodpile/static/stack.h>
 #include "lib/validate.h"
 #include "private/static/stack.h"
@@ -86,6 +87,22 @@ SStackPop
     return stack->values[--stack->top];
 }
 
+size_t
+SStackPopN
+( SStack *stack, void **out, size_t max )
+{
+  size_t count;
+
+  if( !stack || !out )
+    return 0;
+
+  count = stack->top < max ? stack->top : max;
+  stack->top -= count;
+  memcpy( out, stack->values + stack->top, sizeof( void * ) * count );
+
+  return count;
+}
+
 SStack *
 SStackPush
 ( SStack *stack, void *value )
@@ -93,7 +110,7 @@ SStackPush
   VALIDATE_PARAMETERS( stack )
 
   if( stack->top == stack->capacity )
-    if( !Resize( stack ) )
+    if( !Resize( stack, stack->capacity * 2 ) )
       return NULL;
 
   stack->values[stack->top++] = value;
@@ -101,6 +118,29 @@ SStackPush
   return stack;
 }
 
+SStack *
+SStackPushN
+( SStack *stack, void **values, size_t count )
+{
+  size_t capacity;
+
+  VALIDATE_PARAMETERS( stack && ( values || count == 0 ) )
+
+  if( stack->top + count > stack->capacity ){
+    capacity = stack->capacity * 2;
+    if( capacity < stack->top + count )
+      capacity = stack->top + count;
+
+    if( !Resize( stack, capacity ) )
+      return NULL;
+  }
+
+  memcpy( stack->values + stack->top, values, sizeof( void * ) * count );
+  stack->top += count;
+
+  return stack;
+}
+
 SStack *
 SStackSetCapacity
 ( SStack *stack, size_t capacity )
@@ -152,22 +192,19 @@ SStackToString
 static
 SStack *
 Resize
-( SStack *stack )
+( SStack *stack, size_t capacity )
 {
-  unsigned i;
   void **new_array;
 
   VALIDATE_PARAMETERS( stack )
 
-  stack->capacity *= 2;
-
-  new_array = malloc( sizeof( void * ) * stack->capacity );
+  new_array = malloc( sizeof( void * ) * capacity );
   VALIDATE_ALLOCATION( new_array )
 
-  for( i = 0; i < stack->top; i++ )
-    new_array[i] = stack->values[i];
+  memcpy( new_array, stack->values, sizeof( void * ) * stack->top );
 
   free( stack->values );
+  stack->capacity = capacity;
   stack->values = new_array;
 
   return stack;
@@ -0,0 +1,436 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hash.h>
+#include <woodpile/static/tinylfu.h>
+#include "lib/validate.h"
+#include "private/static/tinylfu.h"
+
+size_t
+STinyLFUCapacity
+( const stinylfu_t *cache )
+{
+  if( !cache )
+    return 0;
+
+  return cache->capacity;
+}
+
+void
+STinyLFUDestroy
+( const stinylfu_t *cache )
+{
+  size_t i;
+  unsigned region;
+
+  if( cache ){
+    if( cache->evict )
+      for( region = 0; region < STINYLFU_REGIONS; region++ )
+        for( i = cache->regions[region].oldest; i != STINYLFU_NONE; i = cache->entries[i].newer )
+          cache->evict( cache->entries[i].key, cache->entries[i].value, cache->context );
+
+    SHashDestroy( cache->index );
+    free( cache->entries );
+    free( cache->sketch );
+    free( (void *) cache );
+  }
+
+  return;
+}
+
+unsigned
+STinyLFUFrequency
+( const stinylfu_t *cache, const void *key )
+{
+  unsigned count, least = STINYLFU_MAX_COUNT, row;
+  size_t column;
+  unsigned long long hash;
+
+  if( !cache || !key )
+    return 0;
+
+  hash = cache->hash( key, cache->seed );
+  for( row = 0; row < STINYLFU_ROWS; row++ ){
+    column = STinyLFUColumn( cache, hash, row );
+    count = ( cache->sketch[row * cache->sketch_words + ( column >> 4 )] >> ( ( column & 15 ) * 4 ) ) & 0xf;
+    if( count < least )
+      least = count;
+  }
+
+  return least;
+}
+
+void *
+STinyLFUGet
+( stinylfu_t *cache, const void *key )
+{
+  struct stinylfu_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  STinyLFUIncrement( cache, key );
+
+  entry = SHashGet( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  STinyLFUTouch( cache, (size_t) ( entry - cache->entries ) );
+
+  return entry->value;
+}
+
+unsigned short
+STinyLFUIsEmpty
+( const stinylfu_t *cache )
+{
+  return cache == NULL || STinyLFUSize( cache ) == 0;
+}
+
+stinylfu_t *
+STinyLFUNew
+( size_t capacity )
+{
+  stinylfu_t *cache;
+  size_t columns = 16, i, main;
+  unsigned region;
+
+  VALIDATE_PARAMETERS( capacity > 0 )
+
+  cache = malloc( sizeof( stinylfu_t ) );
+  VALIDATE_ALLOCATION( cache )
+
+  // one spare entry holds a new key while the window makes room for it
+  cache->entries = malloc( ( capacity + 1 ) * sizeof( struct stinylfu_entry_t ) );
+  VALIDATE_ALLOCATION_AND_FREE( cache->entries, cache )
+
+  cache->sketch_shift = 60;
+  while( columns < capacity ){
+    columns <<= 1;
+    cache->sketch_shift--;
+  }
+
+  cache->sketch = calloc( STINYLFU_ROWS * ( columns / 16 ), sizeof( uint64_t ) );
+  if( !cache->sketch ){
+    free( cache->entries );
+    free( cache );
+    return NULL;
+  }
+
+  // the index is kept at most half full so that probes stay short
+  cache->index = SHashNewSized( capacity * 2 );
+  if( !cache->index || !SHashSetFolder( cache->index, ModFold ) ){
+    SHashDestroy( cache->index );
+    free( cache->sketch );
+    free( cache->entries );
+    free( cache );
+    return NULL;
+  }
+
+  for( i = 0; i <= capacity; i++ )
+    cache->entries[i].older = i < capacity ? i + 1 : STINYLFU_NONE;
+
+  for( region = 0; region < STINYLFU_REGIONS; region++ ){
+    cache->regions[region].newest = cache->regions[region].oldest = STINYLFU_NONE;
+    cache->regions[region].size = 0;
+  }
+
+  main = capacity - ( capacity < 200 ? 1 : capacity / 100 );
+  cache->regions[STINYLFU_WINDOW].capacity = capacity - main;
+  cache->regions[STINYLFU_PROBATION].capacity = main - main * 4 / 5;
+  cache->regions[STINYLFU_PROTECTED].capacity = main * 4 / 5;
+
+  cache->additions = 0;
+  cache->capacity = capacity;
+  cache->context = NULL;
+  cache->evict = NULL;
+  cache->free = 0;
+  cache->hash = MixedPointerHash;
+  cache->sample_size = columns * 10;
+  cache->seed = time( NULL );
+  cache->sketch_words = columns / 16;
+
+  return cache;
+}
+
+void *
+STinyLFUPeek
+( const stinylfu_t *cache, const void *key )
+{
+  struct stinylfu_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashGet( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  return entry->value;
+}
+
+void *
+STinyLFUPut
+( stinylfu_t *cache, void *key, void *value )
+{
+  size_t candidate, i, victim;
+  struct stinylfu_list_t *main;
+  struct stinylfu_entry_t *entry;
+  void *result;
+
+  if( !value )
+    return STinyLFURemove( cache, key );
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  STinyLFUIncrement( cache, key );
+
+  entry = SHashGet( cache->index, key );
+  if( entry ){
+    result = entry->value;
+    entry->key = key;
+    entry->value = value;
+
+    // the index keeps the key it was given, which may be an equal copy
+    SHashPut( cache->index, key, entry );
+    STinyLFUTouch( cache, (size_t) ( entry - cache->entries ) );
+
+    return result;
+  }
+
+  i = cache->free;
+  cache->entries[i].key = key;
+  cache->entries[i].value = value;
+  if( !SHashPut( cache->index, key, &cache->entries[i] ) )
+    return NULL;
+
+  cache->free = cache->entries[i].older;
+  STinyLFULink( cache, i, STINYLFU_WINDOW );
+
+  if( cache->regions[STINYLFU_WINDOW].size <= cache->regions[STINYLFU_WINDOW].capacity )
+    return value;
+
+  candidate = cache->regions[STINYLFU_WINDOW].oldest;
+  STinyLFUUnlink( cache, candidate );
+
+  main = cache->regions;
+  if( main[STINYLFU_PROBATION].size + main[STINYLFU_PROTECTED].size
+      < main[STINYLFU_PROBATION].capacity + main[STINYLFU_PROTECTED].capacity ){
+    STinyLFULink( cache, candidate, STINYLFU_PROBATION );
+    return value;
+  }
+
+  victim = main[STINYLFU_PROBATION].oldest;
+  if( victim == STINYLFU_NONE )
+    victim = main[STINYLFU_PROTECTED].oldest;
+
+  // ties go to the victim, so that keys seen only once never displace it
+  if( victim == STINYLFU_NONE
+      || STinyLFUFrequency( cache, cache->entries[candidate].key )
+         <= STinyLFUFrequency( cache, cache->entries[victim].key ) ){
+    STinyLFUEvict( cache, candidate );
+    return value;
+  }
+
+  STinyLFUUnlink( cache, victim );
+  STinyLFUEvict( cache, victim );
+  STinyLFULink( cache, candidate, STINYLFU_PROBATION );
+
+  return value;
+}
+
+void *
+STinyLFURemove
+( stinylfu_t *cache, const void *key )
+{
+  size_t i;
+  struct stinylfu_entry_t *entry;
+
+  VALIDATE_PARAMETERS( cache && key )
+
+  entry = SHashRemove( cache->index, key );
+  if( !entry )
+    return NULL;
+
+  i = (size_t) ( entry - cache->entries );
+  STinyLFUUnlink( cache, i );
+  entry->older = cache->free;
+  cache->free = i;
+
+  return entry->value;
+}
+
+stinylfu_t *
+STinyLFUSetEvictor
+( stinylfu_t *cache, void ( *evict )( void *, void *, void * ), void *context )
+{
+  VALIDATE_PARAMETERS( cache )
+
+  cache->context = context;
+  cache->evict = evict;
+
+  return cache;
+}
+
+stinylfu_t *
+STinyLFUSetHasher
+( stinylfu_t *cache, hasher_t hasher )
+{
+  VALIDATE_PARAMETERS( cache && hasher )
+
+  if( !SHashSetHasher( cache->index, hasher ) )
+    return NULL;
+
+  cache->additions = 0;
+  cache->hash = hasher;
+  memset( cache->sketch, 0, STINYLFU_ROWS * cache->sketch_words * sizeof( uint64_t ) );
+
+  return cache;
+}
+
+stinylfu_t *
+STinyLFUSetKeyComparator
+( stinylfu_t *cache, comparator_t comparator )
+{
+  VALIDATE_PARAMETERS( cache && comparator )
+
+  if( !SHashSetKeyComparator( cache->index, comparator ) )
+    return NULL;
+
+  return cache;
+}
+
+size_t
+STinyLFUSize
+( const stinylfu_t *cache )
+{
+  if( !cache )
+    return 0;
+
+  return cache->regions[STINYLFU_WINDOW].size
+         + cache->regions[STINYLFU_PROBATION].size
+         + cache->regions[STINYLFU_PROTECTED].size;
+}
+
+static
+size_t
+STinyLFUColumn
+( const stinylfu_t *cache, unsigned long long hash, unsigned row )
+{
+  // each row remixes the hash, so that keys sharing a column in one row are
+  // unlikely to share one in the others
+  hash += row * 0x9e3779b97f4a7c15ULL;
+  hash = ( hash ^ ( hash >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+  hash = ( hash ^ ( hash >> 27 ) ) * 0x94d049bb133111ebULL;
+
+  return (size_t) ( hash >> cache->sketch_shift );
+}
+
+static
+void
+STinyLFUEvict
+( stinylfu_t *cache, size_t entry )
+{
+  SHashRemove( cache->index, cache->entries[entry].key );
+  cache->entries[entry].older = cache->free;
+  cache->free = entry;
+
+  if( cache->evict )
+    cache->evict( cache->entries[entry].key, cache->entries[entry].value, cache->context );
+}
+
+static
+void
+STinyLFUIncrement
+( stinylfu_t *cache, const void *key )
+{
+  size_t i, words = STINYLFU_ROWS * cache->sketch_words;
+  unsigned counted = 0, row, shift;
+  size_t column;
+  unsigned long long hash;
+  uint64_t *word;
+
+  hash = cache->hash( key, cache->seed );
+  for( row = 0; row < STINYLFU_ROWS; row++ ){
+    column = STinyLFUColumn( cache, hash, row );
+    word = &cache->sketch[row * cache->sketch_words + ( column >> 4 )];
+    shift = ( column & 15 ) * 4;
+    if( ( ( *word >> shift ) & 0xf ) < STINYLFU_MAX_COUNT ){
+      *word += (uint64_t) 1 << shift;
+      counted = 1;
+    }
+  }
+
+  if( counted && ++cache->additions == cache->sample_size ){
+    // halve every counter at once, dropping the bit shifted into each neighbor
+    for( i = 0; i < words; i++ )
+      cache->sketch[i] = ( cache->sketch[i] >> 1 ) & 0x7777777777777777ULL;
+
+    cache->additions /= 2;
+  }
+}
+
+static
+void
+STinyLFULink
+( stinylfu_t *cache, size_t entry, unsigned region )
+{
+  struct stinylfu_list_t *list = &cache->regions[region];
+
+  cache->entries[entry].newer = STINYLFU_NONE;
+  cache->entries[entry].older = list->newest;
+  cache->entries[entry].region = region;
+
+  if( list->newest == STINYLFU_NONE )
+    list->oldest = entry;
+  else
+    cache->entries[list->newest].newer = entry;
+
+  list->newest = entry;
+  list->size++;
+}
+
+static
+void
+STinyLFUTouch
+( stinylfu_t *cache, size_t entry )
+{
+  size_t demoted;
+  unsigned region = cache->entries[entry].region;
+
+  if( region == STINYLFU_PROBATION )
+    region = STINYLFU_PROTECTED;
+  else if( entry == cache->regions[region].newest )
+    return;
+
+  STinyLFUUnlink( cache, entry );
+  STinyLFULink( cache, entry, region );
+
+  if( cache->regions[STINYLFU_PROTECTED].size > cache->regions[STINYLFU_PROTECTED].capacity ){
+    demoted = cache->regions[STINYLFU_PROTECTED].oldest;
+    STinyLFUUnlink( cache, demoted );
+    STinyLFULink( cache, demoted, STINYLFU_PROBATION );
+  }
+}
+
+static
+void
+STinyLFUUnlink
+( stinylfu_t *cache, size_t entry )
+{
+  struct stinylfu_list_t *list = &cache->regions[cache->entries[entry].region];
+  size_t newer = cache->entries[entry].newer, older = cache->entries[entry].older;
+
+  if( newer == STINYLFU_NONE )
+    list->newest = older;
+  else
+    cache->entries[newer].older = older;
+
+  if( older == STINYLFU_NONE )
+    list->oldest = newer;
+  else
+    cache->entries[older].newer = newer;
+
+  list->size--;
+}
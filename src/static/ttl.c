@@ -0,0 +1,394 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <woodpile/comparator.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hash.h>
+#include <woodpile/static/ttl.h>
+#include "lib/validate.h"
+#include "private/static/ttl.h"
+
+size_t
+STTLAdvance
+( sttl_t *ttl, unsigned long long now, size_t budget )
+{
+  size_t entry, expired = 0, work = 0;
+
+  if( !ttl )
+    return 0;
+
+  if( now > ttl->now )
+    ttl->now = now;
+
+  // one turn of the wheel visits every slot, so older ticks need no sweep
+  if( ttl->cursor == STTL_START && ttl->tick < ttl->now && ttl->now - ttl->tick > ttl->mask )
+    ttl->tick = ttl->now - ttl->mask;
+
+  while( ttl->tick <= ttl->now && work < budget ){
+    if( ttl->cursor == STTL_START ){
+      ttl->cursor = ttl->slots[ttl->tick & ttl->mask].first;
+      work++;
+    }
+
+    while( ttl->cursor != STTL_NONE && work < budget ){
+      entry = ttl->cursor;
+      ttl->cursor = ttl->entries[entry].next;
+      work++;
+
+      // later turns of the wheel share the slot, and are left for then
+      if( ttl->entries[entry].deadline <= ttl->now ){
+        STTLExpire( ttl, entry );
+        expired++;
+      }
+    }
+
+    if( ttl->cursor == STTL_NONE ){
+      ttl->cursor = STTL_START;
+      ttl->tick++;
+    }
+  }
+
+  return expired;
+}
+
+size_t
+STTLCapacity
+( const sttl_t *ttl )
+{
+  if( !ttl )
+    return 0;
+
+  return ttl->capacity;
+}
+
+unsigned long long
+STTLDeadline
+( const sttl_t *ttl, const void *key )
+{
+  size_t entry;
+
+  if( !ttl || !key )
+    return 0;
+
+  entry = STTLFind( ttl, key );
+  if( entry == STTL_NONE || ttl->entries[entry].deadline <= ttl->now )
+    return 0;
+
+  return ttl->entries[entry].deadline;
+}
+
+void
+STTLDestroy
+( const sttl_t *ttl )
+{
+  size_t entry, slot;
+
+  if( ttl ){
+    if( ttl->evict )
+      for( slot = 0; slot <= ttl->mask; slot++ )
+        for( entry = ttl->slots[slot].first; entry != STTL_NONE; entry = ttl->entries[entry].next )
+          ttl->evict( ttl->entries[entry].key, ttl->entries[entry].value, ttl->context );
+
+    SHashDestroy( ttl->index );
+    free( ttl->entries );
+    free( ttl->slots );
+    free( (void *) ttl );
+  }
+
+  return;
+}
+
+void *
+STTLGet
+( sttl_t *ttl, const void *key )
+{
+  size_t entry;
+
+  VALIDATE_PARAMETERS( ttl && key )
+
+  entry = STTLFind( ttl, key );
+  if( entry == STTL_NONE )
+    return NULL;
+
+  if( ttl->entries[entry].deadline <= ttl->now ){
+    STTLExpire( ttl, entry );
+    return NULL;
+  }
+
+  return ttl->entries[entry].value;
+}
+
+unsigned short
+STTLIsEmpty
+( const sttl_t *ttl )
+{
+  return ttl == NULL || ttl->size == 0;
+}
+
+sttl_t *
+STTLNew
+( size_t capacity, size_t slots )
+{
+  size_t i, slot_count = 1;
+  sttl_t *ttl;
+
+  VALIDATE_PARAMETERS( capacity > 0 && slots > 0 )
+
+  while( slot_count < slots )
+    slot_count <<= 1;
+
+  ttl = malloc( sizeof( sttl_t ) );
+  VALIDATE_ALLOCATION( ttl )
+
+  ttl->entries = malloc( capacity * sizeof( struct sttl_entry_t ) );
+  VALIDATE_ALLOCATION_AND_FREE( ttl->entries, ttl )
+
+  ttl->slots = malloc( slot_count * sizeof( struct sttl_slot_t ) );
+  if( !ttl->slots ){
+    free( ttl->entries );
+    free( ttl );
+    return NULL;
+  }
+
+  // the index is kept at most half full so that probes stay short
+  ttl->index = SHashNewSized( capacity * 2 );
+  if( !ttl->index || !SHashSetFolder( ttl->index, ModFold ) ){
+    SHashDestroy( ttl->index );
+    free( ttl->slots );
+    free( ttl->entries );
+    free( ttl );
+    return NULL;
+  }
+
+  for( i = 0; i < capacity; i++ )
+    ttl->entries[i].next = i + 1 < capacity ? i + 1 : STTL_NONE;
+
+  for( i = 0; i < slot_count; i++ )
+    ttl->slots[i].first = ttl->slots[i].last = STTL_NONE;
+
+  ttl->capacity = capacity;
+  ttl->context = NULL;
+  ttl->cursor = STTL_START;
+  ttl->evict = NULL;
+  ttl->free = 0;
+  ttl->mask = slot_count - 1;
+  ttl->now = 0;
+  ttl->size = 0;
+  ttl->tick = 1;
+
+  return ttl;
+}
+
+unsigned long long
+STTLNow
+( const sttl_t *ttl )
+{
+  if( !ttl )
+    return 0;
+
+  return ttl->now;
+}
+
+void *
+STTLPut
+( sttl_t *ttl, void *key, void *value, unsigned long long lifetime )
+{
+  size_t entry;
+  void *result;
+
+  if( !value )
+    return STTLRemove( ttl, key );
+
+  VALIDATE_PARAMETERS( ttl && key && lifetime > 0 )
+
+  entry = STTLFind( ttl, key );
+  if( entry != STTL_NONE && ttl->entries[entry].deadline <= ttl->now ){
+    STTLExpire( ttl, entry );
+    entry = STTL_NONE;
+  }
+
+  if( entry != STTL_NONE ){
+    result = ttl->entries[entry].value;
+    STTLUnlink( ttl, entry );
+  } else {
+    if( ttl->free == STTL_NONE )
+      return NULL;
+
+    entry = ttl->free;
+    if( !SHashPut( ttl->index, key, (void *) (uintptr_t) ( entry + 1 ) ) )
+      return NULL;
+
+    ttl->free = ttl->entries[entry].next;
+    ttl->size++;
+    result = value;
+  }
+
+  ttl->entries[entry].deadline = ttl->now + lifetime;
+  ttl->entries[entry].key = key;
+  ttl->entries[entry].value = value;
+  STTLLink( ttl, entry );
+
+  return result;
+}
+
+void *
+STTLRemove
+( sttl_t *ttl, const void *key )
+{
+  size_t entry;
+
+  VALIDATE_PARAMETERS( ttl && key )
+
+  entry = STTLFind( ttl, key );
+  if( entry == STTL_NONE )
+    return NULL;
+
+  if( ttl->entries[entry].deadline <= ttl->now ){
+    STTLExpire( ttl, entry );
+    return NULL;
+  }
+
+  STTLUnlink( ttl, entry );
+  SHashRemove( ttl->index, key );
+  ttl->entries[entry].next = ttl->free;
+  ttl->free = entry;
+  ttl->size--;
+
+  return ttl->entries[entry].value;
+}
+
+sttl_t *
+STTLSetCapacity
+( sttl_t *ttl, size_t capacity )
+{
+  size_t i;
+  struct sttl_entry_t *entries;
+
+  VALIDATE_PARAMETERS( ttl && capacity >= ttl->capacity )
+
+  if( !SHashSetCapacity( ttl->index, capacity * 2 ) )
+    return NULL;
+
+  // the index holds entry numbers rather than addresses, so it survives this
+  entries = realloc( ttl->entries, capacity * sizeof( struct sttl_entry_t ) );
+  VALIDATE_ALLOCATION( entries )
+
+  for( i = capacity; i > ttl->capacity; i-- ){
+    entries[i-1].next = ttl->free;
+    ttl->free = i - 1;
+  }
+
+  ttl->capacity = capacity;
+  ttl->entries = entries;
+
+  return ttl;
+}
+
+sttl_t *
+STTLSetEvictor
+( sttl_t *ttl, void ( *evict )( void *, void *, void * ), void *context )
+{
+  VALIDATE_PARAMETERS( ttl )
+
+  ttl->context = context;
+  ttl->evict = evict;
+
+  return ttl;
+}
+
+sttl_t *
+STTLSetHasher
+( sttl_t *ttl, hasher_t hasher )
+{
+  VALIDATE_PARAMETERS( ttl && hasher )
+
+  if( !SHashSetHasher( ttl->index, hasher ) )
+    return NULL;
+
+  return ttl;
+}
+
+sttl_t *
+STTLSetKeyComparator
+( sttl_t *ttl, comparator_t comparator )
+{
+  VALIDATE_PARAMETERS( ttl && comparator )
+
+  if( !SHashSetKeyComparator( ttl->index, comparator ) )
+    return NULL;
+
+  return ttl;
+}
+
+size_t
+STTLSize
+( const sttl_t *ttl )
+{
+  if( !ttl )
+    return 0;
+
+  return ttl->size;
+}
+
+static
+void
+STTLExpire
+( sttl_t *ttl, size_t entry )
+{
+  STTLUnlink( ttl, entry );
+  SHashRemove( ttl->index, ttl->entries[entry].key );
+  ttl->entries[entry].next = ttl->free;
+  ttl->free = entry;
+  ttl->size--;
+
+  if( ttl->evict )
+    ttl->evict( ttl->entries[entry].key, ttl->entries[entry].value, ttl->context );
+}
+
+static
+size_t
+STTLFind
+( const sttl_t *ttl, const void *key )
+{
+  // a missing key gives NULL, which comes out as STTL_NONE
+  return (size_t) (uintptr_t) SHashGet( ttl->index, key ) - 1;
+}
+
+static
+void
+STTLLink
+( sttl_t *ttl, size_t entry )
+{
+  struct sttl_slot_t *slot = &ttl->slots[ttl->entries[entry].deadline & ttl->mask];
+
+  ttl->entries[entry].next = STTL_NONE;
+  ttl->entries[entry].previous = slot->last;
+
+  if( slot->last == STTL_NONE )
+    slot->first = entry;
+  else
+    ttl->entries[slot->last].next = entry;
+
+  slot->last = entry;
+}
+
+static
+void
+STTLUnlink
+( sttl_t *ttl, size_t entry )
+{
+  struct sttl_slot_t *slot = &ttl->slots[ttl->entries[entry].deadline & ttl->mask];
+  size_t next = ttl->entries[entry].next, previous = ttl->entries[entry].previous;
+
+  if( ttl->cursor == entry )
+    ttl->cursor = next;
+
+  if( next == STTL_NONE )
+    slot->last = previous;
+  else
+    ttl->entries[next].previous = previous;
+
+  if( previous == STTL_NONE )
+    slot->first = next;
+  else
+    ttl->entries[previous].next = next;
+}
@@ -0,0 +1,228 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+#include "lib/validate.h"
+#include "private/static/wsdeque.h"
+
+size_t
+SWSDequeCapacity
+( const swsdeque_t *deque )
+{
+  if( !deque )
+    return 0;
+
+  return SWSDEQUE_LOAD( ( (swsdeque_t *) deque )->array, relaxed )->capacity;
+}
+
+void
+SWSDequeDestroy
+( const swsdeque_t *deque )
+{
+  struct swsdeque_array_t *array, *outgrown;
+
+  if( deque ){
+    array = SWSDEQUE_LOAD( ( (swsdeque_t *) deque )->array, relaxed );
+    while( array ){
+      outgrown = array->outgrown;
+      free( array->slots );
+      free( array );
+      array = outgrown;
+    }
+
+    free( (void *) deque );
+  }
+
+  return;
+}
+
+unsigned short
+SWSDequeIsEmpty
+( const swsdeque_t *deque )
+{
+  return SWSDequeSize( deque ) == 0;
+}
+
+swsdeque_t *
+SWSDequeNew
+( size_t capacity )
+{
+  size_t rounded = 1;
+  struct swsdeque_array_t *array;
+  swsdeque_t *deque;
+
+  VALIDATE_PARAMETERS( capacity > 0 && capacity <= SIZE_MAX / 2 + 1 )
+
+  while( rounded < capacity )
+    rounded <<= 1;
+
+  deque = malloc( sizeof( swsdeque_t ) );
+  VALIDATE_ALLOCATION( deque )
+
+  array = SWSDequeNewArray( rounded );
+  VALIDATE_ALLOCATION_AND_FREE( array, deque )
+
+  SWSDEQUE_INIT( deque->array, array );
+  SWSDEQUE_INIT( deque->bottom, 0 );
+  SWSDEQUE_INIT( deque->top, 0 );
+
+  return deque;
+}
+
+void *
+SWSDequePop
+( swsdeque_t *deque )
+{
+  struct swsdeque_array_t *array;
+  size_t bottom, top;
+  void *element;
+
+  VALIDATE_PARAMETERS( deque )
+
+  // the bottom is stepped back first, so a thief loading it after the fence
+  // cannot also take the element being popped
+  bottom = SWSDEQUE_LOAD( deque->bottom, relaxed ) - 1;
+  array = SWSDEQUE_LOAD( deque->array, relaxed );
+  SWSDEQUE_STORE( deque->bottom, bottom, relaxed );
+  SWSDEQUE_FENCE( seq_cst );
+  top = SWSDEQUE_LOAD( deque->top, relaxed );
+
+  if( (intptr_t) ( bottom - top ) < 0 ){
+    SWSDEQUE_STORE( deque->bottom, bottom + 1, relaxed );
+    return NULL;
+  }
+
+  element = SWSDEQUE_LOAD( array->slots[bottom & array->mask], relaxed );
+  if( bottom == top ){
+    // the last element may be wanted by a thief too, so it goes to whoever
+    // moves the top first
+    if( !SWSDEQUE_CLAIM( deque->top, top ) )
+      element = NULL;
+
+    SWSDEQUE_STORE( deque->bottom, bottom + 1, relaxed );
+  }
+
+  return element;
+}
+
+swsdeque_t *
+SWSDequePush
+( swsdeque_t *deque, void *element )
+{
+  struct swsdeque_array_t *array;
+  size_t bottom, top;
+
+  VALIDATE_PARAMETERS( deque && element )
+
+  bottom = SWSDEQUE_LOAD( deque->bottom, relaxed );
+  top = SWSDEQUE_LOAD( deque->top, acquire );
+  array = SWSDEQUE_LOAD( deque->array, relaxed );
+
+  if( bottom - top > array->mask ){
+    array = SWSDequeGrow( deque, top, bottom );
+    if( !array )
+      return NULL;
+  }
+
+  SWSDEQUE_STORE( array->slots[bottom & array->mask], element, relaxed );
+
+  // the element must be visible to a thief that sees the new bottom
+  SWSDEQUE_FENCE( release );
+
+  SWSDEQUE_STORE( deque->bottom, bottom + 1, relaxed );
+
+  return deque;
+}
+
+size_t
+SWSDequeSize
+( const swsdeque_t *deque )
+{
+  size_t bottom, top;
+
+  if( !deque )
+    return 0;
+
+  top = SWSDEQUE_LOAD( ( (swsdeque_t *) deque )->top, acquire );
+  bottom = SWSDEQUE_LOAD( ( (swsdeque_t *) deque )->bottom, acquire );
+
+  // a pop in progress can leave the bottom behind the top for a moment
+  if( (intptr_t) ( bottom - top ) < 0 )
+    return 0;
+
+  return bottom - top;
+}
+
+void *
+SWSDequeSteal
+( swsdeque_t *deque )
+{
+  struct swsdeque_array_t *array;
+  size_t bottom, top;
+  void *element;
+
+  VALIDATE_PARAMETERS( deque )
+
+  top = SWSDEQUE_LOAD( deque->top, acquire );
+  SWSDEQUE_FENCE( seq_cst );
+  bottom = SWSDEQUE_LOAD( deque->bottom, acquire );
+
+  if( (intptr_t) ( bottom - top ) <= 0 )
+    return NULL;
+
+  // the ring is loaded after the bottom, so it is at least as new as the push
+  // that made the top element visible
+  array = SWSDEQUE_LOAD( deque->array, acquire );
+  element = SWSDEQUE_LOAD( array->slots[top & array->mask], relaxed );
+
+  if( !SWSDEQUE_CLAIM( deque->top, top ) )
+    return NULL;
+
+  return element;
+}
+
+static
+struct swsdeque_array_t *
+SWSDequeGrow
+( swsdeque_t *deque, size_t top, size_t bottom )
+{
+  struct swsdeque_array_t *array, *old;
+  size_t i;
+
+  old = SWSDEQUE_LOAD( deque->array, relaxed );
+
+  array = SWSDequeNewArray( old->capacity * 2 );
+  if( !array )
+    return NULL;
+
+  // each element keeps its position, so thieves holding a top still find it
+  for( i = top; i != bottom; i++ )
+    SWSDEQUE_STORE( array->slots[i & array->mask],
+                    SWSDEQUE_LOAD( old->slots[i & old->mask], relaxed ),
+                    relaxed );
+
+  array->outgrown = old;
+  SWSDEQUE_STORE( deque->array, array, release );
+
+  return array;
+}
+
+static
+struct swsdeque_array_t *
+SWSDequeNewArray
+( size_t capacity )
+{
+  struct swsdeque_array_t *array;
+
+  array = malloc( sizeof( struct swsdeque_array_t ) );
+  VALIDATE_ALLOCATION( array )
+
+  array->slots = malloc( sizeof( swsdeque_slot_t ) * capacity );
+  VALIDATE_ALLOCATION_AND_FREE( array->slots, array )
+
+  array->capacity = capacity;
+  array->mask = capacity - 1;
+  array->outgrown = NULL;
+
+  return array;
+}
@@ -0,0 +1,206 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/dynamic/queue.h>
+#include "test/function/dynamic/queue_suite.h"
+#include "test/helper.h"
+
+static char values[VALUE_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Dynamic Queue Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( PushWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( IsEmptyAndSize )
+  TEST( Peek )
+  TEST( PushAndPopAcrossBlocks )
+  TEST( RefillAfterDrain )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestPushWithNullParameters
+( void )
+{
+  dqueue_t *queue;
+
+  queue = DQueueNew();
+  if( !queue )
+    return "could not build a new DQueue";
+
+  if( DQueuePush( NULL, values ) != NULL )
+    return "a non-NULL value was returned for a NULL DQueue";
+
+  if( DQueuePush( queue, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !DQueueIsEmpty( queue ) )
+    return "something was pushed to the DQueue";
+
+  DQueueDestroy( queue );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  dqueue_t *queue;
+  size_t i;
+
+  if( !DQueueIsEmpty( NULL ) || DQueueSize( NULL ) != 0 )
+    return "a NULL DQueue was not empty";
+
+  queue = DQueueNew();
+  if( !queue )
+    return "could not build a new DQueue";
+
+  if( !DQueueIsEmpty( queue ) || DQueueSize( queue ) != 0 )
+    return "a new DQueue was not empty";
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    DQueuePush( queue, values + i );
+
+  if( DQueueIsEmpty( queue ) || DQueueSize( queue ) != VALUE_COUNT )
+    return "the size did not follow the pushes";
+
+  for( i = 0; i < DQUEUE_BLOCK_SIZE + 1; i++ )
+    DQueuePop( queue );
+
+  if( DQueueSize( queue ) != VALUE_COUNT - DQUEUE_BLOCK_SIZE - 1 )
+    return "the size did not follow the pops";
+
+  while( DQueuePop( queue ) );
+
+  if( !DQueueIsEmpty( queue ) )
+    return "the DQueue was not empty after every element was popped";
+
+  DQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPeek
+( void )
+{
+  dqueue_t *queue;
+  size_t i;
+
+  if( DQueuePeek( NULL ) != NULL )
+    return "a NULL DQueue returned an element";
+
+  queue = DQueueNew();
+  if( !queue )
+    return "could not build a new DQueue";
+
+  if( DQueuePeek( queue ) != NULL )
+    return "an empty DQueue returned an element";
+
+  for( i = 0; i < DQUEUE_BLOCK_SIZE + 2; i++ )
+    DQueuePush( queue, values + i );
+
+  if( DQueuePeek( queue ) != values || DQueueSize( queue ) != DQUEUE_BLOCK_SIZE + 2 )
+    return "the front element was not returned without being removed";
+
+  for( i = 0; i < DQUEUE_BLOCK_SIZE; i++ )
+    DQueuePop( queue );
+
+  if( DQueuePeek( queue ) != values + DQUEUE_BLOCK_SIZE )
+    return "the front element of the second block was not returned";
+
+  DQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPushAndPopAcrossBlocks
+( void )
+{
+  dqueue_t *queue;
+  size_t i, depth = 100;
+
+  queue = DQueueNew();
+  if( !queue )
+    return "could not build a new DQueue";
+
+  for( i = 0; i < depth; i++ )
+    if( DQueuePush( queue, values + i ) != queue )
+      return "a push failed";
+
+  // each pass moves both ends forward, crossing into a new block every so often
+  for( i = depth; i < VALUE_COUNT; i++ ){
+    if( DQueuePush( queue, values + i ) != queue )
+      return "a push failed";
+
+    if( DQueuePop( queue ) != values + i - depth )
+      return "an element was popped out of order";
+  }
+
+  for( i = VALUE_COUNT - depth; i < VALUE_COUNT; i++ )
+    if( DQueuePop( queue ) != values + i )
+      return "an element was popped out of order while draining";
+
+  if( !DQueueIsEmpty( queue ) )
+    return "the DQueue was not empty after every element was popped";
+
+  DQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestRefillAfterDrain
+( void )
+{
+  dqueue_t *queue;
+  size_t i, round;
+
+  queue = DQueueNew();
+  if( !queue )
+    return "could not build a new DQueue";
+
+  // the second round is built from the blocks the first round gave back
+  for( round = 0; round < 2; round++ ){
+    for( i = 0; i < VALUE_COUNT; i++ )
+      if( DQueuePush( queue, values + i ) != queue )
+        return "a push failed";
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+      if( DQueuePop( queue ) != values + i )
+        return "an element was popped out of order";
+
+    if( DQueuePop( queue ) != NULL )
+      return "an element was popped from a drained DQueue";
+  }
+
+  DQueueDestroy( queue );
+
+  return NULL;
+}
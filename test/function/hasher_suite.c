@@ -0,0 +1,550 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/hasher.h>
+#include "private/hasher.h"
+#include "test/function/hasher_suite.h"
+#include "test/helper.h"
+
+static const char *batch_strings[] = {
+  "", "a", "ab", "abc", "four", "fives", "sixsix", "seventh", "eighteen",
+  "the ninth string", "a string long enough to need more than a single crc word",
+  "a string that is longer than a whole spooky chunk, which is ninety-six bytes, so that it takes two",
+  "x", "yy", "zzz"
+};
+
+#define BATCH_STRING_COUNT (sizeof( batch_strings ) / sizeof( batch_strings[0] ))
+
+static const size_t stream_lengths[] = { 0, 1, 7, 95, 96, 97, 191, 192, 193, STREAM_LENGTH };
+
+#define STREAM_LENGTH_COUNT (sizeof( stream_lengths ) / sizeof( stream_lengths[0] ))
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Hasher Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_CRC_HASHER
+  printf( "\nRunning CRC Hasher Tests\n======\n" );
+
+  TEST( CRCDataHashBatch )
+  TEST( CRCDataHashCheckValue )
+  TEST( CRCHashBatch )
+  TEST( CRCHashMatchesDataHash )
+  TEST( CRCHashStream )
+  TEST( CRCImplementationsAgree )
+  TEST( CRCSeedChangesHash )
+#endif
+
+  printf( "\nRunning Pointer Hasher Tests\n======\n" );
+
+  TEST( MixedPointerHashBatch )
+  TEST( MixedPointerHashSpreadsAlignedPointers )
+  TEST( PointerHashBatch )
+
+#ifdef __WOODPILE_SPOOKY_HASHER
+  printf( "\nRunning Spooky Hasher Tests\n======\n" );
+
+  TEST( SpookyDataHash128TrailingZeros )
+  TEST( SpookyDataHash128Unique )
+  TEST( SpookyDataHashBatch )
+  TEST( SpookyHash128MatchesDataHash128 )
+  TEST( SpookyHashBatch )
+  TEST( SpookyHashStream )
+#endif
+
+#ifdef __WOODPILE_WOODPILE_HASHER
+  printf( "\nRunning Woodpile Hasher Tests\n======\n" );
+
+  TEST( WoodpileDataHash128Collisions )
+  TEST( WoodpileDataHash128Order )
+  TEST( WoodpileDataHashBatch )
+  TEST( WoodpileHashBatch )
+  TEST( WoodpileHashMatchesDataHash )
+  TEST( WoodpileHashStream )
+#endif
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+static
+void
+BuildBatch
+( unsigned char *buffer, const void **data, size_t *lengths )
+{
+  size_t i, offset = 0;
+
+  for( i = 0; i < BATCH_SIZE * 4; i++ )
+    buffer[i] = (unsigned char) (i * 167 + 13);
+
+  for( i = 0; i < BATCH_SIZE; i++ ){
+    lengths[i] = (i * 37) % 300;
+    data[i] = buffer + offset;
+    offset = (offset + lengths[i] + 1) % (BATCH_SIZE * 4 - 300);
+  }
+}
+
+#ifdef __WOODPILE_CRC_HASHER
+
+const char *
+TestCRCDataHashBatch
+( void )
+{
+  unsigned char buffer[BATCH_SIZE * 4];
+  const void *data[BATCH_SIZE];
+  size_t i, lengths[BATCH_SIZE];
+  unsigned long long hashes[BATCH_SIZE];
+
+  BuildBatch( buffer, data, lengths );
+
+  if( CRCDataHashBatch( data, lengths, BATCH_SIZE, 99, hashes ) != hashes )
+    return "the hash array was not returned";
+
+  for( i = 0; i < BATCH_SIZE; i++ )
+    if( hashes[i] != CRCDataHash( data[i], lengths[i], 99 ) )
+      return "a batch hash did not match the single hash of the block";
+
+  return NULL;
+}
+
+const char *
+TestCRCDataHashCheckValue
+( void )
+{
+  if( CRCDataHash( "123456789", 9, 0 ) != 0xe3069283uLL )
+    return "the check value for CRC32C was not produced";
+
+  return NULL;
+}
+
+const char *
+TestCRCHashBatch
+( void )
+{
+  size_t i;
+  unsigned long long hashes[BATCH_STRING_COUNT];
+
+  CRCHashBatch( (const void * const *) batch_strings, BATCH_STRING_COUNT, 7, hashes );
+
+  for( i = 0; i < BATCH_STRING_COUNT; i++ )
+    if( hashes[i] != CRCHash( batch_strings[i], 7 ) )
+      return "a batch hash did not match the single hash of the string";
+
+  return NULL;
+}
+
+const char *
+TestCRCHashMatchesDataHash
+( void )
+{
+  const char *str = "the CRC of this string should not depend on the function";
+
+  if( CRCHash( str, 42 ) != CRCDataHash( str, strlen( str ), 42 ) )
+    return "the string and data hashes of a string were different";
+
+  return NULL;
+}
+
+const char *
+TestCRCHashStream
+( void )
+{
+  unsigned char data[STREAM_LENGTH];
+  size_t first, i, length, second;
+  crc_state_t state;
+
+  for( i = 0; i < STREAM_LENGTH; i++ )
+    data[i] = (unsigned char) (i * 59 + 3);
+
+  for( i = 0; i < STREAM_LENGTH_COUNT; i++ ){
+    length = stream_lengths[i];
+
+    for( first = 0; first <= length; first++ ){
+      second = (length - first) / 2;
+
+      CRCHashInit( &state, 11 );
+      CRCHashUpdate( &state, data, first );
+      CRCHashUpdate( &state, data + first, second );
+      CRCHashUpdate( &state, data + first + second, length - first - second );
+
+      if( CRCHashFinal( &state ) != CRCDataHash( data, length, 11 ) )
+        return "a hash computed in pieces did not match the hash of the block";
+    }
+  }
+
+  return NULL;
+}
+
+const char *
+TestCRCImplementationsAgree
+( void )
+{
+  unsigned char data[72];
+  unsigned features, expected;
+  size_t alignment, i, length;
+
+  for( i = 0; i < sizeof( data ); i++ )
+    data[i] = (unsigned char) (i * 131 + 7);
+
+  features = HasherCPUFeatures();
+
+  for( alignment = 0; alignment < 8; alignment++ ){
+    for( length = 0; length <= 64; length++ ){
+      expected = CRCSoftwareUpdate( data + alignment, length, 0xffffffffu );
+
+#ifdef HASHER_X86
+      if( features & HASHER_CPU_SSE42 )
+        if( CRCSSE42Update( data + alignment, length, 0xffffffffu ) != expected )
+          return "the SSE4.2 implementation did not match the software implementation";
+#endif
+
+#ifdef HASHER_ARM
+      if( features & HASHER_CPU_ARM_CRC32 )
+        if( CRCARMUpdate( data + alignment, length, 0xffffffffu ) != expected )
+          return "the ARM implementation did not match the software implementation";
+#endif
+
+      if( CRCDataHash( data + alignment, length, 0 ) != (~expected & 0xffffffffuLL) )
+        return "the dispatched implementation did not match the software implementation";
+    }
+  }
+
+  return NULL;
+}
+
+const char *
+TestCRCSeedChangesHash
+( void )
+{
+  const char *str = "seeded";
+
+  if( CRCHash( str, 1 ) == CRCHash( str, 2 ) )
+    return "two different seeds produced the same hash";
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestMixedPointerHashBatch
+( void )
+{
+  size_t i;
+  unsigned long long hashes[BATCH_STRING_COUNT];
+
+  MixedPointerHashBatch( (const void * const *) batch_strings, BATCH_STRING_COUNT, 3, hashes );
+
+  for( i = 0; i < BATCH_STRING_COUNT; i++ )
+    if( hashes[i] != MixedPointerHash( batch_strings[i], 3 ) )
+      return "a batch hash did not match the single hash of the pointer";
+
+  return NULL;
+}
+
+const char *
+TestMixedPointerHashSpreadsAlignedPointers
+( void )
+{
+  char buckets[64];
+  size_t bucket, i, used = 0;
+
+  memset( buckets, 0, sizeof( buckets ) );
+  for( i = 0; i < 64 * 16; i++ ){
+    bucket = ModFold( MixedPointerHash( (const void *) (size_t) (0x10000 + i * 16), 0 ), 64 );
+    if( !buckets[bucket] ){
+      buckets[bucket] = 1;
+      used++;
+    }
+  }
+
+  if( used != 64 )
+    return "aligned pointers did not reach every bucket";
+
+  return NULL;
+}
+
+const char *
+TestPointerHashBatch
+( void )
+{
+  size_t i;
+  unsigned long long hashes[BATCH_STRING_COUNT];
+
+  PointerHashBatch( (const void * const *) batch_strings, BATCH_STRING_COUNT, 3, hashes );
+
+  for( i = 0; i < BATCH_STRING_COUNT; i++ )
+    if( hashes[i] != PointerHash( batch_strings[i], 3 ) )
+      return "a batch hash did not match the single hash of the pointer";
+
+  return NULL;
+}
+
+#ifdef __WOODPILE_SPOOKY_HASHER
+
+const char *
+TestSpookyDataHash128TrailingZeros
+( void )
+{
+  const unsigned char data[] = { 's', 'p', 'o', 'o', 'k', 'y', 0, 0 };
+  hash128_t shorter, longer;
+
+  shorter = SpookyDataHash128( data, 6, 0 );
+  longer = SpookyDataHash128( data, 7, 0 );
+
+  if( shorter.high == longer.high && shorter.low == longer.low )
+    return "a trailing zero did not change the hash";
+
+  return NULL;
+}
+
+const char *
+TestSpookyDataHash128Unique
+( void )
+{
+  unsigned long long highs[4096], lows[4096];
+  unsigned key[3];
+  size_t i, j;
+  hash128_t hash;
+
+  for( i = 0; i < 4096; i++ ){
+    key[0] = (unsigned) i;
+    key[1] = (unsigned) (i * 7);
+    key[2] = 0;
+
+    hash = SpookyDataHash128( key, sizeof( key ), 5 );
+    highs[i] = hash.high;
+    lows[i] = hash.low;
+
+    for( j = 0; j < i; j++ ){
+      if( highs[j] == highs[i] )
+        return "two blocks had the same upper half";
+      if( lows[j] == lows[i] )
+        return "two blocks had the same lower half";
+    }
+  }
+
+  return NULL;
+}
+
+const char *
+TestSpookyDataHashBatch
+( void )
+{
+  unsigned char buffer[BATCH_SIZE * 4];
+  const void *data[BATCH_SIZE];
+  size_t i, lengths[BATCH_SIZE];
+  unsigned long long hashes[BATCH_SIZE];
+
+  BuildBatch( buffer, data, lengths );
+
+  if( SpookyDataHashBatch( data, lengths, BATCH_SIZE, 99, hashes ) != hashes )
+    return "the hash array was not returned";
+
+  for( i = 0; i < BATCH_SIZE; i++ )
+    if( hashes[i] != SpookyDataHash( data[i], lengths[i], 99 ) )
+      return "a batch hash did not match the single hash of the block";
+
+#ifdef HASHER_X86
+  if( HasherCPUFeatures() & HASHER_CPU_AVX2 ){
+    memset( hashes, 0, sizeof( hashes ) );
+    SpookyAVX2DataHashBatch( data, lengths, BATCH_SIZE, 99, hashes );
+
+    for( i = 0; i < BATCH_SIZE; i++ )
+      if( hashes[i] != SpookyDataHash( data[i], lengths[i], 99 ) )
+        return "an AVX2 batch hash did not match the single hash of the block";
+  }
+#endif
+
+  return NULL;
+}
+
+const char *
+TestSpookyHash128MatchesDataHash128
+( void )
+{
+  const char *str = "a fingerprinted string";
+  hash128_t data_hash, string_hash;
+
+  data_hash = SpookyDataHash128( str, strlen( str ), 42 );
+  string_hash = SpookyHash128( str, 42 );
+
+  if( data_hash.high != string_hash.high || data_hash.low != string_hash.low )
+    return "the string and data hashes of a string were different";
+
+  return NULL;
+}
+
+const char *
+TestSpookyHashBatch
+( void )
+{
+  size_t i;
+  unsigned long long hashes[BATCH_STRING_COUNT];
+
+  SpookyHashBatch( (const void * const *) batch_strings, BATCH_STRING_COUNT, 7, hashes );
+
+  for( i = 0; i < BATCH_STRING_COUNT; i++ )
+    if( hashes[i] != SpookyHash( batch_strings[i], 7 ) )
+      return "a batch hash did not match the single hash of the string";
+
+  return NULL;
+}
+
+const char *
+TestSpookyHashStream
+( void )
+{
+  unsigned char data[STREAM_LENGTH];
+  size_t first, i, length, second;
+  spooky_state_t state;
+
+  for( i = 0; i < STREAM_LENGTH; i++ )
+    data[i] = (unsigned char) (i * 59 + 3);
+
+  for( i = 0; i < STREAM_LENGTH_COUNT; i++ ){
+    length = stream_lengths[i];
+
+    for( first = 0; first <= length; first++ ){
+      second = (length - first) / 2;
+
+      SpookyHashInit( &state, 11 );
+      SpookyHashUpdate( &state, data, first );
+      SpookyHashUpdate( &state, data + first, second );
+      SpookyHashUpdate( &state, data + first + second, length - first - second );
+
+      if( SpookyHashFinal( &state ) != SpookyDataHash( data, length, 11 ) )
+        return "a hash computed in pieces did not match the hash of the block";
+    }
+  }
+
+  return NULL;
+}
+
+#endif
+
+#ifdef __WOODPILE_WOODPILE_HASHER
+
+const char *
+TestWoodpileDataHash128Collisions
+( void )
+{
+  hash128_t first, second;
+  unsigned long long seed;
+
+  // both have the same byte sum and the same position-weighted sum
+  for( seed = 0; seed < 4; seed++ ){
+    first = WoodpileHash128( "aca", seed );
+    second = WoodpileHash128( "bab", seed );
+    if( first.low == second.low || first.high == second.high )
+      return "blocks with the same sums had a matching half";
+  }
+
+  first = WoodpileDataHash128( "ab\0\0", 2, 0 );
+  second = WoodpileDataHash128( "ab\0\0", 4, 0 );
+  if( first.low == second.low && first.high == second.high )
+    return "blocks differing only by trailing zeros had the same hash";
+
+  return NULL;
+}
+
+const char *
+TestWoodpileDataHash128Order
+( void )
+{
+  if( WoodpileHash128( "stop", 0 ).high == WoodpileHash128( "pots", 0 ).high )
+    return "reordered data had the same upper half";
+
+  return NULL;
+}
+
+const char *
+TestWoodpileDataHashBatch
+( void )
+{
+  unsigned char buffer[BATCH_SIZE * 4];
+  const void *data[BATCH_SIZE];
+  size_t i, lengths[BATCH_SIZE];
+  unsigned long long hashes[BATCH_SIZE];
+
+  BuildBatch( buffer, data, lengths );
+
+  if( WoodpileDataHashBatch( data, lengths, BATCH_SIZE, 99, hashes ) != hashes )
+    return "the hash array was not returned";
+
+  for( i = 0; i < BATCH_SIZE; i++ )
+    if( hashes[i] != WoodpileDataHash( data[i], lengths[i], 99 ) )
+      return "a batch hash did not match the single hash of the block";
+
+  return NULL;
+}
+
+const char *
+TestWoodpileHashBatch
+( void )
+{
+  size_t i;
+  unsigned long long hashes[BATCH_STRING_COUNT];
+
+  WoodpileHashBatch( (const void * const *) batch_strings, BATCH_STRING_COUNT, 7, hashes );
+
+  for( i = 0; i < BATCH_STRING_COUNT; i++ )
+    if( hashes[i] != WoodpileHash( batch_strings[i], 7 ) )
+      return "a batch hash did not match the single hash of the string";
+
+  return NULL;
+}
+
+const char *
+TestWoodpileHashMatchesDataHash
+( void )
+{
+  const char *str = "the sum of these characters";
+
+  if( WoodpileHash( str, 42 ) != WoodpileDataHash( str, strlen( str ), 42 ) )
+    return "the string and data hashes of a string were different";
+
+  return NULL;
+}
+
+const char *
+TestWoodpileHashStream
+( void )
+{
+  unsigned char data[STREAM_LENGTH];
+  size_t first, i, length, second;
+  woodpile_state_t state;
+
+  for( i = 0; i < STREAM_LENGTH; i++ )
+    data[i] = (unsigned char) (i * 59 + 3);
+
+  for( i = 0; i < STREAM_LENGTH_COUNT; i++ ){
+    length = stream_lengths[i];
+
+    for( first = 0; first <= length; first++ ){
+      second = (length - first) / 2;
+
+      WoodpileHashInit( &state, 11 );
+      WoodpileHashUpdate( &state, data, first );
+      WoodpileHashUpdate( &state, data + first, second );
+      WoodpileHashUpdate( &state, data + first + second, length - first - second );
+
+      if( WoodpileHashFinal( &state ) != WoodpileDataHash( data, length, 11 ) )
+        return "a hash computed in pieces did not match the hash of the block";
+    }
+  }
+
+  return NULL;
+}
+
+#endif
@@ -0,0 +1,355 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/blockingqueue.h>
+#include "test/function/static/blockingqueue_suite.h"
+#include "test/helper.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+static char values[THREADED_VALUES];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Blocking Queue Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( NewWithZeroCapacity )
+  TEST( PushWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( CapacityAndSize )
+  TEST( Close )
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  TEST( CloseWakesConsumer )
+#endif
+  TEST( PopBatch )
+  TEST( PopTimesOut )
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  TEST( PushWaitsForRoom )
+#endif
+  TEST( PushTimesOut )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void *
+PopForever
+( void *queue )
+{
+  return SBlockingQueuePop( queue, SBLOCKINGQUEUE_FOREVER );
+}
+
+static
+void *
+Produce
+( void *queue )
+{
+  size_t i;
+
+  for( i = 0; i < THREADED_VALUES; i++ )
+    if( !SBlockingQueuePush( queue, values + i, SBLOCKINGQUEUE_FOREVER ) )
+      return values;
+
+  SBlockingQueueClose( queue );
+
+  return NULL;
+}
+#endif
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( SBlockingQueueNew( 0 ) != NULL )
+    return "a queue was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPushWithNullParameters
+( void )
+{
+  sblockingqueue_t *queue;
+
+  queue = SBlockingQueueNew( 16 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SBlockingQueuePush( NULL, values, 0 ) != NULL )
+    return "a non-NULL value was returned for a NULL queue";
+
+  if( SBlockingQueuePush( queue, NULL, 0 ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !SBlockingQueueIsEmpty( queue ) )
+    return "something was pushed to the queue";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestCapacityAndSize
+( void )
+{
+  sblockingqueue_t *queue;
+  size_t i;
+
+  if( SBlockingQueueCapacity( NULL ) != 0 || SBlockingQueueSize( NULL ) != 0 )
+    return "a NULL queue did not have a capacity and size of 0";
+
+  queue = SBlockingQueueNew( 100 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SBlockingQueueCapacity( queue ) != 100 )
+    return "the capacity asked for was not kept";
+
+  for( i = 0; i < 100; i++ )
+    if( SBlockingQueuePush( queue, values + i, 0 ) != queue )
+      return "a push to a queue with room failed";
+
+  if( SBlockingQueueSize( queue ) != 100 )
+    return "the size did not follow the pushes";
+
+  if( SBlockingQueuePush( queue, values + 100, 0 ) != NULL )
+    return "a push past the capacity asked for succeeded";
+
+  SBlockingQueuePop( queue, 0 );
+  if( SBlockingQueueSize( queue ) != 99 )
+    return "the size did not follow a pop";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestClose
+( void )
+{
+  sblockingqueue_t *queue;
+
+  queue = SBlockingQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  SBlockingQueuePush( queue, values, 0 );
+  SBlockingQueuePush( queue, values + 1, 0 );
+
+  if( SBlockingQueueClose( queue ) != queue )
+    return "the queue could not be closed";
+
+  if( SBlockingQueuePush( queue, values + 2, SBLOCKINGQUEUE_FOREVER ) != NULL )
+    return "a push to a closed queue succeeded";
+
+  if( SBlockingQueuePop( queue, SBLOCKINGQUEUE_FOREVER ) != values
+      || SBlockingQueuePop( queue, SBLOCKINGQUEUE_FOREVER ) != values + 1 )
+    return "the elements left in a closed queue were not popped";
+
+  if( SBlockingQueuePop( queue, SBLOCKINGQUEUE_FOREVER ) != NULL )
+    return "a value was popped from a closed and empty queue";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+const char *
+TestCloseWakesConsumer
+( void )
+{
+  pthread_t consumer;
+  sblockingqueue_t *queue;
+  struct timespec pause = { 0, 20000000L };
+  void *result;
+
+  queue = SBlockingQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( pthread_create( &consumer, NULL, PopForever, queue ) != 0 )
+    return "could not start the consumer";
+
+  // give the consumer time to start waiting, though closing first also works
+  nanosleep( &pause, NULL );
+  SBlockingQueueClose( queue );
+
+  pthread_join( consumer, &result );
+  if( result != NULL )
+    return "a value was popped by the consumer woken by the close";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+#endif
+
+const char *
+TestPopBatch
+( void )
+{
+  void *out[8];
+  sblockingqueue_t *queue;
+  size_t i;
+
+  queue = SBlockingQueueNew( 16 );
+  if( !queue )
+    return "could not build a new queue";
+
+  for( i = 0; i < 10; i++ )
+    SBlockingQueuePush( queue, values + i, 0 );
+
+  if( SBlockingQueuePopBatch( NULL, out, 8, 0 ) != 0
+      || SBlockingQueuePopBatch( queue, NULL, 8, 0 ) != 0
+      || SBlockingQueuePopBatch( queue, out, 0, 0 ) != 0 )
+    return "a batch was popped with invalid parameters";
+
+  if( SBlockingQueuePopBatch( queue, out, 8, 0 ) != 8 )
+    return "a full batch was not popped";
+
+  for( i = 0; i < 8; i++ )
+    if( out[i] != values + i )
+      return "the batch was not in the order the values were pushed";
+
+  if( SBlockingQueuePopBatch( queue, out, 8, SBLOCKINGQUEUE_FOREVER ) != 2 )
+    return "the rest of the queue was not popped as a smaller batch";
+
+  if( out[0] != values + 8 || out[1] != values + 9 )
+    return "the smaller batch did not hold the last values";
+
+  if( SBlockingQueuePopBatch( queue, out, 8, 0 ) != 0 )
+    return "a batch was popped from an empty queue";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPopTimesOut
+( void )
+{
+  sblockingqueue_t *queue;
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  struct timespec begin, end;
+#endif
+
+  queue = SBlockingQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SBlockingQueuePop( queue, 0 ) != NULL )
+    return "a value was popped from an empty queue without waiting";
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+#endif
+  if( SBlockingQueuePop( queue, 20 ) != NULL )
+    return "a value was popped from an empty queue after a timeout";
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  if( ( end.tv_sec - begin.tv_sec ) * 1000.0 + ( end.tv_nsec - begin.tv_nsec ) / 1000000.0 < 15.0 )
+    return "the pop returned before the timeout had passed";
+#endif
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+const char *
+TestPushWaitsForRoom
+( void )
+{
+  void *out[THREADED_BATCH];
+  pthread_t producer;
+  sblockingqueue_t *queue;
+  size_t batch, count, i, received = 0;
+  void *result;
+
+  queue = SBlockingQueueNew( 5 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( pthread_create( &producer, NULL, Produce, queue ) != 0 )
+    return "could not start the producer";
+
+  // batches of varying size, ending when the producer closes the queue
+  for( batch = 1; ( count = SBlockingQueuePopBatch( queue, out, batch, SBLOCKINGQUEUE_FOREVER ) ) > 0;
+       batch = batch % THREADED_BATCH + 1 )
+    for( i = 0; i < count; i++ )
+      if( out[i] != values + received++ ){
+        pthread_join( producer, NULL );
+        return "a value was received out of order";
+      }
+
+  pthread_join( producer, &result );
+  if( result != NULL )
+    return "a push failed rather than waiting for room";
+
+  if( received != THREADED_VALUES )
+    return "not every value was received";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
+#endif
+
+const char *
+TestPushTimesOut
+( void )
+{
+  sblockingqueue_t *queue;
+
+  queue = SBlockingQueueNew( 2 );
+  if( !queue )
+    return "could not build a new queue";
+
+  SBlockingQueuePush( queue, values, 0 );
+  SBlockingQueuePush( queue, values + 1, 0 );
+
+  if( SBlockingQueuePush( queue, values + 2, 0 ) != NULL )
+    return "a push to a full queue succeeded without waiting";
+
+  if( SBlockingQueuePush( queue, values + 2, 20 ) != NULL )
+    return "a push to a full queue succeeded after a timeout";
+
+  if( SBlockingQueueSize( queue ) != 2 || SBlockingQueuePop( queue, 0 ) != values )
+    return "the queue was changed by the failed pushes";
+
+  SBlockingQueueDestroy( queue );
+
+  return NULL;
+}
@@ -0,0 +1,377 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/comparator.h>
+#include <woodpile/config.h>
+#include <woodpile/static/cache.h>
+#include "test/function/static/cache_suite.h"
+#include "test/helper.h"
+
+static char keys[KEY_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Cache Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( GetWithNullParameters )
+  TEST( NewWithZeroCapacity )
+  TEST( PutWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( DestroyWithEvictor )
+  TEST( GetMakesKeyNewest )
+  TEST( IsEmpty )
+  TEST( PeekKeepsRecency )
+  TEST( PutEvictsOldest )
+  TEST( PutExistingKey )
+  TEST( Remove )
+  TEST( SetKeyComparator )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+static
+void
+Record
+( void *key, void *value, void *context )
+{
+  struct eviction_t *eviction = context;
+
+  if( key != value )
+    eviction->mismatched = 1;
+
+  eviction->keys[eviction->count++] = key;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestGetWithNullParameters
+( void )
+{
+  scache_t *cache;
+
+  cache = SCacheNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( SCacheGet( NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL cache";
+
+  if( SCacheGet( cache, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( SCacheNew( 0 ) != NULL )
+    return "a cache was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPutWithNullParameters
+( void )
+{
+  scache_t *cache;
+
+  cache = SCacheNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( SCachePut( NULL, keys, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL cache";
+
+  if( SCachePut( cache, NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( SCacheSize( cache ) != 0 )
+    return "something was put into the cache";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestDestroyWithEvictor
+( void )
+{
+  struct eviction_t eviction;
+  scache_t *cache;
+  size_t i;
+
+  cache = SCacheNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  SCacheSetEvictor( cache, Record, &eviction );
+
+  for( i = 0; i < 10; i++ )
+    SCachePut( cache, keys + i, keys + i );
+  SCacheGet( cache, keys );
+
+  SCacheDestroy( cache );
+
+  if( eviction.count != 10 || eviction.mismatched )
+    return "the evictor was not given every entry";
+
+  if( eviction.keys[0] != keys + 1 || eviction.keys[9] != keys )
+    return "the entries were not given from least to most recently used";
+
+  return NULL;
+}
+
+const char *
+TestGetMakesKeyNewest
+( void )
+{
+  scache_t *cache;
+  size_t i;
+
+  cache = SCacheNew( 4 );
+  if( !cache )
+    return "could not build a new cache";
+
+  for( i = 0; i < 4; i++ )
+    SCachePut( cache, keys + i, keys + i );
+
+  if( SCacheGet( cache, keys ) != keys )
+    return "the value of a key was not returned";
+
+  if( SCacheOldest( cache ) != keys + 1 )
+    return "the key was not made the most recently used";
+
+  SCachePut( cache, keys + 4, keys + 4 );
+  SCachePut( cache, keys + 5, keys + 5 );
+
+  if( SCacheGet( cache, keys ) != keys )
+    return "a recently used key was evicted";
+
+  if( SCacheGet( cache, keys + 1 ) != NULL || SCacheGet( cache, keys + 2 ) != NULL )
+    return "the least recently used keys were not evicted";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestIsEmpty
+( void )
+{
+  scache_t *cache;
+
+  if( !SCacheIsEmpty( NULL ) )
+    return "a NULL cache was not empty";
+
+  cache = SCacheNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( !SCacheIsEmpty( cache ) )
+    return "a new cache was not empty";
+
+  SCachePut( cache, keys, keys );
+  if( SCacheIsEmpty( cache ) )
+    return "a cache with a key was empty";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestPeekKeepsRecency
+( void )
+{
+  scache_t *cache;
+
+  cache = SCacheNew( 2 );
+  if( !cache )
+    return "could not build a new cache";
+
+  SCachePut( cache, keys, keys );
+  SCachePut( cache, keys + 1, keys + 1 );
+
+  if( SCachePeek( cache, keys ) != keys )
+    return "the value of a key was not returned";
+
+  SCachePut( cache, keys + 2, keys + 2 );
+  if( SCachePeek( cache, keys ) != NULL || SCachePeek( cache, keys + 1 ) != keys + 1 )
+    return "peeking at a key changed how recently it was used";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestPutEvictsOldest
+( void )
+{
+  struct eviction_t eviction;
+  scache_t *cache;
+  size_t i;
+
+  cache = SCacheNew( 100 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  SCacheSetEvictor( cache, Record, &eviction );
+
+  for( i = 0; i < KEY_COUNT; i++ ){
+    SCachePut( cache, keys + i, keys + i );
+    if( SCacheSize( cache ) != ( i < 100 ? i + 1 : 100 ) )
+      return "the size did not stop at the capacity";
+  }
+
+  if( eviction.count != KEY_COUNT - 100 || eviction.mismatched )
+    return "the evictor was not given each evicted entry";
+
+  for( i = 0; i < KEY_COUNT - 100; i++ )
+    if( eviction.keys[i] != keys + i )
+      return "the keys were not evicted from least to most recently used";
+
+  for( i = KEY_COUNT - 100; i < KEY_COUNT; i++ )
+    if( SCachePeek( cache, keys + i ) != keys + i )
+      return "a recently used key was lost";
+
+  SCacheSetEvictor( cache, NULL, NULL );
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestPutExistingKey
+( void )
+{
+  struct eviction_t eviction;
+  scache_t *cache;
+  void *first = "first";
+
+  cache = SCacheNew( 2 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  SCacheSetEvictor( cache, Record, &eviction );
+
+  SCachePut( cache, keys, first );
+  SCachePut( cache, keys + 1, keys + 1 );
+
+  if( SCachePut( cache, keys, keys ) != first )
+    return "the previous value was not returned";
+
+  if( eviction.count != 0 || SCacheSize( cache ) != 2 )
+    return "a replaced value was evicted";
+
+  SCachePut( cache, keys + 2, keys + 2 );
+  if( SCachePeek( cache, keys ) != keys || SCachePeek( cache, keys + 1 ) != NULL )
+    return "the replaced key was not made the most recently used";
+
+  SCacheSetEvictor( cache, NULL, NULL );
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestRemove
+( void )
+{
+  struct eviction_t eviction;
+  scache_t *cache;
+  size_t i;
+
+  cache = SCacheNew( 4 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  SCacheSetEvictor( cache, Record, &eviction );
+
+  for( i = 0; i < 4; i++ )
+    SCachePut( cache, keys + i, keys + i );
+
+  if( SCacheRemove( cache, keys + 2 ) != keys + 2 )
+    return "the removed value was not returned";
+
+  if( SCachePeek( cache, keys + 2 ) != NULL || SCacheSize( cache ) != 3 )
+    return "the key was not removed";
+
+  if( SCacheRemove( cache, keys + 2 ) != NULL )
+    return "a key was removed twice";
+
+  SCachePut( cache, keys + 4, keys + 4 );
+  if( eviction.count != 0 || SCacheSize( cache ) != 4 )
+    return "a key was evicted while a removed entry was free";
+
+  SCachePut( cache, keys + 5, keys + 5 );
+  if( eviction.count != 1 || eviction.keys[0] != keys )
+    return "the least recently used key was not evicted after a remove";
+
+  SCacheSetEvictor( cache, NULL, NULL );
+  SCacheDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestSetKeyComparator
+( void )
+{
+  char first[] = "key", second[] = "key";
+  scache_t *cache;
+
+  cache = SCacheNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  // every key shares one hash, so only the comparator tells them apart
+  if( !SCacheSetHasher( cache, NullHash ) || !SCacheSetKeyComparator( cache, CompareStrings ) )
+    return "the key handling could not be set";
+
+  SCachePut( cache, first, keys );
+  if( SCacheGet( cache, second ) != keys )
+    return "an equal key was not found";
+
+  SCachePut( cache, second, keys + 1 );
+  if( SCacheSize( cache ) != 1 || SCacheGet( cache, first ) != keys + 1 )
+    return "an equal key was not treated as the same key";
+
+  SCacheDestroy( cache );
+
+  return NULL;
+}
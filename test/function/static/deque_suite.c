@@ -0,0 +1,322 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/deque.h>
+#include "test/function/static/deque_suite.h"
+#include "test/helper.h"
+
+static char values[VALUE_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Deque Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( PushWithNullParameters )
+  TEST( SetWithInvalidParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( Capacity )
+  TEST( Get )
+  TEST( GrowFromBothEnds )
+  TEST( IsEmptyAndSize )
+  TEST( Peek )
+  TEST( PopFromBothEnds )
+  TEST( Set )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestPushWithNullParameters
+( void )
+{
+  sdeque_t *deque;
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SDequePushBack( NULL, values ) != NULL || SDequePushFront( NULL, values ) != NULL )
+    return "a non-NULL value was returned for a NULL deque";
+
+  if( SDequePushBack( deque, NULL ) != NULL || SDequePushFront( deque, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !SDequeIsEmpty( deque ) )
+    return "something was pushed to the deque";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestSetWithInvalidParameters
+( void )
+{
+  sdeque_t *deque;
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  SDequePushBack( deque, values );
+
+  if( SDequeSet( NULL, 0, values + 1 ) != NULL )
+    return "a non-NULL value was returned for a NULL deque";
+
+  if( SDequeSet( deque, 0, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( SDequeSet( deque, 1, values + 1 ) != NULL )
+    return "a non-NULL value was returned for a position past the back";
+
+  if( SDequeGet( deque, 0 ) != values || SDequeSize( deque ) != 1 )
+    return "the deque was changed";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestCapacity
+( void )
+{
+  sdeque_t *deque;
+
+  if( SDequeCapacity( NULL ) != 0 )
+    return "a NULL deque did not have a capacity of 0";
+
+  deque = SDequeNew( 100 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SDequeCapacity( deque ) != 128 )
+    return "the capacity was not rounded up to a power of two";
+
+  SDequeDestroy( deque );
+
+  deque = SDequeNew( 0 );
+  if( !deque )
+    return "could not build a deque of capacity 0";
+
+  if( SDequeCapacity( deque ) != 1 )
+    return "a deque of capacity 0 was not given a capacity of 1";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestGet
+( void )
+{
+  sdeque_t *deque;
+  size_t i;
+
+  deque = SDequeNew( 8 );
+  if( !deque )
+    return "could not build a new deque";
+
+  // the front runs below the start of the ring, so positions wrap
+  for( i = 3; i < 6; i++ )
+    SDequePushBack( deque, values + i );
+  for( i = 3; i > 0; i-- )
+    SDequePushFront( deque, values + i - 1 );
+
+  for( i = 0; i < 6; i++ )
+    if( SDequeGet( deque, i ) != values + i )
+      return "a position did not give the element that far from the front";
+
+  if( SDequeGet( deque, 6 ) != NULL )
+    return "a position past the back gave an element";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestGrowFromBothEnds
+( void )
+{
+  sdeque_t *deque;
+  size_t i;
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  // the middle value goes in first, and the rest spread out to either end
+  for( i = 0; i < VALUE_COUNT / 2; i++ ){
+    if( SDequePushFront( deque, values + VALUE_COUNT / 2 - 1 - i ) != deque )
+      return "a push to the front of a full deque failed";
+
+    if( SDequePushBack( deque, values + VALUE_COUNT / 2 + i ) != deque )
+      return "a push to the back of a full deque failed";
+  }
+
+  if( SDequeCapacity( deque ) != VALUE_COUNT )
+    return "the capacity was not doubled each time the deque was full";
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    if( SDequeGet( deque, i ) != values + i )
+      return "the elements did not keep their order through the growth";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  sdeque_t *deque;
+
+  if( !SDequeIsEmpty( NULL ) || SDequeSize( NULL ) != 0 )
+    return "a NULL deque was not empty";
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( !SDequeIsEmpty( deque ) || SDequeSize( deque ) != 0 )
+    return "a new deque was not empty";
+
+  SDequePushBack( deque, values );
+  SDequePushFront( deque, values + 1 );
+  if( SDequeIsEmpty( deque ) || SDequeSize( deque ) != 2 )
+    return "the size did not follow the pushes";
+
+  SDequePopBack( deque );
+  if( SDequeSize( deque ) != 1 )
+    return "the size did not follow a pop";
+
+  SDequePopBack( deque );
+  if( !SDequeIsEmpty( deque ) )
+    return "the deque was not empty after every element was popped";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestPeek
+( void )
+{
+  sdeque_t *deque;
+
+  if( SDequePeekBack( NULL ) != NULL || SDequePeekFront( NULL ) != NULL )
+    return "a NULL deque returned an element";
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SDequePeekBack( deque ) != NULL || SDequePeekFront( deque ) != NULL )
+    return "an empty deque returned an element";
+
+  SDequePushBack( deque, values );
+  SDequePushBack( deque, values + 1 );
+  SDequePushFront( deque, values + 2 );
+
+  if( SDequePeekFront( deque ) != values + 2 )
+    return "the front element was not returned";
+
+  if( SDequePeekBack( deque ) != values + 1 )
+    return "the back element was not returned";
+
+  if( SDequeSize( deque ) != 3 )
+    return "peeking removed an element";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestPopFromBothEnds
+( void )
+{
+  sdeque_t *deque;
+  size_t i;
+
+  deque = SDequeNew( 8 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SDequePopBack( deque ) != NULL || SDequePopFront( deque ) != NULL )
+    return "an element was popped from an empty deque";
+
+  for( i = 4; i < 8; i++ )
+    SDequePushBack( deque, values + i );
+  for( i = 4; i > 0; i-- )
+    SDequePushFront( deque, values + i - 1 );
+
+  for( i = 0; i < 4; i++ ){
+    if( SDequePopFront( deque ) != values + i )
+      return "the front elements were not popped in order";
+
+    if( SDequePopBack( deque ) != values + 7 - i )
+      return "the back elements were not popped in order";
+  }
+
+  if( SDequePopBack( deque ) != NULL || SDequePopFront( deque ) != NULL )
+    return "an element was popped from a drained deque";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestSet
+( void )
+{
+  sdeque_t *deque;
+
+  deque = SDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  SDequePushBack( deque, values );
+  SDequePushBack( deque, values + 1 );
+  SDequePushFront( deque, values + 2 );
+
+  if( SDequeSet( deque, 2, values + 3 ) != values + 1 )
+    return "the replaced element was not returned";
+
+  if( SDequeGet( deque, 2 ) != values + 3 || SDequePeekBack( deque ) != values + 3 )
+    return "the new element was not at the position set";
+
+  if( SDequeGet( deque, 0 ) != values + 2 || SDequeGet( deque, 1 ) != values )
+    return "another position was changed";
+
+  SDequeDestroy( deque );
+
+  return NULL;
+}
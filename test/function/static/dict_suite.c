@@ -0,0 +1,506 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/dict.h>
+#include "test/function/static/dict_suite.h"
+#include "test/helper.h"
+
+static char keys[KEY_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Dict Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( ForEachWithNullParameters )
+  TEST( GetWithNullParameters )
+  TEST( NewSizedWithZeroCapacity )
+  TEST( PutWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( ForEachAfterRemove )
+  TEST( ForEachInInsertionOrder )
+  TEST( GetFromEmptyDict )
+  TEST( GetWithCollidingKeys )
+  TEST( IsEmpty )
+  TEST( PutExistingKey )
+  TEST( PutIntoFullDict )
+  TEST( Remove )
+  TEST( SetCapacity )
+  TEST( SetHasher )
+  TEST( Size )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+static
+const char *
+CheckOrder
+( sdict_t *dict, char **expected, size_t count )
+{
+  struct visit_t visit;
+  size_t i;
+
+  visit.count = 0;
+  visit.mismatched = 0;
+  visit.order = malloc( ( SDictSize( dict ) + 1 ) * sizeof( char * ) );
+  if( !visit.order )
+    return "could not allocate the visit order";
+
+  SDictForEach( dict, Visit, &visit );
+
+  if( visit.count != count ){
+    free( visit.order );
+    return "the wrong number of keys were visited";
+  }
+
+  if( visit.mismatched ){
+    free( visit.order );
+    return "a key was visited with the wrong value";
+  }
+
+  for( i = 0; i < count; i++ )
+    if( visit.order[i] != expected[i] ){
+      free( visit.order );
+      return "the keys were not visited in insertion order";
+    }
+
+  free( visit.order );
+
+  return NULL;
+}
+
+static
+void
+Visit
+( void *key, void *value, void *context )
+{
+  struct visit_t *visit = context;
+
+  if( key != value )
+    visit->mismatched = 1;
+
+  visit->order[visit->count++] = key;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestForEachWithNullParameters
+( void )
+{
+  sdict_t *dict;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  if( SDictForEach( NULL, Visit, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL dict";
+
+  if( SDictForEach( dict, NULL, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL action";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestGetWithNullParameters
+( void )
+{
+  sdict_t *dict;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  if( SDictGet( NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL dict";
+
+  if( SDictGet( dict, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestNewSizedWithZeroCapacity
+( void )
+{
+  if( SDictNewSized( 0 ) != NULL )
+    return "a dict was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPutWithNullParameters
+( void )
+{
+  sdict_t *dict;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  if( SDictPut( NULL, keys, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL dict";
+
+  if( SDictPut( dict, NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( SDictSize( dict ) != 0 )
+    return "something was put into the dict";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestForEachAfterRemove
+( void )
+{
+  char *expected[50];
+  const char *failure;
+  sdict_t *dict;
+  size_t count = 0, i;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  for( i = 0; i < 100; i++ )
+    SDictPut( dict, keys + i, keys + i );
+
+  for( i = 0; i < 100; i++ )
+    if( i % 2 == 0 )
+      SDictRemove( dict, keys + i );
+    else
+      expected[count++] = keys + i;
+
+  failure = CheckOrder( dict, expected, count );
+  SDictDestroy( dict );
+
+  return failure;
+}
+
+const char *
+TestForEachInInsertionOrder
+( void )
+{
+  char *expected[200];
+  const char *failure;
+  sdict_t *dict;
+  size_t i;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  // put the keys in an order unrelated to their addresses
+  for( i = 0; i < 200; i++ ){
+    expected[i] = keys + ( i * 7919 ) % KEY_COUNT;
+    SDictPut( dict, expected[i], expected[i] );
+  }
+
+  failure = CheckOrder( dict, expected, 200 );
+  SDictDestroy( dict );
+
+  return failure;
+}
+
+const char *
+TestGetFromEmptyDict
+( void )
+{
+  sdict_t *dict;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  if( SDictGet( dict, keys ) != NULL )
+    return "a value was found in an empty dict";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestGetWithCollidingKeys
+( void )
+{
+  sdict_t *dict;
+  size_t i;
+
+  dict = SDictNewSized( 16 );
+  if( !dict )
+    return "could not build a new dict";
+
+  SDictSetHasher( dict, NullHash );
+  for( i = 0; i < 16; i++ )
+    SDictPut( dict, keys + i, keys + i + 1 );
+
+  for( i = 0; i < 16; i++ )
+    if( SDictGet( dict, keys + i ) != keys + i + 1 )
+      return "a colliding key did not give its own value";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestIsEmpty
+( void )
+{
+  sdict_t *dict;
+
+  if( !SDictIsEmpty( NULL ) )
+    return "a NULL dict was not empty";
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  if( !SDictIsEmpty( dict ) )
+    return "a new dict was not empty";
+
+  SDictPut( dict, keys, keys );
+  if( SDictIsEmpty( dict ) )
+    return "a dict with a key was empty";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestPutExistingKey
+( void )
+{
+  char *expected[3] = { keys, keys + 1, keys + 2 };
+  const char *failure;
+  sdict_t *dict;
+  void *first = "first";
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  SDictPut( dict, keys, first );
+  SDictPut( dict, keys + 1, keys + 1 );
+  SDictPut( dict, keys + 2, keys + 2 );
+
+  if( SDictPut( dict, keys, keys ) != first )
+    return "the previous value was not returned";
+
+  if( SDictGet( dict, keys ) != keys )
+    return "the value was not replaced";
+
+  failure = CheckOrder( dict, expected, 3 );
+  SDictDestroy( dict );
+
+  return failure;
+}
+
+const char *
+TestPutIntoFullDict
+( void )
+{
+  char *expected[16];
+  const char *failure;
+  sdict_t *dict;
+  size_t i;
+
+  dict = SDictNewSized( 8 );
+  if( !dict )
+    return "could not build a new dict";
+
+  for( i = 0; i < 8; i++ )
+    SDictPut( dict, keys + i, keys + i );
+
+  SDictRemove( dict, keys + 2 );
+  SDictRemove( dict, keys + 5 );
+  if( SDictPut( dict, keys + 8, keys + 8 ) != keys + 8 )
+    return "a key was not put after others were removed";
+
+  if( SDictCapacity( dict ) != 8 )
+    return "a dict with enough holes was grown instead of compacted";
+
+  SDictPut( dict, keys + 9, keys + 9 );
+  SDictRemove( dict, keys + 3 );
+  if( SDictPut( dict, keys + 10, keys + 10 ) != keys + 10 )
+    return "a key was not put into a full dict";
+
+  if( SDictCapacity( dict ) != 16 )
+    return "a dict with few holes was not grown";
+
+  for( i = 0; i < 8; i++ )
+    expected[i] = keys + ( i < 2 ? i : i < 3 ? 4 : i + 3 );
+
+  failure = CheckOrder( dict, expected, 8 );
+  SDictDestroy( dict );
+
+  return failure;
+}
+
+const char *
+TestRemove
+( void )
+{
+  sdict_t *dict;
+  void *value = "value";
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  SDictPut( dict, keys, value );
+  SDictPut( dict, keys + 1, keys + 1 );
+
+  if( SDictRemove( dict, keys ) != value )
+    return "the removed value was not returned";
+
+  if( SDictGet( dict, keys ) != NULL )
+    return "a removed key was found";
+
+  if( SDictRemove( dict, keys ) != NULL )
+    return "a key was removed twice";
+
+  if( SDictGet( dict, keys + 1 ) != keys + 1 )
+    return "a remaining key was lost";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestSetCapacity
+( void )
+{
+  char **expected;
+  const char *failure;
+  sdict_t *dict;
+  size_t i;
+
+  expected = malloc( KEY_COUNT * sizeof( char * ) );
+  if( !expected )
+    return "could not allocate the expected order";
+
+  dict = SDictNewSized( 200 );
+  if( !dict )
+    return "could not build a new dict";
+
+  for( i = 0; i < KEY_COUNT; i++ ){
+    expected[i] = keys + KEY_COUNT - 1 - i;
+    if( i == 200 && !SDictSetCapacity( dict, 60000 ) )
+      return "could not grow the dict past 255 entries";
+    if( i == 60000 && !SDictSetCapacity( dict, KEY_COUNT ) )
+      return "could not grow the dict past 65535 entries";
+
+    SDictPut( dict, expected[i], expected[i] );
+  }
+
+  if( SDictCapacity( dict ) != KEY_COUNT )
+    return "the capacity was not updated";
+
+  for( i = 0; i < KEY_COUNT; i++ )
+    if( SDictGet( dict, expected[i] ) != expected[i] )
+      return "a key was lost when the capacity changed";
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  if( SDictSetCapacity( dict, 10 ) != NULL )
+    return "the capacity was set below the size";
+#endif
+
+  failure = CheckOrder( dict, expected, KEY_COUNT );
+  SDictDestroy( dict );
+  free( expected );
+
+  return failure;
+}
+
+const char *
+TestSetHasher
+( void )
+{
+  sdict_t *dict;
+  size_t i;
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  for( i = 0; i < 100; i++ )
+    SDictPut( dict, keys + i, keys + i );
+
+  if( SDictSetHasher( dict, PointerHash ) != dict )
+    return "the hasher could not be set";
+
+  for( i = 0; i < 100; i++ )
+    if( SDictGet( dict, keys + i ) != keys + i )
+      return "a key was lost when the hasher was changed";
+
+  SDictSetHasher( dict, NullHash );
+  for( i = 0; i < 100; i++ )
+    if( SDictGet( dict, keys + i ) != keys + i )
+      return "a key was lost with a colliding hasher";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
+
+const char *
+TestSize
+( void )
+{
+  sdict_t *dict;
+
+  if( SDictSize( NULL ) != 0 )
+    return "a NULL dict had a size";
+
+  dict = SDictNew();
+  if( !dict )
+    return "could not build a new dict";
+
+  SDictPut( dict, keys, keys );
+  SDictPut( dict, keys + 1, keys + 1 );
+  SDictPut( dict, keys, keys );
+  if( SDictSize( dict ) != 2 )
+    return "the size did not count each key once";
+
+  SDictRemove( dict, keys );
+  if( SDictSize( dict ) != 1 )
+    return "the size did not drop after a remove";
+
+  SDictDestroy( dict );
+
+  return NULL;
+}
@@ -33,19 +33,26 @@ main
   TEST( ContainsWithNullSHash )
   TEST( GetFromNullSHash )
   TEST( GetNullKeyFromSHash )
+  TEST( GetOrPutWithNullParameters )
+  TEST( NewFromPairsWithNullParameters )
   TEST( PutIntoNullSHash )
   TEST( PutNullKeyIntoSHash )
   TEST( PutNullValueIntoSHash )
   TEST( RemoveFromNullSHash )
   TEST( RemoveNullKey )
+  TEST( SetCapacityBelowSize )
   TEST( SetCapacityWithNullSHash)
+  TEST( SetCapacityParallelWithNullParameters )
   TEST( SetElementComparatorToNull )
   TEST( SetElementComparatorWithNullSHash )
   TEST( SetHasherWithNullHasher )
   TEST( SetHasherWithNullSHash )
   TEST( SetKeyComparatorToNull )
   TEST( SetKeyComparatorWithNullSHash )
+  TEST( SetLowWaterWithInvalidParameters )
+  TEST( SnapshotWithNullSHash )
   TEST( ToStringWithNullSHash )
+  TEST( UpsertWithNullParameters )
 
 #ifdef TEST_FUNCTION_COMMON_SUITE_AVAILABLE
   TEST( CopyNull )
@@ -75,28 +82,44 @@ main
   TEST( ContainsNonExistentValue )
   TEST( ContainsUniqueValue )
   TEST( CopyContents )
+  TEST( CopyKeepsEveryKey )
   TEST( GetFromEmptySHash )
   TEST( GetFromPopulatedSHash )
+  TEST( GetOrPutExistingKey )
+  TEST( GetOrPutNewKey )
   TEST( GetWithCollidingKeys )
+  TEST( NewFromPairs )
+  TEST( NewUsesMixedPointerHash )
+  TEST( PutClusteredKeys )
   TEST( PutExistingKeyIntoFullSHash )
   TEST( PutNewKeyIntoFullSHash )
   TEST( PutValueIntoEmptySHash )
   TEST( PutValueIntoPopulatedSHash )
   TEST( PutWithCollidingKeys )
   TEST( Remove )
+  TEST( RemoveFromCrowdedSHash )
   TEST( RemoveNonExistentKey )
   TEST( SetCapacity )
+  TEST( SetCapacityParallel )
   TEST( SetElementComparator )
   TEST( SetHasher )
+  TEST( SetHasherToAutoHash )
   TEST( SetHasherWithCollisions )
   TEST( SetHasherWithEmptySHash )
   TEST( SetKeyComparator )
   TEST( SetKeyComparatorWithEmptySHash )
   TEST( SetKeyComparatorWithEqualKeys )
+  TEST( SetLayout )
+  TEST( SetLowWater )
   TEST( Size )
+  TEST( Snapshot )
   TEST( ToStringWithEmptySHash )
   TEST( ToStringWithNullFunction )
   TEST( ToStringWithPopulatedSHash )
+  TEST( TrainHasherWithDictionary )
+  TEST( TrainHasherWithTooFewKeys )
+  TEST( TrimToSize )
+  TEST( Upsert )
 
   printf( "\n" );
 
@@ -162,6 +185,48 @@ TestGetNullKeyFromSHash
   return NULL;
 }
 
+const char *
+TestGetOrPutWithNullParameters
+( void )
+{
+  shash_t *hash;
+
+  hash = BuildSHash();
+  if( !hash )
+    return "could not build a populated hash";
+
+  if( SHashGetOrPut( NULL, "key", "value" ) != NULL )
+    return "a non-NULL value was returned for a NULL hash";
+
+  if( SHashGetOrPut( hash, NULL, "value" ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( SHashGetOrPut( hash, "key", NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL value";
+
+  if( SHashGet( hash, "key" ) != NULL )
+    return "a NULL value was put into the hash";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestNewFromPairsWithNullParameters
+( void )
+{
+  void *pairs[1] = { NULL };
+
+  if( SHashNewFromPairs( NULL, pairs, 0, 1 ) != NULL )
+    return "a hash was built from NULL keys";
+
+  if( SHashNewFromPairs( pairs, NULL, 0, 1 ) != NULL )
+    return "a hash was built from NULL values";
+
+  return NULL;
+}
+
 const char *
 TestPutIntoNullSHash
 ( void )
@@ -269,6 +334,36 @@ TestRemoveNullKey
   return NULL;
 }
 
+const char *
+TestSetCapacityBelowSize
+( void )
+{
+  static char keys[20];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 20; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  if( SHashSetCapacity( hash, 10 ) != NULL )
+    return "the capacity was set below the size";
+
+  if( SHashCapacity( hash ) != 256 || SHashSize( hash ) != 20 )
+    return "the hash was changed by a failed resize";
+
+  for( i = 0; i < 20; i++ )
+    if( SHashGet( hash, keys + i ) != keys + i )
+      return "a key was lost by a failed resize";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestSetCapacityWithNullSHash
 ( void )
@@ -287,6 +382,35 @@ TestSetCapacityWithNullSHash
   return NULL;
 }
 
+const char *
+TestSetCapacityParallelWithNullParameters
+( void )
+{
+  static char keys[20];
+  shash_t *hash;
+  size_t i;
+
+  if( SHashSetCapacityParallel( NULL, 256, 2 ) != NULL )
+    return "a NULL hash was resized";
+
+  hash = SHashNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 20; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  if( SHashSetCapacityParallel( hash, 10, 2 ) != NULL )
+    return "the capacity was set below the size";
+
+  if( SHashCapacity( hash ) != 256 || SHashGet( hash, keys + 10 ) != keys + 10 )
+    return "the hash was changed by a failed resize";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestSetElementComparatorToNull
 ( void )
@@ -401,6 +525,37 @@ TestSetKeyComparatorWithNullSHash
   return NULL;
 }
 
+const char *
+TestSetLowWaterWithInvalidParameters
+( void )
+{
+  shash_t *hash;
+
+  if( SHashSetLowWater( NULL, 10 ) != NULL )
+    return "a mark was set on a NULL hash";
+
+  hash = SHashNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHashSetLowWater( hash, 26 ) != NULL || SHashLowWater( hash ) != 0 )
+    return "a mark above 25 percent was set";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestSnapshotWithNullSHash
+( void )
+{
+  if( SHashSnapshot( NULL ) != NULL )
+    return "a snapshot was taken of a NULL hash";
+
+  return NULL;
+}
+
 const char *
 TestToStringWithNullSHash
 ( void )
@@ -414,6 +569,30 @@ TestToStringWithNullSHash
   return NULL;
 }
 
+const char *
+TestUpsertWithNullParameters
+( void )
+{
+  shash_t *hash;
+
+  hash = BuildSHash();
+  if( !hash )
+    return "could not build a populated hash";
+
+  if( SHashUpsert( NULL, "key", CountingBuilder, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL hash";
+
+  if( SHashUpsert( hash, NULL, CountingBuilder, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( SHashUpsert( hash, "key", NULL, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL build function";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 #endif
 
 const char *
@@ -489,6 +668,39 @@ TestCopyContents
   return NULL;
 }
 
+const char *
+TestCopyKeepsEveryKey
+( void )
+{
+  static char keys[PAIR_COUNT];
+  shash_t *copy, *hash;
+  size_t i;
+
+  hash = SHashNewSized( PAIR_COUNT * 2 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < PAIR_COUNT; i++ )
+    SHashPut( hash, keys + i, keys + PAIR_COUNT - 1 - i );
+
+  copy = SHashCopy( hash );
+  if( !copy )
+    return "the hash could not be copied";
+
+  for( i = 0; i < PAIR_COUNT; i++ )
+    if( SHashGet( copy, keys + i ) != keys + PAIR_COUNT - 1 - i )
+      return "a key was not found in the copy";
+
+  SHashPut( copy, keys, keys );
+  if( SHashGet( hash, keys ) != keys + PAIR_COUNT - 1 )
+    return "a change to the copy was seen in the original";
+
+  SHashDestroy( copy );
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestGetFromEmptySHash
 ( void )
@@ -516,6 +728,53 @@ TestGetFromPopulatedSHash
   return NULL;
 }
 
+const char *
+TestGetOrPutExistingKey
+( void )
+{
+  shash_t *hash;
+  void *key = "Test Key";
+  void *value = "Test Value";
+
+  hash = SHashNewDictionary();
+  if( !hash )
+    return "could not build an empty hash";
+
+  SHashPut( hash, key, value );
+  if( SHashGetOrPut( hash, key, "Other Value" ) != value )
+    return "the existing value was not returned";
+
+  if( SHashGet( hash, key ) != value || SHashSize( hash ) != 1 )
+    return "the existing value was replaced";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestGetOrPutNewKey
+( void )
+{
+  shash_t *hash;
+  void *key = "Test Key";
+  void *value = "Test Value";
+
+  hash = BuildSHash();
+  if( !hash )
+    return "could not build a populated hash";
+
+  if( SHashGetOrPut( hash, key, value ) != value )
+    return "the new value was not returned";
+
+  if( SHashGet( hash, key ) != value )
+    return "the new value was not put";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestGetWithCollidingKeys
 ( void )
@@ -540,6 +799,111 @@ TestGetWithCollidingKeys
   return NULL;
 }
 
+const char *
+TestNewFromPairs
+( void )
+{
+  static char keys[PAIR_COUNT];
+  shash_t *hash;
+  size_t i;
+  unsigned threads;
+  void **pair_keys, **pair_values;
+
+  pair_keys = malloc( PAIR_COUNT * 2 * sizeof( void * ) );
+  pair_values = malloc( PAIR_COUNT * 2 * sizeof( void * ) );
+  if( !pair_keys || !pair_values )
+    return "could not allocate the pairs";
+
+  // every key is given twice, with only the second value to be kept
+  for( i = 0; i < PAIR_COUNT; i++ ){
+    pair_keys[i] = pair_keys[i+PAIR_COUNT] = keys + i;
+    pair_values[i] = keys;
+    pair_values[i+PAIR_COUNT] = keys + i;
+  }
+  pair_keys[7] = pair_keys[7+PAIR_COUNT] = NULL;
+  pair_values[9+PAIR_COUNT] = NULL;
+
+  for( threads = 1; threads <= 8; threads *= 2 ){
+    hash = SHashNewFromPairs( pair_keys, pair_values, PAIR_COUNT * 2, threads );
+    if( !hash )
+      return "could not build a hash from pairs";
+
+    if( SHashSize( hash ) != PAIR_COUNT - 1 )
+      return "the size did not count each new key once";
+
+    for( i = 0; i < PAIR_COUNT; i++ ){
+      if( i == 7 ){
+        if( SHashGet( hash, keys + i ) != NULL )
+          return "a pair with a NULL key was put";
+      } else if( i == 9 ){
+        if( SHashGet( hash, keys + i ) != keys )
+          return "a pair with a NULL value was not skipped";
+      } else if( SHashGet( hash, keys + i ) != keys + i )
+        return "the last value of a key was not kept";
+    }
+
+    SHashDestroy( hash );
+  }
+
+  free( pair_keys );
+  free( pair_values );
+
+  return NULL;
+}
+
+const char *
+TestNewUsesMixedPointerHash
+( void )
+{
+  shash_t *hash;
+
+  hash = SHashNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHashGetHasher( hash ) != MixedPointerHash )
+    return "the new hash did not use MixedPointerHash";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestPutClusteredKeys
+( void )
+{
+  static char blocks[64][1024];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewSized( 1024 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHashSetFolder( hash, ModFold );
+  SHashSetHasher( hash, PointerHash );
+  if( SHashDefenseCount( hash ) != 0 )
+    return "a new hash had a defense counted";
+
+  for( i = 0; i < 64; i++ )
+    SHashPut( hash, blocks[i], blocks[i] );
+
+  if( SHashGetHasher( hash ) != MixedPointerHash )
+    return "the clustered hasher was not upgraded";
+
+  if( SHashDefenseCount( hash ) != 1 )
+    return "the defense was not counted once";
+
+  for( i = 0; i < 64; i++ )
+    if( SHashGet( hash, blocks[i] ) != blocks[i] )
+      return "a key was lost by the defense";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestPutExistingKeyIntoFullSHash
 ( void )
@@ -716,6 +1080,42 @@ TestRemove
   return NULL;
 }
 
+const char *
+TestRemoveFromCrowdedSHash
+( void )
+{
+  static char keys[1000];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewSized( 1200 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHashSetFolder( hash, ModFold );
+  for( i = 0; i < 1000; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  for( i = 0; i < 1000; i += 3 )
+    if( SHashRemove( hash, keys + i ) != keys + i )
+      return "a key could not be removed";
+
+  for( i = 0; i < 1000; i++ ){
+    if( i % 3 == 0 && SHashGet( hash, keys + i ) != NULL )
+      return "a removed key was found";
+
+    if( i % 3 != 0 && SHashGet( hash, keys + i ) != keys + i )
+      return "a key was lost when another was removed";
+  }
+
+  if( SHashSize( hash ) != 666 )
+    return "the size did not drop with each remove";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestRemoveNonExistentKey
 ( void )
@@ -765,6 +1165,46 @@ TestSetCapacity
   return NULL;
 }
 
+const char *
+TestSetCapacityParallel
+( void )
+{
+  static char keys[PAIR_COUNT];
+  shash_t *hash;
+  size_t capacities[3] = { PAIR_COUNT * 4, PAIR_COUNT + 1, PAIR_COUNT * 2 };
+  size_t c, i;
+  unsigned short layout;
+
+  for( layout = SHASH_INTERLEAVED; layout <= SHASH_SPLIT; layout++ ){
+    hash = SHashNewSized( PAIR_COUNT * 2 );
+    if( !hash )
+      return "could not build a new hash";
+
+    SHashSetLayout( hash, layout );
+    for( i = 0; i < PAIR_COUNT; i++ )
+      SHashPut( hash, keys + i, keys + PAIR_COUNT - 1 - i );
+
+    for( c = 0; c < 3; c++ ){
+      if( SHashSetCapacityParallel( hash, capacities[c], 4 ) != hash )
+        return "the hash could not be resized";
+
+      if( SHashCapacity( hash ) != capacities[c] || SHashSize( hash ) != PAIR_COUNT )
+        return "the capacity or size was wrong after a resize";
+
+      for( i = 0; i < PAIR_COUNT; i++ )
+        if( SHashGet( hash, keys + i ) != keys + PAIR_COUNT - 1 - i )
+          return "an element was lost when the hash was resized";
+    }
+
+    if( SHashContains( hash, keys ) != keys + PAIR_COUNT - 1 )
+      return "an element could not be found by value after a resize";
+
+    SHashDestroy( hash );
+  }
+
+  return NULL;
+}
+
 const char *
 TestSetElementComparator
 ( void )
@@ -840,6 +1280,46 @@ TestSetHasher
   return NULL;
 }
 
+const char *
+TestSetHasherToAutoHash
+( void )
+{
+  static long long keys[256][2];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewSized( 1024 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHashSetFolder( hash, ModFold );
+  SHashSetHasher( hash, PointerHash );
+  SHashSetHasher( hash, SHashAutoHash );
+  if( SHashGetHasher( hash ) != PointerHash )
+    return "the hasher was changed before training";
+
+  for( i = 0; i < 255; i++ )
+    SHashPut( hash, keys[i], keys[i] );
+
+  if( SHashGetHasher( hash ) != PointerHash )
+    return "the hasher was changed before enough keys were added";
+
+  SHashPut( hash, keys[255], keys[255] );
+  if( SHashGetHasher( hash ) != MixedPointerHash )
+    return "the clustered hasher was not replaced";
+
+  for( i = 0; i < 256; i++ )
+    if( SHashGet( hash, keys[i] ) != keys[i] )
+      return "a key was lost by training";
+
+  if( SHashSize( hash ) != 256 )
+    return "the size changed during training";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestSetHasherWithCollisions
 ( void )
@@ -1017,6 +1497,96 @@ TestSetKeyComparatorWithEqualKeys
   return NULL;
 }
 
+const char *
+TestSetLayout
+( void )
+{
+  static char keys[200];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewSized( 256 );
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHashLayout( hash ) != SHASH_INTERLEAVED )
+    return "a new hash was not interleaved";
+
+  for( i = 0; i < 100; i++ )
+    SHashPut( hash, keys + i, keys + i + 1 );
+
+  if( SHashSetLayout( hash, SHASH_SPLIT ) != hash || SHashLayout( hash ) != SHASH_SPLIT )
+    return "the layout could not be set";
+
+  for( i = 0; i < 100; i++ )
+    if( SHashGet( hash, keys + i ) != keys + i + 1 )
+      return "an element was lost when the layout changed";
+
+  for( i = 100; i < 200; i++ )
+    SHashPut( hash, keys + i, keys + i + 1 );
+
+  SHashSetCapacity( hash, 400 );
+  if( SHashContains( hash, keys + 150 ) != keys + 149 )
+    return "an element could not be found by value in the split layout";
+
+  SHashSetLayout( hash, SHASH_INTERLEAVED );
+  for( i = 0; i < 200; i++ )
+    if( SHashGet( hash, keys + i ) != keys + i + 1 )
+      return "an element was lost in the split layout";
+
+  if( SHashSize( hash ) != 200 )
+    return "the size changed with the layout";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestSetLowWater
+( void )
+{
+  static char keys[200];
+  shash_t *hash;
+  size_t capacity, i, j;
+
+  hash = SHashNewSized( 1024 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 200; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  SHashRemove( hash, keys );
+  if( SHashCapacity( hash ) != 1024 )
+    return "a hash without a mark was shrunk";
+
+  if( SHashSetLowWater( hash, 12 ) != hash || SHashLowWater( hash ) != 12 )
+    return "the mark could not be set";
+
+  // the last key is kept, as the capacity of an empty hash is given as 0
+  for( i = 1; i < 199; i++ ){
+    capacity = SHashCapacity( hash );
+    SHashRemove( hash, keys + i );
+
+    if( SHashCapacity( hash ) != capacity ){
+      if( SHashCapacity( hash ) != capacity / 2 || SHashSize( hash ) * 100 >= capacity * 12 )
+        return "the capacity was not halved when the load dropped below the mark";
+
+      for( j = i + 1; j < 200; j++ )
+        if( SHashGet( hash, keys + j ) != keys + j )
+          return "an element was lost when the hash shrank";
+    }
+  }
+
+  if( SHashCapacity( hash ) != SHASH_MIN_CAPACITY || SHashGet( hash, keys + 199 ) != keys + 199 )
+    return "the hash did not shrink to the smallest capacity";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
 const char *
 TestSize
 ( void )
@@ -1027,6 +1597,59 @@ TestSize
   return NULL;
 }
 
+const char *
+TestSnapshot
+( void )
+{
+  static char keys[PAIR_COUNT];
+  shash_t *hash, *snapshot;
+  size_t i;
+
+  hash = SHashNewSized( PAIR_COUNT * 2 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < PAIR_COUNT / 2; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  snapshot = SHashSnapshot( hash );
+  if( !snapshot )
+    return "a snapshot could not be taken";
+
+  if( SHashSize( snapshot ) != PAIR_COUNT / 2 || SHashCapacity( snapshot ) != PAIR_COUNT * 2 )
+    return "the snapshot did not have the size and capacity of the hash";
+
+  SHashPut( hash, keys, keys + 1 );
+  SHashPut( hash, keys + PAIR_COUNT / 2, keys );
+  SHashPut( snapshot, keys + 1, keys );
+
+  if( SHashGet( snapshot, keys ) != keys || SHashGet( snapshot, keys + PAIR_COUNT / 2 ) != NULL )
+    return "a change to the hash was seen in the snapshot";
+
+  if( SHashGet( hash, keys + 1 ) != keys + 1 )
+    return "a change to the snapshot was seen in the hash";
+
+  if( SHashGet( hash, keys ) != keys + 1 || SHashGet( snapshot, keys + 1 ) != keys )
+    return "a change was lost when a segment was copied";
+
+  SHashSetCapacity( hash, PAIR_COUNT * 4 );
+  for( i = PAIR_COUNT / 2; i < PAIR_COUNT; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  SHashDestroy( hash );
+
+  for( i = 2; i < PAIR_COUNT / 2; i++ )
+    if( SHashGet( snapshot, keys + i ) != keys + i )
+      return "an element of the snapshot was lost";
+
+  if( SHashSize( snapshot ) != PAIR_COUNT / 2 )
+    return "the size of the snapshot changed with the hash";
+
+  SHashDestroy( snapshot );
+
+  return NULL;
+}
+
 /**
  * Tests the SHashToString function an empty SHash.
  *
@@ -1074,3 +1697,148 @@ TestToStringWithPopulatedSHash
 {
   return NULL;
 }
+
+const char *
+TestTrainHasherWithDictionary
+( void )
+{
+  static char words[100][8];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewDictionary();
+  if( !hash )
+    return "could not build a new dictionary";
+
+  for( i = 0; i < 100; i++ ){
+    sprintf( words[i], "word%d", (int) i );
+    SHashPut( hash, words[i], words[i] );
+  }
+
+  if( !SHashTrainHasher( hash ) )
+    return "training failed";
+
+#ifdef __WOODPILE_CITY_HASHER
+  if( SHashGetHasher( hash ) == CityHash )
+    return "the constant hasher was picked";
+#endif
+
+  for( i = 0; i < 100; i++ )
+    if( SHashGet( hash, words[i] ) != words[i] )
+      return "a word was lost by training";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestTrainHasherWithTooFewKeys
+( void )
+{
+  static long long keys[32][128];
+  shash_t *hash;
+  size_t i;
+
+  // keys a whole table apart fold into a single bucket under PointerHash
+  hash = SHashNewSized( 1024 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHashSetFolder( hash, ModFold );
+  SHashSetHasher( hash, PointerHash );
+
+  for( i = 0; i < 31; i++ )
+    SHashPut( hash, keys[i], keys[i] );
+
+  if( SHashTrainHasher( hash ) != hash )
+    return "training with too few keys failed";
+
+  if( SHashGetHasher( hash ) != PointerHash )
+    return "the hasher was replaced on too small a sample";
+
+  SHashPut( hash, keys[31], keys[31] );
+  SHashTrainHasher( hash );
+  if( SHashGetHasher( hash ) != MixedPointerHash )
+    return "the clustered hasher was not replaced once there were enough keys";
+
+  for( i = 0; i < 32; i++ )
+    if( SHashGet( hash, keys[i] ) != keys[i] )
+      return "a key was lost by training";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestTrimToSize
+( void )
+{
+  static char keys[100];
+  shash_t *hash;
+  size_t i;
+
+  hash = SHashNewSized( 65536 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 100; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  if( SHashTrimToSize( hash ) != hash || SHashCapacity( hash ) != 200 )
+    return "the hash was not trimmed to twice its size";
+
+  for( i = 0; i < 100; i++ )
+    if( SHashGet( hash, keys + i ) != keys + i )
+      return "an element was lost when the hash was trimmed";
+
+  SHashSetCapacity( hash, 150 );
+  if( SHashTrimToSize( hash ) != hash || SHashCapacity( hash ) != 150 )
+    return "a hash smaller than twice its size was changed";
+
+  SHashDestroy( hash );
+
+  hash = SHashNewSized( 4096 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHashPut( hash, keys, keys );
+  SHashTrimToSize( hash );
+  if( SHashCapacity( hash ) != SHASH_MIN_CAPACITY || SHashGet( hash, keys ) != keys )
+    return "a nearly empty hash was not trimmed to the smallest capacity";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestUpsert
+( void )
+{
+  shash_t *hash;
+  int calls = 0;
+  void *key = "Test Key", *value;
+
+  hash = SHashNewDictionary();
+  if( !hash )
+    return "could not build an empty hash";
+
+  value = SHashUpsert( hash, key, CountingBuilder, &calls );
+  if( calls != 1 || value != key )
+    return "the value was not built for a missing key";
+
+  if( SHashUpsert( hash, key, CountingBuilder, &calls ) != value || calls != 1 )
+    return "the value was built again for an existing key";
+
+  if( SHashUpsert( hash, "Missing Key", CountingBuilder, NULL ) != NULL )
+    return "a non-NULL value was returned when nothing was built";
+
+  if( SHashGet( hash, "Missing Key" ) != NULL || SHashSize( hash ) != 1 )
+    return "a key was put without a value";
+
+  SHashDestroy( hash );
+
+  return NULL;
+}
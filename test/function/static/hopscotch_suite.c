@@ -0,0 +1,342 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hopscotch.h>
+#include "test/function/static/hopscotch_suite.h"
+#include "test/helper.h"
+
+static char keys[KEY_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Hopscotch Hash Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( GetWithNullParameters )
+  TEST( NewSizedWithZeroCapacity )
+  TEST( PutWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( GetFromEmptyHash )
+  TEST( IsEmptyAndSize )
+  TEST( PutExistingKey )
+  TEST( PutIntoFullNeighborhood )
+  TEST( PutToHighLoad )
+  TEST( Remove )
+  TEST( SetCapacity )
+  TEST( SetHashing )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestGetWithNullParameters
+( void )
+{
+  shopscotch_t *hash;
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHopscotchGet( NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL hash";
+
+  if( SHopscotchGet( hash, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestNewSizedWithZeroCapacity
+( void )
+{
+  if( SHopscotchNewSized( 0 ) != NULL )
+    return "a hash was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPutWithNullParameters
+( void )
+{
+  shopscotch_t *hash;
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHopscotchPut( NULL, keys, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL hash";
+
+  if( SHopscotchPut( hash, NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( SHopscotchSize( hash ) != 0 )
+    return "something was put into the hash";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestGetFromEmptyHash
+( void )
+{
+  shopscotch_t *hash;
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( SHopscotchGet( hash, keys ) != NULL )
+    return "a value was found in an empty hash";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  shopscotch_t *hash;
+
+  if( !SHopscotchIsEmpty( NULL ) || SHopscotchSize( NULL ) != 0 )
+    return "a NULL hash was not empty";
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  if( !SHopscotchIsEmpty( hash ) || SHopscotchSize( hash ) != 0 )
+    return "a new hash was not empty";
+
+  SHopscotchPut( hash, keys, keys );
+  SHopscotchPut( hash, keys + 1, keys + 1 );
+  SHopscotchPut( hash, keys, keys );
+  if( SHopscotchIsEmpty( hash ) || SHopscotchSize( hash ) != 2 )
+    return "the size did not count each key once";
+
+  SHopscotchRemove( hash, keys );
+  if( SHopscotchSize( hash ) != 1 )
+    return "the size did not drop after a remove";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestPutExistingKey
+( void )
+{
+  shopscotch_t *hash;
+  void *first = "first";
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  SHopscotchPut( hash, keys, first );
+  if( SHopscotchPut( hash, keys, keys ) != first )
+    return "the previous value was not returned";
+
+  if( SHopscotchGet( hash, keys ) != keys )
+    return "the value was not replaced";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestPutIntoFullNeighborhood
+( void )
+{
+  shopscotch_t *hash;
+  size_t i;
+
+  hash = SHopscotchNewSized( 256 );
+  if( !hash )
+    return "could not build a new hash";
+
+  SHopscotchSetHasher( hash, NullHash );
+  for( i = 0; i < SHOPSCOTCH_NEIGHBORHOOD; i++ )
+    if( SHopscotchPut( hash, keys + i, keys + i + 1 ) != keys + i + 1 )
+      return "a key could not be put into its neighborhood";
+
+  if( SHopscotchPut( hash, keys + i, keys + i ) != NULL )
+    return "a key was put outside of its neighborhood";
+
+  if( SHopscotchSize( hash ) != SHOPSCOTCH_NEIGHBORHOOD )
+    return "the size changed after a failed put";
+
+  for( i = 0; i < SHOPSCOTCH_NEIGHBORHOOD; i++ )
+    if( SHopscotchGet( hash, keys + i ) != keys + i + 1 )
+      return "a key sharing a home slot was not found";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestPutToHighLoad
+( void )
+{
+  shopscotch_t *hash;
+  size_t count, i;
+
+  hash = SHopscotchNewSized( KEY_COUNT );
+  if( !hash )
+    return "could not build a new hash";
+
+  count = KEY_COUNT * 95 / 100;
+  for( i = 0; i < count; i++ )
+    if( SHopscotchPut( hash, keys + i, keys + i ) != keys + i )
+      return "a key could not be put below 95% load";
+
+  for( i = 0; i < count; i++ )
+    if( SHopscotchGet( hash, keys + i ) != keys + i )
+      return "a key was lost at high load";
+
+  for( i = count; i < KEY_COUNT; i++ )
+    if( SHopscotchGet( hash, keys + i ) != NULL )
+      return "a missing key was found";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestRemove
+( void )
+{
+  shopscotch_t *hash;
+  void *value = "value";
+
+  hash = SHopscotchNew();
+  if( !hash )
+    return "could not build a new hash";
+
+  SHopscotchPut( hash, keys, value );
+  SHopscotchPut( hash, keys + 1, keys + 1 );
+
+  if( SHopscotchRemove( hash, keys ) != value )
+    return "the removed value was not returned";
+
+  if( SHopscotchGet( hash, keys ) != NULL )
+    return "a removed key was found";
+
+  if( SHopscotchRemove( hash, keys ) != NULL )
+    return "a key was removed twice";
+
+  if( SHopscotchGet( hash, keys + 1 ) != keys + 1 )
+    return "a remaining key was lost";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestSetCapacity
+( void )
+{
+  shopscotch_t *hash;
+  size_t i;
+
+  hash = SHopscotchNewSized( 128 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 100; i++ )
+    SHopscotchPut( hash, keys + i, keys + i );
+
+  if( SHopscotchSetCapacity( hash, 1024 ) != hash || SHopscotchCapacity( hash ) != 1024 )
+    return "the capacity could not be increased";
+
+  for( i = 100; i < 800; i++ )
+    SHopscotchPut( hash, keys + i, keys + i );
+
+  if( SHopscotchSetCapacity( hash, 500 ) != NULL )
+    return "the capacity was set below the size";
+
+  if( SHopscotchCapacity( hash ) != 1024 || SHopscotchSize( hash ) != 800 )
+    return "a failed capacity change altered the hash";
+
+  for( i = 0; i < 800; i++ )
+    if( SHopscotchGet( hash, keys + i ) != keys + i )
+      return "a key was lost when the capacity changed";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
+
+const char *
+TestSetHashing
+( void )
+{
+  shopscotch_t *hash;
+  size_t i;
+
+  hash = SHopscotchNewSized( 512 );
+  if( !hash )
+    return "could not build a new hash";
+
+  for( i = 0; i < 200; i++ )
+    SHopscotchPut( hash, keys + i, keys + i );
+
+  if( SHopscotchSetSeed( hash, 42 ) != hash )
+    return "the seed could not be set";
+
+  if( SHopscotchSetFolder( hash, XORFold ) != hash )
+    return "the folder could not be set";
+
+  for( i = 0; i < 200; i++ )
+    if( SHopscotchGet( hash, keys + i ) != keys + i )
+      return "a key was lost when the hashing changed";
+
+  if( SHopscotchSetHasher( hash, NullHash ) != NULL )
+    return "a hasher was set that could not hold the keys";
+
+  if( SHopscotchSetFolder( hash, ModFold ) != hash || SHopscotchSetHasher( hash, PointerHash ) != hash )
+    return "the hasher could not be set";
+
+  for( i = 0; i < 200; i++ )
+    if( SHopscotchGet( hash, keys + i ) != keys + i )
+      return "a key was lost when the hasher changed";
+
+  SHopscotchDestroy( hash );
+
+  return NULL;
+}
@@ -0,0 +1,323 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+#include "test/function/static/mpmcqueue_suite.h"
+#include "test/helper.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+static unsigned char received[THREAD_COUNT * THREAD_VALUES];
+static char values[THREAD_COUNT * THREAD_VALUES];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static MPMC Queue Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( NewWithZeroCapacity )
+  TEST( TryPopFromNullQueue )
+  TEST( TryPushWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( Capacity )
+  TEST( IsEmptyAndSize )
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  TEST( ManyThreads )
+#endif
+  TEST( TryPopInOrderAcrossWraps )
+  TEST( TryPushToFullQueue )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void *
+Consume
+( void *worker )
+{
+  struct worker_t *consumer = worker;
+  long last[THREAD_COUNT];
+  size_t i, producer, value;
+  char *element;
+
+  for( i = 0; i < THREAD_COUNT; i++ )
+    last[i] = -1;
+
+  for( i = 0; i < THREAD_VALUES; i++ ){
+    while( !( element = SMPMCQueueTryPop( consumer->queue ) ) )
+      sched_yield();
+
+    value = element - values;
+    producer = value / THREAD_VALUES;
+    if( (long) ( value % THREAD_VALUES ) <= last[producer] )
+      consumer->failed = 1;
+
+    last[producer] = value % THREAD_VALUES;
+    received[value]++;
+  }
+
+  return NULL;
+}
+
+static
+void *
+Produce
+( void *worker )
+{
+  struct worker_t *producer = worker;
+  size_t i;
+
+  for( i = 0; i < THREAD_VALUES; i++ )
+    while( !SMPMCQueueTryPush( producer->queue, values + producer->first + i ) )
+      sched_yield();
+
+  return NULL;
+}
+#endif
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( SMPMCQueueNew( 0 ) != NULL )
+    return "a queue was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestTryPopFromNullQueue
+( void )
+{
+  if( SMPMCQueueTryPop( NULL ) != NULL )
+    return "a value was popped from a NULL queue";
+
+  return NULL;
+}
+
+const char *
+TestTryPushWithNullParameters
+( void )
+{
+  smpmcqueue_t *queue;
+
+  queue = SMPMCQueueNew( 16 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SMPMCQueueTryPush( NULL, values ) != NULL )
+    return "a non-NULL value was returned for a NULL queue";
+
+  if( SMPMCQueueTryPush( queue, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !SMPMCQueueIsEmpty( queue ) )
+    return "something was pushed to the queue";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestCapacity
+( void )
+{
+  smpmcqueue_t *queue;
+
+  if( SMPMCQueueCapacity( NULL ) != 0 )
+    return "a NULL queue did not have a capacity of 0";
+
+  queue = SMPMCQueueNew( 100 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SMPMCQueueCapacity( queue ) != 128 )
+    return "the capacity was not rounded up to a power of two";
+
+  SMPMCQueueDestroy( queue );
+
+  queue = SMPMCQueueNew( 1 );
+  if( !queue )
+    return "could not build a queue of capacity 1";
+
+  if( SMPMCQueueCapacity( queue ) != 2 )
+    return "a queue of capacity 1 was not given a capacity of 2";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  smpmcqueue_t *queue;
+
+  if( !SMPMCQueueIsEmpty( NULL ) || SMPMCQueueSize( NULL ) != 0 )
+    return "a NULL queue was not empty";
+
+  queue = SMPMCQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( !SMPMCQueueIsEmpty( queue ) || SMPMCQueueSize( queue ) != 0 )
+    return "a new queue was not empty";
+
+  SMPMCQueueTryPush( queue, values );
+  SMPMCQueueTryPush( queue, values + 1 );
+  if( SMPMCQueueIsEmpty( queue ) || SMPMCQueueSize( queue ) != 2 )
+    return "the size did not follow the pushes";
+
+  SMPMCQueueTryPop( queue );
+  if( SMPMCQueueSize( queue ) != 1 )
+    return "the size did not follow a pop";
+
+  SMPMCQueueTryPop( queue );
+  if( !SMPMCQueueIsEmpty( queue ) )
+    return "the queue was not empty after every value was popped";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+const char *
+TestManyThreads
+( void )
+{
+  struct worker_t consumers[THREAD_COUNT], producers[THREAD_COUNT];
+  pthread_t consumer_threads[THREAD_COUNT], producer_threads[THREAD_COUNT];
+  smpmcqueue_t *queue;
+  size_t i;
+  unsigned t;
+
+  queue = SMPMCQueueNew( 8 );
+  if( !queue )
+    return "could not build a new queue";
+
+  memset( received, 0, sizeof( received ) );
+
+  for( t = 0; t < THREAD_COUNT; t++ ){
+    consumers[t].failed = producers[t].failed = 0;
+    consumers[t].first = 0;
+    producers[t].first = t * THREAD_VALUES;
+    consumers[t].queue = producers[t].queue = queue;
+
+    if( pthread_create( &consumer_threads[t], NULL, Consume, &consumers[t] ) != 0
+        || pthread_create( &producer_threads[t], NULL, Produce, &producers[t] ) != 0 )
+      return "could not start the workers";
+  }
+
+  for( t = 0; t < THREAD_COUNT; t++ ){
+    pthread_join( producer_threads[t], NULL );
+    pthread_join( consumer_threads[t], NULL );
+  }
+
+  for( t = 0; t < THREAD_COUNT; t++ )
+    if( consumers[t].failed )
+      return "the values of a producer were received out of order";
+
+  for( i = 0; i < THREAD_COUNT * THREAD_VALUES; i++ )
+    if( received[i] != 1 )
+      return "a value was not received exactly once";
+
+  if( !SMPMCQueueIsEmpty( queue ) )
+    return "the queue was not empty after every value was received";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
+#endif
+
+const char *
+TestTryPopInOrderAcrossWraps
+( void )
+{
+  smpmcqueue_t *queue;
+  size_t i, popped = 0;
+
+  queue = SMPMCQueueNew( 8 );
+  if( !queue )
+    return "could not build a new queue";
+
+  // three pushes for every two pops keeps the ring turning as it fills
+  for( i = 0; i < VALUE_COUNT; i++ ){
+    while( !SMPMCQueueTryPush( queue, values + i ) )
+      if( SMPMCQueueTryPop( queue ) != values + popped++ )
+        return "a value was popped out of order while the queue was full";
+
+    if( i % 3 != 0 && SMPMCQueueTryPop( queue ) != values + popped++ )
+      return "a value was popped out of order";
+  }
+
+  while( popped < VALUE_COUNT )
+    if( SMPMCQueueTryPop( queue ) != values + popped++ )
+      return "a value was popped out of order while draining the queue";
+
+  if( SMPMCQueueTryPop( queue ) != NULL )
+    return "a value was popped from a drained queue";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestTryPushToFullQueue
+( void )
+{
+  smpmcqueue_t *queue;
+  size_t i;
+
+  queue = SMPMCQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  for( i = 0; i < 4; i++ )
+    if( SMPMCQueueTryPush( queue, values + i ) != queue )
+      return "a push to a queue with room failed";
+
+  if( SMPMCQueueTryPush( queue, values + 4 ) != NULL )
+    return "a push to a full queue succeeded";
+
+  SMPMCQueueTryPop( queue );
+
+  if( SMPMCQueueTryPush( queue, values + 4 ) != queue )
+    return "a push failed after room was made";
+
+  for( i = 1; i < 5; i++ )
+    if( SMPMCQueueTryPop( queue ) != values + i )
+      return "the values were not kept in order";
+
+  SMPMCQueueDestroy( queue );
+
+  return NULL;
+}
@@ -8,6 +8,8 @@
 #include "test/function/static/queue_suite.h"
 #include "test/helper.h"
 
+static char values[VALUE_COUNT];
+
 int
 main
 ( void )
@@ -18,10 +20,13 @@ main
 #ifdef __WOODPILE_PARAMETER_VALIDATION
   TEST( CopyNullQueue )
   TEST( PopFromNullQueue )
+  TEST( PushNWithNullParameters )
   TEST( PushNullValue )
   TEST( PushToNullQueue )
+  TEST( SetCapacityOfNullQueue )
 #endif
 
+  TEST( Capacity )
   TEST( ContainsDuplicateValues )
   TEST( ContainsNonExistentValue )
   TEST( ContainsNullValue )
@@ -37,12 +42,16 @@ main
   TEST( IsEmptyWithPopulatedQueue )
   TEST( IsEmptyWithNullQueue )
   TEST( New )
+  TEST( NewSized )
   TEST( PeekAtEmptyQueue )
   TEST( PeekAtNullQueue )
   TEST( PeekAtPopulatedQueue )
   TEST( PopFromEmptyQueue )
   TEST( PopFromPopulatedQueue )
+  TEST( PopNAcrossWrap )
   TEST( PopRemovesValue )
+  TEST( PushGrowsWrappedQueue )
+  TEST( PushNAcrossWrap )
   TEST( PushToEmptyQueue )
   TEST( PushToPopulatedQueue )
   TEST( RemoveDuplicateValues )
@@ -51,9 +60,12 @@ main
   TEST( RemoveNonExistentValue )
   TEST( RemoveNullValue )
   TEST( RemoveUniqueValue )
+  TEST( RemoveWrappedValue )
+  TEST( SetCapacityDropsBack )
   TEST( Size )
   TEST( SizeWithEmptyQueue )
   TEST( SizeWithNullQueue )
+  TEST( TrimToSize )
 
   if( failure_count > 0 )
     return EXIT_FAILURE;
@@ -61,6 +73,27 @@ main
     return EXIT_SUCCESS;
 }
 
+const char *
+TestCapacity
+( void )
+{
+  SQueue *queue;
+
+  if( SQueueCapacity( NULL ) != 0 )
+    return "a NULL Queue did not have a capacity of 0";
+
+  queue = SQueueNew();
+  if( !queue )
+    return "could not build a Queue";
+
+  if( SQueueCapacity( queue ) != 128 )
+    return "a new Queue did not have the default capacity";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
 const char *
 TestContainsDuplicateValues
 ( void )
@@ -354,6 +387,36 @@ TestNew
   return NULL;
 }
 
+const char *
+TestNewSized
+( void )
+{
+  SQueue *queue;
+
+  queue = SQueueNewSized( 100 );
+  if( !queue )
+    return "a new sized Queue could not be constructed";
+
+  if( SQueueCapacity( queue ) != 128 )
+    return "the capacity was not rounded up to a power of two";
+
+  if( !SQueueIsEmpty( queue ) )
+    return "a new sized Queue was not empty";
+
+  SQueueDestroy( queue );
+
+  queue = SQueueNewSized( 0 );
+  if( !queue )
+    return "a Queue of capacity 0 could not be constructed";
+
+  if( SQueueCapacity( queue ) != 1 )
+    return "a Queue of capacity 0 was not given a capacity of 1";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
 const char *
 TestPeekAtEmptyQueue
 ( void )
@@ -454,6 +517,50 @@ TestPopFromPopulatedQueue
   return NULL;
 }
 
+const char *
+TestPopNAcrossWrap
+( void )
+{
+  void *out[VALUE_COUNT];
+  SQueue *queue;
+  size_t i;
+
+  if( SQueuePopN( NULL, out, 4 ) != 0 )
+    return "values were popped from a NULL Queue";
+
+  queue = SQueueNewSized( 8 );
+  if( !queue )
+    return "could not build a Queue";
+
+  // leave the values running past the end of the ring and back to its start
+  for( i = 0; i < 6; i++ )
+    SQueuePush( queue, values + i );
+  for( i = 0; i < 5; i++ )
+    SQueuePop( queue );
+  for( i = 6; i < 11; i++ )
+    SQueuePush( queue, values + i );
+
+  if( SQueuePopN( queue, NULL, 4 ) != 0 )
+    return "values were popped into a NULL array";
+
+  if( SQueuePopN( queue, out, 4 ) != 4 )
+    return "the number of values asked for was not popped";
+
+  if( SQueuePopN( queue, out + 4, VALUE_COUNT ) != 2 )
+    return "the rest of the Queue was not popped";
+
+  for( i = 0; i < 6; i++ )
+    if( out[i] != values + 5 + i )
+      return "the values were not popped in the order they were pushed";
+
+  if( !SQueueIsEmpty( queue ) )
+    return "the Queue was not empty after every value was popped";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
 const char *
 TestPopRemovesValue
 ( void )
@@ -495,6 +602,37 @@ TestPopRemovesValue
   return NULL;
 }
 
+const char *
+TestPushNWithNullParameters
+( void )
+{
+  SQueue *queue;
+  void *elements[3] = { values, NULL, values + 1 };
+
+  if( SQueuePushN( NULL, (void **) values, 0 ) )
+    return "a non-NULL value was returned for a NULL Queue";
+
+  queue = SQueueNew();
+  if( !queue )
+    return "could not build a Queue";
+
+  if( SQueuePushN( queue, NULL, 2 ) )
+    return "a non-NULL value was returned for a NULL array";
+
+  if( SQueuePushN( queue, NULL, 0 ) != queue )
+    return "pushing no values from a NULL array failed";
+
+  if( SQueuePushN( queue, elements, 3 ) )
+    return "a non-NULL value was returned for an array holding NULL";
+
+  if( !SQueueIsEmpty( queue ) )
+    return "something was pushed to the Queue";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
 const char *
 TestPushNullValue
 ( void )
@@ -516,6 +654,98 @@ TestPushNullValue
   return NULL;
 }
 
+const char *
+TestPushGrowsWrappedQueue
+( void )
+{
+  SQueue *queue;
+  size_t i;
+
+  queue = SQueueNewSized( 4 );
+  if( !queue )
+    return "could not build a Queue";
+
+  // leave the front in the middle of the ring so that the elements wrap
+  for( i = 0; i < 3; i++ )
+    SQueuePush( queue, values + i );
+  SQueuePop( queue );
+  SQueuePop( queue );
+
+  for( i = 3; i < VALUE_COUNT; i++ )
+    if( SQueuePush( queue, values + i ) != queue )
+      return "a push to a full Queue failed";
+
+  if( SQueueCapacity( queue ) != 16 )
+    return "the capacity was not doubled each time the Queue was full";
+
+  if( SQueueSize( queue ) != VALUE_COUNT - 2 )
+    return "the Queue did not hold every value pushed";
+
+  for( i = 2; i < VALUE_COUNT; i++ )
+    if( SQueuePop( queue ) != values + i )
+      return "the values did not keep their order through the growth";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPushNAcrossWrap
+( void )
+{
+  void *in[VALUE_COUNT];
+  SQueue *queue;
+  size_t i;
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    in[i] = values + i;
+
+  queue = SQueueNewSized( 8 );
+  if( !queue )
+    return "could not build a Queue";
+
+  for( i = 0; i < 6; i++ )
+    SQueuePush( queue, values );
+  for( i = 0; i < 5; i++ )
+    SQueuePop( queue );
+
+  // five values fit in the ring, running past its end
+  if( SQueuePushN( queue, in, 5 ) != queue )
+    return "the values could not be pushed";
+
+  if( SQueueCapacity( queue ) != 8 )
+    return "the Queue grew when the values fit";
+
+  // these need more slots than are left, so the Queue doubles
+  if( SQueuePushN( queue, in + 5, VALUE_COUNT - 5 ) != queue )
+    return "the values could not be pushed past the capacity";
+
+  if( SQueueCapacity( queue ) != 16 || SQueueSize( queue ) != VALUE_COUNT + 1 )
+    return "the Queue did not grow to hold every value";
+
+  if( SQueuePop( queue ) != values )
+    return "the value in front of the pushed values was lost";
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    if( SQueuePop( queue ) != values + i )
+      return "the values were not kept in the order they were pushed";
+
+  SQueueDestroy( queue );
+
+  queue = SQueueNewSized( 2 );
+  if( !queue )
+    return "could not build a Queue";
+
+  // doubling is not enough here, so the Queue grows straight to fit
+  if( SQueuePushN( queue, in, VALUE_COUNT ) != queue || SQueueCapacity( queue ) != 16 )
+    return "the Queue did not grow once to hold a large array";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
 const char *
 TestPushToEmptyQueue
 ( void )
@@ -728,6 +958,82 @@ TestRemoveUniqueValue
   return NULL;
 }
 
+const char *
+TestRemoveWrappedValue
+( void )
+{
+  SQueue *queue;
+  size_t i;
+
+  queue = SQueueNewSized( 4 );
+  if( !queue )
+    return "could not build a Queue";
+
+  for( i = 0; i < 3; i++ )
+    SQueuePush( queue, values + i );
+  SQueuePop( queue );
+  SQueuePop( queue );
+  for( i = 3; i < 6; i++ )
+    SQueuePush( queue, values + i );
+
+  if( SQueueRemove( queue, values + 3 ) != values + 3 )
+    return "a value at the end of the ring could not be removed";
+
+  if( SQueueSize( queue ) != 3 )
+    return "the size did not drop after the remove";
+
+  if( SQueuePop( queue ) != values + 2 || SQueuePop( queue ) != values + 4
+      || SQueuePop( queue ) != values + 5 )
+    return "the values after the removed one were not shifted across the wrap";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestSetCapacityDropsBack
+( void )
+{
+  SQueue *queue;
+  size_t i;
+
+  queue = SQueueNewSized( 8 );
+  if( !queue )
+    return "could not build a Queue";
+
+  for( i = 0; i < 6; i++ )
+    SQueuePush( queue, values + i );
+  SQueuePop( queue );
+
+  if( SQueueSetCapacity( queue, 3 ) != queue )
+    return "the capacity could not be set";
+
+  if( SQueueCapacity( queue ) != 4 )
+    return "the capacity was not rounded up to a power of two";
+
+  if( SQueueSize( queue ) != 4 )
+    return "the values past the new capacity were not dropped";
+
+  for( i = 1; i < 5; i++ )
+    if( SQueuePop( queue ) != values + i )
+      return "the values kept were not the ones at the front";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestSetCapacityOfNullQueue
+( void )
+{
+  if( SQueueSetCapacity( NULL, 10 ) )
+    return "a non-NULL value was returned for a NULL Queue";
+
+  return NULL;
+}
+
 const char *
 TestSize
 ( void )
@@ -773,3 +1079,35 @@ TestSizeWithNullQueue
 
   return NULL;
 }
+
+const char *
+TestTrimToSize
+( void )
+{
+  SQueue *queue;
+  size_t i;
+
+  if( SQueueTrimToSize( NULL ) != 0 )
+    return "a NULL Queue did not return 0";
+
+  queue = SQueueNewSized( 64 );
+  if( !queue )
+    return "could not build a Queue";
+
+  for( i = 0; i < 5; i++ )
+    SQueuePush( queue, values + i );
+
+  if( SQueueTrimToSize( queue ) != 8 )
+    return "the Queue was not trimmed to the power of two holding its size";
+
+  if( SQueueCapacity( queue ) != 8 )
+    return "the capacity did not match the value returned";
+
+  for( i = 0; i < 5; i++ )
+    if( SQueuePop( queue ) != values + i )
+      return "the values did not survive the trim";
+
+  SQueueDestroy( queue );
+
+  return NULL;
+}
@@ -0,0 +1,302 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/spscqueue.h>
+#include "test/function/static/spscqueue_suite.h"
+#include "test/helper.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+static char values[THREADED_VALUES];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static SPSC Queue Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( NewWithZeroCapacity )
+  TEST( PopFromNullQueue )
+  TEST( PushWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( Capacity )
+  TEST( IsEmptyAndSize )
+  TEST( Peek )
+  TEST( PopInOrderAcrossWraps )
+  TEST( PushToFullQueue )
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  TEST( TwoThreads )
+#endif
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void *
+Produce
+( void *queue )
+{
+  size_t i;
+
+  for( i = 0; i < THREADED_VALUES; i++ )
+    while( !SSPSCQueuePush( queue, values + i ) )
+      sched_yield();
+
+  return NULL;
+}
+#endif
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( SSPSCQueueNew( 0 ) != NULL )
+    return "a queue was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPopFromNullQueue
+( void )
+{
+  if( SSPSCQueuePop( NULL ) != NULL )
+    return "a value was popped from a NULL queue";
+
+  return NULL;
+}
+
+const char *
+TestPushWithNullParameters
+( void )
+{
+  sspscqueue_t *queue;
+
+  queue = SSPSCQueueNew( 16 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SSPSCQueuePush( NULL, values ) != NULL )
+    return "a non-NULL value was returned for a NULL queue";
+
+  if( SSPSCQueuePush( queue, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !SSPSCQueueIsEmpty( queue ) )
+    return "something was pushed to the queue";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestCapacity
+( void )
+{
+  sspscqueue_t *queue;
+
+  if( SSPSCQueueCapacity( NULL ) != 0 )
+    return "a NULL queue did not have a capacity of 0";
+
+  queue = SSPSCQueueNew( 100 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SSPSCQueueCapacity( queue ) != 128 )
+    return "the capacity was not rounded up to a power of two";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  sspscqueue_t *queue;
+
+  if( !SSPSCQueueIsEmpty( NULL ) || SSPSCQueueSize( NULL ) != 0 )
+    return "a NULL queue was not empty";
+
+  queue = SSPSCQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( !SSPSCQueueIsEmpty( queue ) || SSPSCQueueSize( queue ) != 0 )
+    return "a new queue was not empty";
+
+  SSPSCQueuePush( queue, values );
+  SSPSCQueuePush( queue, values + 1 );
+  if( SSPSCQueueIsEmpty( queue ) || SSPSCQueueSize( queue ) != 2 )
+    return "the size did not follow the pushes";
+
+  SSPSCQueuePop( queue );
+  if( SSPSCQueueSize( queue ) != 1 )
+    return "the size did not follow a pop";
+
+  SSPSCQueuePop( queue );
+  if( !SSPSCQueueIsEmpty( queue ) )
+    return "the queue was not empty after every value was popped";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPeek
+( void )
+{
+  sspscqueue_t *queue;
+
+  queue = SSPSCQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( SSPSCQueuePeek( queue ) != NULL )
+    return "a value was returned by an empty queue";
+
+  SSPSCQueuePush( queue, values );
+  SSPSCQueuePush( queue, values + 1 );
+
+  if( SSPSCQueuePeek( queue ) != values )
+    return "the front value was not returned";
+
+  if( SSPSCQueueSize( queue ) != 2 )
+    return "peeking removed a value";
+
+  if( SSPSCQueuePop( queue ) != values )
+    return "the peeked value was not popped next";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPopInOrderAcrossWraps
+( void )
+{
+  sspscqueue_t *queue;
+  size_t i, popped = 0;
+
+  queue = SSPSCQueueNew( 8 );
+  if( !queue )
+    return "could not build a new queue";
+
+  // three pushes for every two pops keeps the ring turning as it fills
+  for( i = 0; i < VALUE_COUNT; i++ ){
+    while( !SSPSCQueuePush( queue, values + i ) )
+      if( SSPSCQueuePop( queue ) != values + popped++ )
+        return "a value was popped out of order while the queue was full";
+
+    if( i % 3 != 0 && SSPSCQueuePop( queue ) != values + popped++ )
+      return "a value was popped out of order";
+  }
+
+  while( popped < VALUE_COUNT )
+    if( SSPSCQueuePop( queue ) != values + popped++ )
+      return "a value was popped out of order while draining the queue";
+
+  if( SSPSCQueuePop( queue ) != NULL )
+    return "a value was popped from a drained queue";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+const char *
+TestPushToFullQueue
+( void )
+{
+  sspscqueue_t *queue;
+  size_t i;
+
+  queue = SSPSCQueueNew( 4 );
+  if( !queue )
+    return "could not build a new queue";
+
+  for( i = 0; i < 4; i++ )
+    if( SSPSCQueuePush( queue, values + i ) != queue )
+      return "a push to a queue with room failed";
+
+  if( SSPSCQueuePush( queue, values + 4 ) != NULL )
+    return "a push to a full queue succeeded";
+
+  SSPSCQueuePop( queue );
+
+  if( SSPSCQueuePush( queue, values + 4 ) != queue )
+    return "a push failed after room was made";
+
+  for( i = 1; i < 5; i++ )
+    if( SSPSCQueuePop( queue ) != values + i )
+      return "the values were not kept in order";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+const char *
+TestTwoThreads
+( void )
+{
+  pthread_t producer;
+  sspscqueue_t *queue;
+  size_t i;
+  void *value;
+
+  queue = SSPSCQueueNew( 16 );
+  if( !queue )
+    return "could not build a new queue";
+
+  if( pthread_create( &producer, NULL, Produce, queue ) != 0 )
+    return "could not start the producer";
+
+  for( i = 0; i < THREADED_VALUES; i++ ){
+    while( !( value = SSPSCQueuePop( queue ) ) )
+      sched_yield();
+
+    if( value != values + i ){
+      pthread_join( producer, NULL );
+      return "a value was received out of order";
+    }
+  }
+
+  pthread_join( producer, NULL );
+
+  if( !SSPSCQueueIsEmpty( queue ) )
+    return "more values were received than were sent";
+
+  SSPSCQueueDestroy( queue );
+
+  return NULL;
+}
+#endif
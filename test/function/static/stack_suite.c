@@ -4,16 +4,95 @@
 
 #include <woodpile/static/stack.h>
 
+#include "test/function/static/stack_suite.h"
 #include "test/helper.h"
 
+static char values[VALUE_COUNT];
+
 int
 main( void )
 {
   unsigned failure_count = 0;
   const char *result;
 
+  TEST( PushNAndPopN )
+  TEST( PushNGrows )
+
   if( failure_count > 0 )
     return EXIT_FAILURE;
   else
     return EXIT_SUCCESS;
 }
+
+const char *
+TestPushNAndPopN
+( void )
+{
+  void *in[VALUE_COUNT], *out[VALUE_COUNT];
+  SStack *stack;
+  size_t i;
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    in[i] = values + i;
+
+  stack = SStackNew();
+  if( !stack )
+    return "could not build a Stack";
+
+  if( SStackPushN( stack, in, 10 ) != stack )
+    return "the values could not be pushed";
+
+  if( SStackPeek( stack ) != values + 9 )
+    return "the last value pushed was not on top";
+
+  if( SStackPopN( NULL, out, 4 ) != 0 || SStackPopN( stack, NULL, 4 ) != 0 )
+    return "values were popped with a NULL Stack or array";
+
+  if( SStackPopN( stack, out, 4 ) != 4 )
+    return "the number of values asked for was not popped";
+
+  for( i = 0; i < 4; i++ )
+    if( out[i] != values + 6 + i )
+      return "the popped values were not the top ones in the order pushed";
+
+  if( SStackPushN( stack, out, 4 ) != stack || SStackSize( stack ) != 10
+      || SStackPeek( stack ) != values + 9 )
+    return "pushing the popped values back did not restore the Stack";
+
+  if( SStackPopN( stack, out, VALUE_COUNT ) != 10 || !SStackIsEmpty( stack ) )
+    return "the whole Stack was not popped";
+
+  SStackDestroy( stack );
+
+  return NULL;
+}
+
+const char *
+TestPushNGrows
+( void )
+{
+  void *in[VALUE_COUNT];
+  SStack *stack;
+  size_t i;
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    in[i] = values + i;
+
+  stack = SStackNew();
+  if( !stack )
+    return "could not build a Stack";
+
+  if( SStackPushN( stack, in, VALUE_COUNT ) != stack )
+    return "the values could not be pushed past the capacity";
+
+  if( SStackCapacity( stack ) != VALUE_COUNT )
+    return "the Stack did not grow once to hold the values";
+
+  for( i = VALUE_COUNT; i > 0; i-- )
+    if( SStackPop( stack ) != values + i - 1 )
+      return "the values were not popped in reverse order";
+
+  SStackDestroy( stack );
+
+  return NULL;
+}
@@ -0,0 +1,428 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/tinylfu.h>
+#include "test/function/static/tinylfu_suite.h"
+#include "test/helper.h"
+
+static char keys[KEY_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static TinyLFU Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( GetWithNullParameters )
+  TEST( NewWithZeroCapacity )
+  TEST( PutWithNullParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( AdmitFrequentKey )
+  TEST( DestroyWithEvictor )
+  TEST( FrequencyCountsUses )
+  TEST( FrequencyIsHalved )
+  TEST( IsEmpty )
+  TEST( PutExistingKey )
+  TEST( PutKeepsCapacity )
+  TEST( Remove )
+  TEST( ScanKeepsFrequentKeys )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+static
+void
+Count
+( void *key, void *value, void *context )
+{
+  struct eviction_t *eviction = context;
+
+  if( key != value )
+    eviction->mismatched = 1;
+
+  eviction->count++;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestGetWithNullParameters
+( void )
+{
+  stinylfu_t *cache;
+
+  cache = STinyLFUNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( STinyLFUGet( NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL cache";
+
+  if( STinyLFUGet( cache, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( STinyLFUNew( 0 ) != NULL )
+    return "a cache was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPutWithNullParameters
+( void )
+{
+  stinylfu_t *cache;
+
+  cache = STinyLFUNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( STinyLFUPut( NULL, keys, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL cache";
+
+  if( STinyLFUPut( cache, NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( STinyLFUSize( cache ) != 0 )
+    return "something was put into the cache";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestAdmitFrequentKey
+( void )
+{
+  stinylfu_t *cache;
+  size_t i;
+
+  cache = STinyLFUNew( 100 );
+  if( !cache )
+    return "could not build a new cache";
+
+  for( i = 0; i < 100; i++ )
+    STinyLFUPut( cache, keys + i, keys + i );
+
+  // misses are counted too, so the key is known to be popular before it is put
+  for( i = 0; i < 5; i++ )
+    STinyLFUGet( cache, keys + 100 );
+
+  STinyLFUPut( cache, keys + 100, keys + 100 );
+  STinyLFUPut( cache, keys + 101, keys + 101 );
+  if( STinyLFUPeek( cache, keys + 100 ) != keys + 100 )
+    return "a frequently used key was not admitted";
+
+  if( STinyLFUPeek( cache, keys ) != NULL )
+    return "the probation victim was not evicted";
+
+  if( STinyLFUSize( cache ) != 100 )
+    return "the size did not stay at the capacity";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestDestroyWithEvictor
+( void )
+{
+  struct eviction_t eviction;
+  stinylfu_t *cache;
+  size_t i;
+
+  cache = STinyLFUNew( 100 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STinyLFUSetEvictor( cache, Count, &eviction );
+
+  for( i = 0; i < 60; i++ )
+    STinyLFUPut( cache, keys + i, keys + i );
+  for( i = 0; i < 30; i++ )
+    STinyLFUGet( cache, keys + i );
+
+  STinyLFUDestroy( cache );
+
+  if( eviction.count != 60 || eviction.mismatched )
+    return "the evictor was not given every entry";
+
+  return NULL;
+}
+
+const char *
+TestFrequencyCountsUses
+( void )
+{
+  stinylfu_t *cache;
+  size_t i;
+
+  cache = STinyLFUNew( 1024 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( STinyLFUFrequency( cache, keys ) != 0 )
+    return "an unused key had a use counted";
+
+  STinyLFUPut( cache, keys, keys );
+  STinyLFUGet( cache, keys );
+  STinyLFUGet( cache, keys + 1 );
+  STinyLFUPeek( cache, keys );
+
+  if( STinyLFUFrequency( cache, keys ) != 2 )
+    return "the uses of a key were not counted";
+
+  if( STinyLFUFrequency( cache, keys + 1 ) != 1 )
+    return "a miss was not counted";
+
+  for( i = 0; i < 20; i++ )
+    STinyLFUGet( cache, keys );
+
+  if( STinyLFUFrequency( cache, keys ) != 15 )
+    return "the count did not stop at 15";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestFrequencyIsHalved
+( void )
+{
+  stinylfu_t *cache;
+  size_t i;
+
+  cache = STinyLFUNew( 1024 );
+  if( !cache )
+    return "could not build a new cache";
+
+  for( i = 0; i < 15; i++ )
+    STinyLFUGet( cache, keys );
+
+  if( STinyLFUFrequency( cache, keys ) != 15 )
+    return "the uses of a key were not counted";
+
+  // a sketch of 1024 columns is halved after 10240 counts, and not again for
+  // another 10240; uses finding every counter full are not counted, so a few
+  // more gets are made than counts needed
+  for( i = 0; i < 12000; i++ )
+    STinyLFUGet( cache, keys + 1 + i % ( KEY_COUNT - 1 ) );
+
+  if( STinyLFUFrequency( cache, keys ) > 10 )
+    return "the count of a key was not halved";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestIsEmpty
+( void )
+{
+  stinylfu_t *cache;
+
+  if( !STinyLFUIsEmpty( NULL ) )
+    return "a NULL cache was not empty";
+
+  cache = STinyLFUNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  if( !STinyLFUIsEmpty( cache ) )
+    return "a new cache was not empty";
+
+  STinyLFUPut( cache, keys, keys );
+  if( STinyLFUIsEmpty( cache ) )
+    return "a cache with a key was empty";
+
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestPutExistingKey
+( void )
+{
+  struct eviction_t eviction;
+  stinylfu_t *cache;
+  void *first = "first";
+
+  cache = STinyLFUNew( 16 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STinyLFUSetEvictor( cache, Count, &eviction );
+
+  STinyLFUPut( cache, keys, first );
+  STinyLFUPut( cache, keys + 1, keys + 1 );
+
+  if( STinyLFUPut( cache, keys, keys ) != first )
+    return "the previous value was not returned";
+
+  if( eviction.count != 0 || STinyLFUSize( cache ) != 2 )
+    return "a replaced value was evicted";
+
+  if( STinyLFUGet( cache, keys ) != keys )
+    return "the value was not replaced";
+
+  STinyLFUSetEvictor( cache, NULL, NULL );
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestPutKeepsCapacity
+( void )
+{
+  size_t capacities[] = { 1, 2, 5, 100, 1000 };
+  struct eviction_t eviction;
+  stinylfu_t *cache;
+  size_t c, i;
+
+  for( c = 0; c < sizeof( capacities ) / sizeof( capacities[0] ); c++ ){
+    cache = STinyLFUNew( capacities[c] );
+    if( !cache )
+      return "could not build a new cache";
+
+    eviction.count = 0;
+    eviction.mismatched = 0;
+    STinyLFUSetEvictor( cache, Count, &eviction );
+
+    for( i = 0; i < KEY_COUNT; i++ ){
+      STinyLFUPut( cache, keys + i, keys + i );
+      if( i % 3 == 0 )
+        STinyLFUGet( cache, keys + i / 2 );
+
+      if( STinyLFUSize( cache ) > capacities[c] )
+        return "the size passed the capacity";
+    }
+
+    if( STinyLFUSize( cache ) != capacities[c] )
+      return "the cache was not full";
+
+    if( eviction.count + STinyLFUSize( cache ) != KEY_COUNT || eviction.mismatched )
+      return "the evictor was not given each evicted entry";
+
+    STinyLFUSetEvictor( cache, NULL, NULL );
+    STinyLFUDestroy( cache );
+  }
+
+  return NULL;
+}
+
+const char *
+TestRemove
+( void )
+{
+  struct eviction_t eviction;
+  stinylfu_t *cache;
+  size_t i;
+
+  cache = STinyLFUNew( 4 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STinyLFUSetEvictor( cache, Count, &eviction );
+
+  for( i = 0; i < 4; i++ )
+    STinyLFUPut( cache, keys + i, keys + i );
+
+  if( STinyLFURemove( cache, keys + 2 ) != keys + 2 )
+    return "the removed value was not returned";
+
+  if( STinyLFUPeek( cache, keys + 2 ) != NULL || STinyLFUSize( cache ) != 3 )
+    return "the key was not removed";
+
+  if( STinyLFURemove( cache, keys + 2 ) != NULL )
+    return "a key was removed twice";
+
+  STinyLFUPut( cache, keys + 4, keys + 4 );
+  if( eviction.count != 0 || STinyLFUSize( cache ) != 4 )
+    return "a key was evicted while a removed entry was free";
+
+  STinyLFUSetEvictor( cache, NULL, NULL );
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
+
+const char *
+TestScanKeepsFrequentKeys
+( void )
+{
+  struct eviction_t eviction;
+  stinylfu_t *cache;
+  size_t i, j;
+
+  cache = STinyLFUNew( 100 );
+  if( !cache )
+    return "could not build a new cache";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STinyLFUSetEvictor( cache, Count, &eviction );
+
+  // the extra key pushes the last frequent key out of the window, so that
+  // each is then used again and protected
+  for( i = 0; i < 50; i++ )
+    STinyLFUPut( cache, keys + i, keys + i );
+  STinyLFUPut( cache, keys + 999, keys + 999 );
+
+  for( j = 0; j < 3; j++ )
+    for( i = 0; i < 50; i++ )
+      STinyLFUGet( cache, keys + i );
+
+  // a least recently used cache would lose every one of the frequent keys
+  for( i = 1000; i < 1200; i++ )
+    STinyLFUPut( cache, keys + i, keys + i );
+
+  for( i = 0; i < 50; i++ )
+    if( STinyLFUPeek( cache, keys + i ) != keys + i )
+      return "a frequently used key was evicted by a scan";
+
+  if( eviction.count != 151 || eviction.mismatched )
+    return "the evictor was not given each evicted entry";
+
+  STinyLFUSetEvictor( cache, NULL, NULL );
+  STinyLFUDestroy( cache );
+
+  return NULL;
+}
@@ -0,0 +1,413 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/ttl.h>
+#include "test/function/static/ttl_suite.h"
+#include "test/helper.h"
+
+static char keys[KEY_COUNT];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static TTL Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( GetWithNullParameters )
+  TEST( NewWithZeroSizes )
+  TEST( PutWithInvalidParameters )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( AdvanceExpiresOnDeadline )
+  TEST( AdvancePastWholeWheel )
+  TEST( AdvanceWithBudget )
+  TEST( GetDropsExpiredEntry )
+  TEST( IsEmpty )
+  TEST( PutExistingKey )
+  TEST( Remove )
+  TEST( SetCapacity )
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+static
+void
+Count
+( void *key, void *value, void *context )
+{
+  struct eviction_t *eviction = context;
+
+  if( key != value )
+    eviction->mismatched = 1;
+
+  eviction->count++;
+}
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestGetWithNullParameters
+( void )
+{
+  sttl_t *ttl;
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  if( STTLGet( NULL, keys ) != NULL )
+    return "a non-NULL value was returned for a NULL map";
+
+  if( STTLGet( ttl, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestNewWithZeroSizes
+( void )
+{
+  if( STTLNew( 0, 16 ) != NULL )
+    return "a map was created with no capacity";
+
+  if( STTLNew( 16, 0 ) != NULL )
+    return "a map was created with no wheel";
+
+  return NULL;
+}
+
+const char *
+TestPutWithInvalidParameters
+( void )
+{
+  sttl_t *ttl;
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  if( STTLPut( NULL, keys, keys, 10 ) != NULL )
+    return "a non-NULL value was returned for a NULL map";
+
+  if( STTLPut( ttl, NULL, keys, 10 ) != NULL )
+    return "a non-NULL value was returned for a NULL key";
+
+  if( STTLPut( ttl, keys, keys, 0 ) != NULL )
+    return "a non-NULL value was returned for no lifetime";
+
+  if( STTLSize( ttl ) != 0 )
+    return "something was put into the map";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestAdvanceExpiresOnDeadline
+( void )
+{
+  struct eviction_t eviction;
+  size_t i;
+  sttl_t *ttl;
+  unsigned long long now;
+
+  // lifetimes run to several turns of a 16 slot wheel
+  ttl = STTLNew( 100, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STTLSetEvictor( ttl, Count, &eviction );
+
+  for( i = 0; i < 100; i++ )
+    STTLPut( ttl, keys + i, keys + i, i + 1 );
+
+  for( now = 1; now <= 100; now++ ){
+    if( STTLAdvance( ttl, now, KEY_COUNT ) != 1 )
+      return "the wrong number of entries expired on a tick";
+
+    if( STTLSize( ttl ) != 100 - now || eviction.count != now )
+      return "an expired entry was not dropped";
+
+    if( STTLDeadline( ttl, keys + now ) != now + 1 && now < 100 )
+      return "an entry expired before its deadline";
+  }
+
+  if( eviction.mismatched )
+    return "the evictor was given the wrong value";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestAdvancePastWholeWheel
+( void )
+{
+  struct eviction_t eviction;
+  size_t i;
+  sttl_t *ttl;
+
+  ttl = STTLNew( 100, 8 );
+  if( !ttl )
+    return "could not build a new map";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STTLSetEvictor( ttl, Count, &eviction );
+
+  for( i = 0; i < 100; i++ )
+    STTLPut( ttl, keys + i, keys + i, i * 1000 + 1 );
+
+  // a turn of eight slots and a hundred entries are all the work there is
+  if( STTLAdvance( ttl, 1000000000ULL, 108 ) != 100 )
+    return "not every entry expired";
+
+  if( !STTLIsEmpty( ttl ) || eviction.count != 100 || eviction.mismatched )
+    return "an expired entry was not given to the evictor";
+
+  if( STTLNow( ttl ) != 1000000000ULL )
+    return "the time was not advanced";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestAdvanceWithBudget
+( void )
+{
+  struct eviction_t eviction;
+  size_t calls = 0, expired, i, total = 0;
+  sttl_t *ttl;
+
+  ttl = STTLNew( KEY_COUNT, 64 );
+  if( !ttl )
+    return "could not build a new map";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STTLSetEvictor( ttl, Count, &eviction );
+
+  for( i = 0; i < KEY_COUNT; i++ )
+    STTLPut( ttl, keys + i, keys + i, 1 + i % 3 );
+
+  if( STTLAdvance( ttl, 10, 0 ) != 0 )
+    return "entries were expired with no budget";
+
+  if( STTLGet( ttl, keys ) != NULL )
+    return "an entry past its deadline was found";
+
+  do {
+    expired = STTLAdvance( ttl, 10, 50 );
+    if( expired > 50 )
+      return "more entries were expired than the budget allowed";
+
+    total += expired;
+  } while( ++calls < 1000 && !STTLIsEmpty( ttl ) );
+
+  if( !STTLIsEmpty( ttl ) )
+    return "not every entry expired";
+
+  // the entry dropped by the lookup was not left for the wheel to find
+  if( total != KEY_COUNT - 1 || eviction.count != KEY_COUNT || eviction.mismatched )
+    return "the evictor was not given each expired entry";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestGetDropsExpiredEntry
+( void )
+{
+  struct eviction_t eviction;
+  sttl_t *ttl;
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STTLSetEvictor( ttl, Count, &eviction );
+
+  STTLAdvance( ttl, 100, 0 );
+  STTLPut( ttl, keys, keys, 5 );
+  if( STTLDeadline( ttl, keys ) != 105 )
+    return "the deadline was not set from the current tick";
+
+  STTLAdvance( ttl, 104, 0 );
+  if( STTLGet( ttl, keys ) != keys )
+    return "an entry was missed before its deadline";
+
+  STTLAdvance( ttl, 105, 0 );
+  if( STTLGet( ttl, keys ) != NULL )
+    return "an entry was found on its deadline";
+
+  if( STTLSize( ttl ) != 0 || eviction.count != 1 || eviction.mismatched )
+    return "the expired entry was not dropped";
+
+  if( STTLAdvance( ttl, 200, KEY_COUNT ) != 0 )
+    return "a dropped entry was expired again";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestIsEmpty
+( void )
+{
+  sttl_t *ttl;
+
+  if( !STTLIsEmpty( NULL ) )
+    return "a NULL map was not empty";
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  if( !STTLIsEmpty( ttl ) )
+    return "a new map was not empty";
+
+  STTLPut( ttl, keys, keys, 1 );
+  if( STTLIsEmpty( ttl ) )
+    return "a map with a key was empty";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestPutExistingKey
+( void )
+{
+  sttl_t *ttl;
+  void *first = "first";
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  STTLPut( ttl, keys, first, 5 );
+  STTLAdvance( ttl, 3, KEY_COUNT );
+
+  if( STTLPut( ttl, keys, keys, 5 ) != first )
+    return "the previous value was not returned";
+
+  if( STTLSize( ttl ) != 1 || STTLDeadline( ttl, keys ) != 8 )
+    return "the deadline was not moved";
+
+  if( STTLAdvance( ttl, 7, KEY_COUNT ) != 0 || STTLGet( ttl, keys ) != keys )
+    return "the entry expired on its old deadline";
+
+  if( STTLAdvance( ttl, 8, KEY_COUNT ) != 1 )
+    return "the entry did not expire on its new deadline";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestRemove
+( void )
+{
+  struct eviction_t eviction;
+  sttl_t *ttl;
+
+  ttl = STTLNew( 16, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  eviction.count = 0;
+  eviction.mismatched = 0;
+  STTLSetEvictor( ttl, Count, &eviction );
+
+  STTLPut( ttl, keys, keys, 5 );
+  STTLPut( ttl, keys + 1, keys + 1, 5 );
+
+  if( STTLRemove( ttl, keys ) != keys )
+    return "the removed value was not returned";
+
+  if( STTLGet( ttl, keys ) != NULL || STTLSize( ttl ) != 1 )
+    return "the key was not removed";
+
+  if( STTLRemove( ttl, keys ) != NULL )
+    return "a key was removed twice";
+
+  if( STTLAdvance( ttl, 5, KEY_COUNT ) != 1 || eviction.count != 1 )
+    return "a removed entry was expired";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
+
+const char *
+TestSetCapacity
+( void )
+{
+  size_t i;
+  sttl_t *ttl;
+
+  ttl = STTLNew( 4, 16 );
+  if( !ttl )
+    return "could not build a new map";
+
+  for( i = 0; i < 4; i++ )
+    STTLPut( ttl, keys + i, keys + i, 10 + i );
+
+  if( STTLPut( ttl, keys + 4, keys + 4, 10 ) != NULL )
+    return "a key was put into a full map";
+
+  if( STTLSetCapacity( ttl, 500 ) != ttl || STTLCapacity( ttl ) != 500 )
+    return "the capacity was not set";
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  if( STTLSetCapacity( ttl, 100 ) != NULL )
+    return "the capacity was reduced";
+#endif
+
+  for( i = 4; i < 500; i++ )
+    if( STTLPut( ttl, keys + i, keys + i, 10 + i ) != keys + i )
+      return "a key was not put after the map was grown";
+
+  for( i = 0; i < 500; i++ )
+    if( STTLGet( ttl, keys + i ) != keys + i )
+      return "a key was lost when the map was grown";
+
+  if( STTLAdvance( ttl, 259, KEY_COUNT * 2 ) != 250 || STTLGet( ttl, keys + 249 ) != NULL )
+    return "the entries did not expire after the map was grown";
+
+  STTLDestroy( ttl );
+
+  return NULL;
+}
@@ -0,0 +1,360 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+#include "test/function/static/wsdeque_suite.h"
+#include "test/helper.h"
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+# include <pthread.h>
+# include <sched.h>
+
+static unsigned char received[OWNER_VALUES];
+#endif
+
+static char values[OWNER_VALUES];
+
+int
+main
+( void )
+{
+  unsigned failure_count = 0;
+  const char *result;
+
+  printf( "### Static Work-Stealing Deque Functionality Test Suite\n" );
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+  printf( "\nRunning Parameter Validation Tests\n======\n" );
+
+  TEST( NewWithZeroCapacity )
+  TEST( PopFromNullDeque )
+  TEST( PushWithNullParameters )
+  TEST( StealFromNullDeque )
+#endif
+
+  printf( "\nRunning Specific Tests\n======\n" );
+
+  TEST( Capacity )
+  TEST( IsEmptyAndSize )
+  TEST( PopInReverseOrder )
+  TEST( PushGrowsWrappedDeque )
+  TEST( StealInOrder )
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+  TEST( StealWhileOwnerWorks )
+#endif
+
+  printf( "\n" );
+
+  if( failure_count > 0 )
+    return EXIT_FAILURE;
+  else
+    return EXIT_SUCCESS;
+}
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+static
+void *
+Steal
+( void *worker )
+{
+  struct thief_t *thief = worker;
+  long last = -1;
+  char *element;
+
+  for( ;; ){
+    element = SWSDequeSteal( thief->deque );
+    if( !element ){
+      // the owner may have popped the last element after the done flag was read
+      if( atomic_load( thief->done ) && SWSDequeIsEmpty( thief->deque ) )
+        break;
+
+      sched_yield();
+      continue;
+    }
+
+    if( element - values <= last )
+      thief->failed = 1;
+
+    last = element - values;
+    received[last]++;
+  }
+
+  return NULL;
+}
+#endif
+
+#ifdef __WOODPILE_PARAMETER_VALIDATION
+
+const char *
+TestNewWithZeroCapacity
+( void )
+{
+  if( SWSDequeNew( 0 ) != NULL )
+    return "a deque was created with no capacity";
+
+  return NULL;
+}
+
+const char *
+TestPopFromNullDeque
+( void )
+{
+  if( SWSDequePop( NULL ) != NULL )
+    return "a value was popped from a NULL deque";
+
+  return NULL;
+}
+
+const char *
+TestPushWithNullParameters
+( void )
+{
+  swsdeque_t *deque;
+
+  deque = SWSDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SWSDequePush( NULL, values ) != NULL )
+    return "a non-NULL value was returned for a NULL deque";
+
+  if( SWSDequePush( deque, NULL ) != NULL )
+    return "a non-NULL value was returned for a NULL element";
+
+  if( !SWSDequeIsEmpty( deque ) )
+    return "something was pushed to the deque";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestStealFromNullDeque
+( void )
+{
+  if( SWSDequeSteal( NULL ) != NULL )
+    return "a value was stolen from a NULL deque";
+
+  return NULL;
+}
+
+#endif
+
+const char *
+TestCapacity
+( void )
+{
+  swsdeque_t *deque;
+
+  if( SWSDequeCapacity( NULL ) != 0 )
+    return "a NULL deque did not have a capacity of 0";
+
+  deque = SWSDequeNew( 100 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SWSDequeCapacity( deque ) != 128 )
+    return "the capacity was not rounded up to a power of two";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestIsEmptyAndSize
+( void )
+{
+  swsdeque_t *deque;
+
+  if( !SWSDequeIsEmpty( NULL ) || SWSDequeSize( NULL ) != 0 )
+    return "a NULL deque was not empty";
+
+  deque = SWSDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( !SWSDequeIsEmpty( deque ) || SWSDequeSize( deque ) != 0 )
+    return "a new deque was not empty";
+
+  SWSDequePush( deque, values );
+  SWSDequePush( deque, values + 1 );
+  SWSDequePush( deque, values + 2 );
+  if( SWSDequeIsEmpty( deque ) || SWSDequeSize( deque ) != 3 )
+    return "the size did not follow the pushes";
+
+  SWSDequePop( deque );
+  SWSDequeSteal( deque );
+  if( SWSDequeSize( deque ) != 1 )
+    return "the size did not follow a pop and a steal";
+
+  SWSDequePop( deque );
+  if( !SWSDequeIsEmpty( deque ) || SWSDequeSize( deque ) != 0 )
+    return "the deque was not empty after every element was taken";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestPopInReverseOrder
+( void )
+{
+  swsdeque_t *deque;
+  size_t i;
+
+  deque = SWSDequeNew( 8 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SWSDequePop( deque ) != NULL )
+    return "a value was popped from an empty deque";
+
+  for( i = 0; i < 8; i++ )
+    SWSDequePush( deque, values + i );
+
+  for( i = 8; i > 0; i-- )
+    if( SWSDequePop( deque ) != values + i - 1 )
+      return "the elements were not popped in reverse order";
+
+  if( SWSDequePop( deque ) != NULL )
+    return "a value was popped from a drained deque";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestPushGrowsWrappedDeque
+( void )
+{
+  swsdeque_t *deque;
+  size_t i;
+
+  deque = SWSDequeNew( 4 );
+  if( !deque )
+    return "could not build a new deque";
+
+  // steals move the top part way around the ring before it first fills
+  for( i = 0; i < 3; i++ )
+    SWSDequePush( deque, values + i );
+  for( i = 0; i < 3; i++ )
+    SWSDequeSteal( deque );
+
+  for( i = 0; i < VALUE_COUNT; i++ )
+    if( SWSDequePush( deque, values + i ) != deque )
+      return "a push to a full deque failed";
+
+  if( SWSDequeCapacity( deque ) != 128 )
+    return "the capacity was not doubled each time the deque was full";
+
+  for( i = 0; i < VALUE_COUNT / 2; i++ )
+    if( SWSDequeSteal( deque ) != values + i )
+      return "the elements were not stolen in order after growing";
+
+  for( i = VALUE_COUNT; i > VALUE_COUNT / 2; i-- )
+    if( SWSDequePop( deque ) != values + i - 1 )
+      return "the elements were not popped in reverse order after growing";
+
+  if( !SWSDequeIsEmpty( deque ) )
+    return "the deque was not empty after every element was taken";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+const char *
+TestStealInOrder
+( void )
+{
+  swsdeque_t *deque;
+  size_t i;
+
+  deque = SWSDequeNew( 8 );
+  if( !deque )
+    return "could not build a new deque";
+
+  if( SWSDequeSteal( deque ) != NULL )
+    return "a value was stolen from an empty deque";
+
+  for( i = 0; i < 8; i++ )
+    SWSDequePush( deque, values + i );
+
+  for( i = 0; i < 8; i++ )
+    if( SWSDequeSteal( deque ) != values + i )
+      return "the elements were not stolen in the order they were pushed";
+
+  if( SWSDequeSteal( deque ) != NULL )
+    return "a value was stolen from a drained deque";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+const char *
+TestStealWhileOwnerWorks
+( void )
+{
+  struct thief_t thieves[THIEF_COUNT];
+  pthread_t threads[THIEF_COUNT];
+  swsdeque_t *deque;
+  atomic_int done;
+  size_t i;
+  unsigned t;
+  char *element;
+
+  // a small ring makes the owner grow it while thieves are reading it
+  deque = SWSDequeNew( 2 );
+  if( !deque )
+    return "could not build a new deque";
+
+  memset( received, 0, sizeof( received ) );
+  atomic_init( &done, 0 );
+
+  for( t = 0; t < THIEF_COUNT; t++ ){
+    thieves[t].deque = deque;
+    thieves[t].done = &done;
+    thieves[t].failed = 0;
+
+    if( pthread_create( &threads[t], NULL, Steal, &thieves[t] ) != 0 )
+      return "could not start the thieves";
+  }
+
+  // the owner keeps the deque shallow so that it often races for the last one
+  for( i = 0; i < OWNER_VALUES; i++ ){
+    if( !SWSDequePush( deque, values + i ) )
+      return "a push failed";
+
+    if( i % 3 == 2 )
+      while( ( element = SWSDequePop( deque ) ) )
+        received[element - values]++;
+  }
+
+  atomic_store( &done, 1 );
+
+  for( t = 0; t < THIEF_COUNT; t++ )
+    pthread_join( threads[t], NULL );
+
+  for( t = 0; t < THIEF_COUNT; t++ )
+    if( thieves[t].failed )
+      return "a thief stole values out of order";
+
+  for( i = 0; i < OWNER_VALUES; i++ )
+    if( received[i] != 1 )
+      return "a value was not taken exactly once";
+
+  if( !SWSDequeIsEmpty( deque ) )
+    return "the deque was not empty after every value was taken";
+
+  SWSDequeDestroy( deque );
+
+  return NULL;
+}
+#endif
@@ -14,6 +14,18 @@ CollisionHash
     return WoodpileHash( data, seed );
 }
 
+void *
+CountingBuilder
+( const void *key, void *context )
+{
+  if( !context )
+    return NULL;
+
+  ( *(int *) context )++;
+
+  return (void *) key;
+}
+
 char *
 ElementToString
 ( const void *element )
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/dynamic/queue.h>
+#include <woodpile/static/queue.h>
+#include "test/performance/dynamic/queue_suite.h"
+
+#define MAX_VALUES (1 << 23)
+#define STEADY_OPERATIONS (1 << 26)
+
+int
+main
+( void )
+{
+  char *values;
+  size_t count, depth;
+
+  values = malloc( MAX_VALUES );
+  if( !values ){
+    printf( "Could not allocate the values.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Growth from empty, then draining\n" );
+  for( count = 1 << 15; count <= MAX_VALUES; count <<= 4 )
+    MeasureGrowth( count, values );
+
+  printf( "\nSteady state push and pop pairs: %d\n", STEADY_OPERATIONS );
+  for( depth = 16; depth <= 65536; depth *= 64 )
+    MeasureSteadyState( depth, values );
+
+  free( values );
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+static
+void
+MeasureGrowth
+( size_t count, char *values )
+{
+  double pop_time, push_time;
+  dqueue_t *dqueue;
+  size_t i, round;
+  struct timespec begin;
+  SQueue *squeue;
+  unsigned short in_order = 1;
+
+  dqueue = DQueueNew();
+  squeue = SQueueNew();
+  if( !dqueue || !squeue ){
+    printf( "Could not build the queues.\n" );
+    DQueueDestroy( dqueue );
+    SQueueDestroy( squeue );
+    return;
+  }
+
+  for( round = 1; round <= 2; round++ ){
+    clock_gettime( CLOCK_MONOTONIC, &begin );
+    for( i = 0; i < count; i++ )
+      DQueuePush( dqueue, values + i );
+    push_time = ElapsedMilliseconds( &begin );
+
+    clock_gettime( CLOCK_MONOTONIC, &begin );
+    for( i = 0; i < count; i++ )
+      in_order &= DQueuePop( dqueue ) == values + i;
+    pop_time = ElapsedMilliseconds( &begin );
+
+    printf( "DQueue round %d  Values: %8d  Push ms: %7.1f  Pop ms: %7.1f%s\n",
+            (int)round, (int)count, push_time, pop_time,
+            in_order ? "" : "  (lost a value)" );
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < count; i++ )
+    SQueuePush( squeue, values + i );
+  push_time = ElapsedMilliseconds( &begin );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < count; i++ )
+    in_order &= SQueuePop( squeue ) == values + i;
+  pop_time = ElapsedMilliseconds( &begin );
+
+  printf( "SQueue         Values: %8d  Push ms: %7.1f  Pop ms: %7.1f%s\n",
+          (int)count, push_time, pop_time, in_order ? "" : "  (lost a value)" );
+
+  DQueueDestroy( dqueue );
+  SQueueDestroy( squeue );
+}
+
+static
+void
+MeasureSteadyState
+( size_t depth, char *values )
+{
+  double dqueue_time, squeue_time;
+  dqueue_t *dqueue;
+  size_t i;
+  struct timespec begin;
+  SQueue *squeue;
+  void *sink = NULL;
+
+  dqueue = DQueueNew();
+  squeue = SQueueNewSized( depth );
+  if( !dqueue || !squeue ){
+    printf( "Could not build the queues.\n" );
+    DQueueDestroy( dqueue );
+    SQueueDestroy( squeue );
+    return;
+  }
+
+  for( i = 0; i < depth; i++ ){
+    DQueuePush( dqueue, values + i );
+    SQueuePush( squeue, values + i );
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < STEADY_OPERATIONS; i++ ){
+    DQueuePush( dqueue, values + i % depth );
+    sink = DQueuePop( dqueue );
+  }
+  dqueue_time = ElapsedMilliseconds( &begin );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < STEADY_OPERATIONS; i++ ){
+    SQueuePush( squeue, values + i % depth );
+    sink = SQueuePop( squeue );
+  }
+  squeue_time = ElapsedMilliseconds( &begin );
+
+  printf( "Depth: %6d  DQueue Mops/s: %7.1f  SQueue Mops/s: %7.1f%s\n",
+          (int)depth, STEADY_OPERATIONS / dqueue_time / 1000.0,
+          STEADY_OPERATIONS / squeue_time / 1000.0,
+          sink ? "" : "  (lost a value)" );
+
+  DQueueDestroy( dqueue );
+  SQueueDestroy( squeue );
+}
@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <woodpile/hasher.h>
+#include "test/performance/hasher_suite.h"
+
+#define BUCKET_COUNT 4096
+#define SPEED_ROUNDS 50
+
+int
+main
+( void )
+{
+  const char *filename = "../data/american_english_words.txt";
+  char **words;
+  size_t i, word_count;
+  FILE *stream;
+
+  // reading the dictionary file
+  stream = fopen( filename, "r" );
+  if( !stream ){
+    printf( "Could not open the words file %s\n", filename );
+    return EXIT_FAILURE;
+  }
+
+  words = ReadWords( stream, &word_count );
+  fclose( stream );
+  if( !words ){
+    printf( "Could not read the words file %s\n", filename );
+    return EXIT_FAILURE;
+  }
+
+
+  // measure the speed of each hasher
+  printf( "Hashing %d words %d times\n", (int)word_count, SPEED_ROUNDS );
+#ifdef __WOODPILE_CRC_HASHER
+  MeasureSpeed( "CRC", CRCHash, words, word_count );
+#endif
+#ifdef __WOODPILE_SPOOKY_HASHER
+  MeasureSpeed( "Spooky", SpookyHash, words, word_count );
+#endif
+#ifdef __WOODPILE_WOODPILE_HASHER
+  MeasureSpeed( "Woodpile", WoodpileHash, words, word_count );
+#endif
+
+
+  // measure the speed of each batch hasher
+  printf( "\nHashing %d words %d times in batches\n", (int)word_count, SPEED_ROUNDS );
+#ifdef __WOODPILE_CRC_HASHER
+  MeasureBatchSpeed( "CRC", CRCHashBatch, words, word_count );
+#endif
+#ifdef __WOODPILE_SPOOKY_HASHER
+  MeasureBatchSpeed( "Spooky", SpookyHashBatch, words, word_count );
+#endif
+#ifdef __WOODPILE_WOODPILE_HASHER
+  MeasureBatchSpeed( "Woodpile", WoodpileHashBatch, words, word_count );
+#endif
+
+
+  // measure the distribution of each hasher
+  printf( "\nHashing %d words into %d buckets\n", (int)word_count, BUCKET_COUNT );
+#ifdef __WOODPILE_CRC_HASHER
+  MeasureDistribution( "CRC", CRCHash, words, word_count );
+#endif
+#ifdef __WOODPILE_SPOOKY_HASHER
+  MeasureDistribution( "Spooky", SpookyHash, words, word_count );
+#endif
+#ifdef __WOODPILE_WOODPILE_HASHER
+  MeasureDistribution( "Woodpile", WoodpileHash, words, word_count );
+#endif
+
+
+  // cleaning up
+  for( i = 0; i < word_count; i++ )
+    free( words[i] );
+  free( words );
+
+  return EXIT_SUCCESS;
+}
+
+static
+void
+MeasureBatchSpeed
+( const char *name, batch_hasher_t batch_hasher, char **words, size_t word_count )
+{
+  clock_t begin, total_clocks;
+  size_t i, round;
+  unsigned long long *hashes, sink = 0;
+
+  hashes = malloc( sizeof( unsigned long long ) * word_count );
+  if( !hashes ){
+    printf( "Could not allocate the hashes for %s\n", name );
+    return;
+  }
+
+  begin = clock();
+  for( round = 0; round < SPEED_ROUNDS; round++ ){
+    batch_hasher( (const void * const *) words, word_count, round, hashes );
+    for( i = 0; i < word_count; i++ )
+      sink ^= hashes[i];
+  }
+  total_clocks = clock() - begin;
+
+  printf( "%-9s Clock Cycles: %8d  (result %016llx)\n",
+          name, (int)total_clocks, sink );
+
+  free( hashes );
+}
+
+static
+void
+MeasureDistribution
+( const char *name, hasher_t hasher, char **words, size_t word_count )
+{
+  size_t buckets[BUCKET_COUNT];
+  size_t empty = 0, i, largest = 0;
+  double chi_squared = 0.0, difference, expected;
+
+  memset( buckets, 0, sizeof( buckets ) );
+
+  for( i = 0; i < word_count; i++ )
+    buckets[ModFold( hasher( words[i], 0 ), BUCKET_COUNT )]++;
+
+  expected = (double) word_count / BUCKET_COUNT;
+  for( i = 0; i < BUCKET_COUNT; i++ ){
+    if( buckets[i] == 0 )
+      empty++;
+
+    if( buckets[i] > largest )
+      largest = buckets[i];
+
+    difference = buckets[i] - expected;
+    chi_squared += difference * difference / expected;
+  }
+
+  printf( "%-9s Empty Buckets: %5d  Largest Bucket: %5d  Chi-Squared: %12.1f\n",
+          name, (int)empty, (int)largest, chi_squared );
+}
+
+static
+void
+MeasureSpeed
+( const char *name, hasher_t hasher, char **words, size_t word_count )
+{
+  clock_t begin, total_clocks;
+  size_t i, round;
+  unsigned long long sink = 0;
+
+  begin = clock();
+  for( round = 0; round < SPEED_ROUNDS; round++ )
+    for( i = 0; i < word_count; i++ )
+      sink ^= hasher( words[i], round );
+  total_clocks = clock() - begin;
+
+  printf( "%-9s Clock Cycles: %8d  (result %016llx)\n",
+          name, (int)total_clocks, sink );
+}
+
+static
+char **
+ReadWords
+( FILE *stream, size_t *word_count )
+{
+  char line[100], **resized, **words;
+  size_t capacity = 1024, length;
+
+  words = malloc( sizeof( char * ) * capacity );
+  if( !words )
+    return NULL;
+
+  *word_count = 0;
+  while( fgets( line, 100, stream ) ){
+    length = strcspn( line, "\r\n" );
+    line[length] = '\0';
+
+    if( *word_count == capacity ){
+      capacity *= 2;
+      resized = realloc( words, sizeof( char * ) * capacity );
+      if( !resized )
+        return NULL;
+      words = resized;
+    }
+
+    words[*word_count] = malloc( length + 1 );
+    if( !words[*word_count] )
+      return NULL;
+    memcpy( words[*word_count], line, length + 1 );
+    (*word_count)++;
+  }
+
+  return words;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/blockingqueue.h>
+#include "test/performance/static/blockingqueue_suite.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+#define MAX_BATCH 256
+#define QUEUE_CAPACITY 1024
+#define TRANSFER_VALUES (1 << 22)
+
+static char *values;
+
+int
+main
+( void )
+{
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  size_t batch;
+  unsigned producers;
+
+  values = malloc( TRANSFER_VALUES );
+  if( !values ){
+    printf( "Could not allocate the values.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Values passed through a queue of capacity %d: %d\n",
+          QUEUE_CAPACITY, TRANSFER_VALUES );
+  for( producers = 1; producers <= MAX_PRODUCERS; producers *= 4 )
+    for( batch = 1; batch <= MAX_BATCH; batch *= 16 )
+      MeasureBlockingQueue( producers, batch );
+
+  free( values );
+#else
+  printf( "Threads are not available, so there is nothing to measure.\n" );
+#endif
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void
+MeasureBlockingQueue
+( unsigned producers, size_t batch )
+{
+  void *out[MAX_BATCH];
+  struct producer_t producer_workers[MAX_PRODUCERS];
+  pthread_t producer_threads[MAX_PRODUCERS];
+  double time;
+  size_t batches = 0, received = 0;
+  sblockingqueue_t *queue;
+  struct timespec begin;
+  unsigned t;
+
+  queue = SBlockingQueueNew( QUEUE_CAPACITY );
+  if( !queue ){
+    printf( "Could not build a blocking queue.\n" );
+    return;
+  }
+
+  for( t = 0; t < producers; t++ ){
+    producer_workers[t].count = TRANSFER_VALUES / producers;
+    producer_workers[t].first = producer_workers[t].count * t;
+    producer_workers[t].queue = queue;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( t = 0; t < producers; t++ )
+    if( pthread_create( &producer_threads[t], NULL, Produce, &producer_workers[t] ) != 0 ){
+      printf( "Could not start a producer.\n" );
+      exit( EXIT_FAILURE );
+    }
+
+  while( received < TRANSFER_VALUES ){
+    received += SBlockingQueuePopBatch( queue, out, batch, SBLOCKINGQUEUE_FOREVER );
+    batches++;
+  }
+
+  for( t = 0; t < producers; t++ )
+    pthread_join( producer_threads[t], NULL );
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "Producers: %d  Batch: %3d  ms: %7.1f  Mops/s: %6.1f  Average Batch: %6.1f\n",
+          producers, (int)batch, time, TRANSFER_VALUES / time / 1000.0,
+          (double)received / batches );
+
+  SBlockingQueueDestroy( queue );
+}
+
+static
+void *
+Produce
+( void *producer )
+{
+  struct producer_t *worker = producer;
+  size_t i;
+
+  for( i = 0; i < worker->count; i++ )
+    SBlockingQueuePush( worker->queue, values + worker->first + i, SBLOCKINGQUEUE_FOREVER );
+
+  return NULL;
+}
+#endif
@@ -7,6 +7,13 @@
 #include "test/performance/static/hash_suite.h"
 
 #define HASH_CAPACITY 3000
+#define POINTER_CAPACITY 2048
+#define POINTER_COUNT 1500
+#define POINTER_ROUNDS 200
+#define POINTER_SEED 0x5eed
+#define MISS_CAPACITY (1 << 20)
+#define MISS_LOOKUPS (1 << 21)
+#define BUILD_PAIRS (1 << 22)
 
 int
 main
@@ -15,6 +22,10 @@ main
   const char *filename = "../../data/american_english_words.txt";
   clock_t city_load_time, spooky_load_time, woodpile_load_time;
   shash_t *city_hash, *spooky_hash, *woodpile_hash; 
+  void *pointers[POINTER_COUNT];
+  char *build_keys, *miss_keys;
+  void **build_pairs;
+  size_t i;
 
   // opening the dictionary file
   FILE *words = fopen( filename, "r" );
@@ -66,11 +77,84 @@ main
   printf( "Woodpile Hash Load Clock Cycles: %5d\n", (int)woodpile_load_time );
 
 
+  // measure pointer keys, which are all aligned by the allocator
+  for( i = 0; i < POINTER_COUNT; i++ ){
+    pointers[i] = malloc( 24 );
+    if( !pointers[i] ){
+      printf( "Could not allocate the pointer keys.\n" );
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf( "\n%d malloc'd pointer keys, capacity %d, %d lookup rounds\n",
+          POINTER_COUNT, POINTER_CAPACITY, POINTER_ROUNDS );
+  MeasurePointerSHash( "PointerHash/ModFold", PointerHash, ModFold, pointers, POINTER_COUNT );
+  MeasurePointerSHash( "PointerHash/XORFold", PointerHash, XORFold, pointers, POINTER_COUNT );
+  MeasurePointerSHash( "MixedPointerHash/ModFold", MixedPointerHash, ModFold, pointers, POINTER_COUNT );
+  MeasurePointerSHash( "MixedPointerHash/XORFold", MixedPointerHash, XORFold, pointers, POINTER_COUNT );
+
+  for( i = 0; i < POINTER_COUNT; i++ )
+    free( pointers[i] );
+
+
+  // measure lookups that miss in each layout
+  miss_keys = malloc( MISS_CAPACITY * 2 );
+  if( !miss_keys ){
+    printf( "Could not allocate the miss keys.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "\nCapacity %d, %d missing lookups\n", MISS_CAPACITY, MISS_LOOKUPS );
+  MeasureMissHeavySHash( "Interleaved", SHASH_INTERLEAVED, 50, miss_keys );
+  MeasureMissHeavySHash( "Split", SHASH_SPLIT, 50, miss_keys );
+  MeasureMissHeavySHash( "Interleaved", SHASH_INTERLEAVED, 75, miss_keys );
+  MeasureMissHeavySHash( "Split", SHASH_SPLIT, 75, miss_keys );
+  MeasureMissHeavySHash( "Interleaved", SHASH_INTERLEAVED, 90, miss_keys );
+  MeasureMissHeavySHash( "Split", SHASH_SPLIT, 90, miss_keys );
+
+  free( miss_keys );
+
+
+  // measure building and resizing a large hash on a number of threads
+  build_keys = malloc( BUILD_PAIRS );
+  build_pairs = malloc( BUILD_PAIRS * sizeof( void * ) );
+  if( !build_keys || !build_pairs ){
+    printf( "Could not allocate the build pairs.\n" );
+    return EXIT_FAILURE;
+  }
+
+  for( i = 0; i < BUILD_PAIRS; i++ )
+    build_pairs[i] = build_keys + i;
+
+  printf( "\n%d pairs, built then doubled in capacity\n", BUILD_PAIRS );
+  MeasureParallelBuild( 0, build_pairs, BUILD_PAIRS );
+  MeasureParallelBuild( 1, build_pairs, BUILD_PAIRS );
+  MeasureParallelBuild( 2, build_pairs, BUILD_PAIRS );
+  MeasureParallelBuild( 4, build_pairs, BUILD_PAIRS );
+  MeasureParallelBuild( 8, build_pairs, BUILD_PAIRS );
+
+  free( build_pairs );
+  free( build_keys );
+
+
   // cleaning up
   fclose( words );
   return EXIT_SUCCESS;
 }
 
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
 static
 clock_t
 LoadSHash
@@ -89,3 +173,142 @@ LoadSHash
 
   return total_clocks;
 }
+
+static
+void
+MeasureMissHeavySHash
+( const char *name, unsigned short layout, unsigned load, char *keys )
+{
+  clock_t begin, get_clocks;
+  size_t count, i, found = 0;
+  shash_t *hash;
+
+  hash = SHashNewSized( MISS_CAPACITY );
+  if( !hash ){
+    printf( "Could not build a hash for %s.\n", name );
+    return;
+  }
+  SHashSetSeed( hash, POINTER_SEED );
+  SHashSetFolder( hash, ModFold );
+  SHashSetLayout( hash, layout );
+
+  count = (size_t) MISS_CAPACITY * load / 100;
+  for( i = 0; i < count; i++ )
+    SHashPut( hash, keys + i, keys + i );
+
+  // the second half of the pool is never put, so every lookup misses
+  begin = clock();
+  for( i = 0; i < MISS_LOOKUPS; i++ )
+    if( SHashGet( hash, keys + MISS_CAPACITY + i % MISS_CAPACITY ) )
+      found++;
+  get_clocks = clock() - begin;
+
+  printf( "%-12s Load: %3d%%  Get Clocks: %8d  Found: %d\n",
+          name, (int)load, (int)get_clocks, (int)found );
+
+  SHashDestroy( hash );
+}
+
+static
+void
+MeasureParallelBuild
+( unsigned threads, void **pairs, size_t count )
+{
+  double build_time, resize_time;
+  size_t i;
+  shash_t *hash;
+  struct timespec begin;
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  if( threads == 0 ){
+    hash = SHashNewSized( count * 2 );
+    if( hash )
+      SHashSetFolder( hash, ModFold );
+    for( i = 0; hash && i < count; i++ )
+      SHashPut( hash, pairs[i], pairs[i] );
+  } else
+    hash = SHashNewFromPairs( pairs, pairs, count, threads );
+  build_time = ElapsedMilliseconds( &begin );
+
+  if( !hash ){
+    printf( "Could not build a hash on %d threads.\n", (int)threads );
+    return;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  if( threads == 0 )
+    SHashSetCapacity( hash, count * 4 );
+  else
+    SHashSetCapacityParallel( hash, count * 4, threads );
+  resize_time = ElapsedMilliseconds( &begin );
+
+  if( threads == 0 )
+    printf( "Put loop   Build ms: %8.1f  Resize ms: %8.1f  Size: %d\n",
+            build_time, resize_time, (int)SHashSize( hash ) );
+  else
+    printf( "Threads: %d  Build ms: %8.1f  Resize ms: %8.1f  Size: %d\n",
+            (int)threads, build_time, resize_time, (int)SHashSize( hash ) );
+
+  SHashDestroy( hash );
+}
+
+static
+void
+MeasurePointerSHash
+( const char *name, hasher_t hasher, folder_t folder, void **keys, size_t key_count )
+{
+  clock_t begin, get_clocks, put_clocks;
+  size_t home_slots = 0, i, longest_probe = 0, probe, round, total_probes = 0;
+  unsigned long long slot;
+  unsigned char homes[POINTER_CAPACITY], occupied[POINTER_CAPACITY];
+  shash_t *hash;
+
+  hash = SHashNewSized( POINTER_CAPACITY );
+  if( !hash ){
+    printf( "Could not build a hash for %s.\n", name );
+    return;
+  }
+  SHashSetSeed( hash, POINTER_SEED );
+  SHashSetHasher( hash, hasher );
+  SHashSetFolder( hash, folder );
+
+  begin = clock();
+  for( i = 0; i < key_count; i++ )
+    SHashPut( hash, keys[i], keys[i] );
+  put_clocks = clock() - begin;
+
+  begin = clock();
+  for( round = 0; round < POINTER_ROUNDS; round++ )
+    for( i = 0; i < key_count; i++ )
+      if( SHashGet( hash, keys[i] ) != keys[i] )
+        printf( "A key was lost by %s.\n", name );
+  get_clocks = clock() - begin;
+
+  // replay the insertions to find the probe lengths
+  memset( homes, 0, sizeof( homes ) );
+  memset( occupied, 0, sizeof( occupied ) );
+  for( i = 0; i < key_count; i++ ){
+    slot = folder( hasher( keys[i], POINTER_SEED ), POINTER_CAPACITY );
+    if( !homes[slot] ){
+      homes[slot] = 1;
+      home_slots++;
+    }
+
+    probe = 1;
+    while( occupied[slot] ){
+      slot = (slot + 1) % POINTER_CAPACITY;
+      probe++;
+    }
+    occupied[slot] = 1;
+
+    total_probes += probe;
+    if( probe > longest_probe )
+      longest_probe = probe;
+  }
+
+  printf( "%-25s Put Clocks: %6d  Get Clocks: %8d  Home Slots: %5d  Mean Probe: %7.2f  Longest Probe: %5d\n",
+          name, (int)put_clocks, (int)get_clocks, (int)home_slots,
+          (double) total_probes / key_count, (int)longest_probe );
+
+  SHashDestroy( hash );
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/hasher.h>
+#include <woodpile/static/hash.h>
+#include <woodpile/static/hopscotch.h>
+#include "test/performance/static/hopscotch_suite.h"
+
+#define HOPSCOTCH_CAPACITY (1 << 20)
+#define HOPSCOTCH_SEED 0x5eed
+
+int
+main
+( void )
+{
+  char *keys;
+
+  keys = malloc( HOPSCOTCH_CAPACITY * 2 );
+  if( !keys ){
+    printf( "Could not allocate the keys.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Capacity %d\n", HOPSCOTCH_CAPACITY );
+  MeasureSHopscotch( 80, keys );
+  MeasureSHash( 80, keys );
+  MeasureSHopscotch( 90, keys );
+  MeasureSHash( 90, keys );
+  MeasureSHopscotch( 95, keys );
+  MeasureSHash( 95, keys );
+
+  free( keys );
+  return EXIT_SUCCESS;
+}
+
+static
+void
+MeasureSHopscotch
+( unsigned load, char *keys )
+{
+  clock_t begin, hit_clocks, miss_clocks, put_clocks;
+  size_t count, failed = 0, i;
+  shopscotch_t *hash;
+
+  hash = SHopscotchNewSized( HOPSCOTCH_CAPACITY );
+  if( !hash ){
+    printf( "Could not build a hopscotch hash.\n" );
+    return;
+  }
+  SHopscotchSetSeed( hash, HOPSCOTCH_SEED );
+
+  count = (size_t) HOPSCOTCH_CAPACITY * load / 100;
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    if( !SHopscotchPut( hash, keys + i, keys + i ) )
+      failed++;
+  put_clocks = clock() - begin;
+
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    SHopscotchGet( hash, keys + i );
+  hit_clocks = clock() - begin;
+
+  // the second half of the pool is never put, so every lookup misses
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    SHopscotchGet( hash, keys + HOPSCOTCH_CAPACITY + i );
+  miss_clocks = clock() - begin;
+
+  printf( "Hopscotch  Load: %3d%%  Put Clocks: %8d  Hit Clocks: %8d  Miss Clocks: %8d  Failed Puts: %d\n",
+          (int)load, (int)put_clocks, (int)hit_clocks, (int)miss_clocks, (int)failed );
+
+  SHopscotchDestroy( hash );
+}
+
+static
+void
+MeasureSHash
+( unsigned load, char *keys )
+{
+  clock_t begin, hit_clocks, miss_clocks, put_clocks;
+  size_t count, i;
+  shash_t *hash;
+
+  hash = SHashNewSized( HOPSCOTCH_CAPACITY );
+  if( !hash ){
+    printf( "Could not build a hash.\n" );
+    return;
+  }
+  SHashSetSeed( hash, HOPSCOTCH_SEED );
+  SHashSetFolder( hash, ModFold );
+
+  count = (size_t) HOPSCOTCH_CAPACITY * load / 100;
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    SHashPut( hash, keys + i, keys + i );
+  put_clocks = clock() - begin;
+
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    SHashGet( hash, keys + i );
+  hit_clocks = clock() - begin;
+
+  begin = clock();
+  for( i = 0; i < count; i++ )
+    SHashGet( hash, keys + HOPSCOTCH_CAPACITY + i );
+  miss_clocks = clock() - begin;
+
+  printf( "SHash      Load: %3d%%  Put Clocks: %8d  Hit Clocks: %8d  Miss Clocks: %8d\n",
+          (int)load, (int)put_clocks, (int)hit_clocks, (int)miss_clocks );
+
+  SHashDestroy( hash );
+}
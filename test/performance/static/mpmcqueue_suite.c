@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/mpmcqueue.h>
+#include "test/performance/static/mpmcqueue_suite.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#define QUEUE_CAPACITY 1024
+#define TRANSFER_VALUES (1 << 23)
+
+static char *values;
+
+int
+main
+( void )
+{
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  unsigned threads;
+
+  values = malloc( TRANSFER_VALUES );
+  if( !values ){
+    printf( "Could not allocate the values.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Values passed through a queue of capacity %d: %d\n",
+          QUEUE_CAPACITY, TRANSFER_VALUES );
+  for( threads = 1; threads <= MAX_THREADS; threads *= 2 )
+    MeasureMPMCQueue( threads, threads );
+  MeasureMPMCQueue( 1, MAX_THREADS );
+  MeasureMPMCQueue( MAX_THREADS, 1 );
+
+  free( values );
+#else
+  printf( "Threads are not available, so there is nothing to measure.\n" );
+#endif
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void *
+Consume
+( void *worker )
+{
+  struct worker_t *consumer = worker;
+  size_t i;
+
+  for( i = 0; i < consumer->count; i++ )
+    while( !SMPMCQueueTryPop( consumer->queue ) )
+      sched_yield();
+
+  return NULL;
+}
+
+static
+void
+MeasureMPMCQueue
+( unsigned producers, unsigned consumers )
+{
+  struct worker_t consumer_workers[MAX_THREADS], producer_workers[MAX_THREADS];
+  pthread_t consumer_threads[MAX_THREADS], producer_threads[MAX_THREADS];
+  double time;
+  smpmcqueue_t *queue;
+  struct timespec begin;
+  unsigned t;
+
+  queue = SMPMCQueueNew( QUEUE_CAPACITY );
+  if( !queue ){
+    printf( "Could not build an MPMC queue.\n" );
+    return;
+  }
+
+  // the value counts are powers of two, so the shares divide evenly
+  for( t = 0; t < consumers; t++ ){
+    consumer_workers[t].count = TRANSFER_VALUES / consumers;
+    consumer_workers[t].first = 0;
+    consumer_workers[t].queue = queue;
+  }
+  for( t = 0; t < producers; t++ ){
+    producer_workers[t].count = TRANSFER_VALUES / producers;
+    producer_workers[t].first = producer_workers[t].count * t;
+    producer_workers[t].queue = queue;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( t = 0; t < consumers; t++ )
+    if( pthread_create( &consumer_threads[t], NULL, Consume, &consumer_workers[t] ) != 0 ){
+      printf( "Could not start a consumer.\n" );
+      exit( EXIT_FAILURE );
+    }
+  for( t = 0; t < producers; t++ )
+    if( pthread_create( &producer_threads[t], NULL, Produce, &producer_workers[t] ) != 0 ){
+      printf( "Could not start a producer.\n" );
+      exit( EXIT_FAILURE );
+    }
+
+  for( t = 0; t < producers; t++ )
+    pthread_join( producer_threads[t], NULL );
+  for( t = 0; t < consumers; t++ )
+    pthread_join( consumer_threads[t], NULL );
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "Producers: %d  Consumers: %d  ms: %7.1f  Mops/s: %7.1f\n",
+          producers, consumers, time, TRANSFER_VALUES / time / 1000.0 );
+
+  SMPMCQueueDestroy( queue );
+}
+
+static
+void *
+Produce
+( void *worker )
+{
+  struct worker_t *producer = worker;
+  size_t i;
+
+  for( i = 0; i < producer->count; i++ )
+    while( !SMPMCQueueTryPush( producer->queue, values + producer->first + i ) )
+      sched_yield();
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/static/queue.h>
+#include "test/performance/static/queue_suite.h"
+
+#define BATCH_VALUES (1 << 26)
+#define GROWTH_VALUES (1 << 22)
+#define MAX_BATCH 256
+#define STEADY_OPERATIONS (1 << 26)
+
+int
+main
+( void )
+{
+  char *values;
+  size_t batch, depth;
+
+  values = malloc( GROWTH_VALUES );
+  if( !values ){
+    printf( "Could not allocate the values.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Steady state push and pop pairs: %d\n", STEADY_OPERATIONS );
+  for( depth = 16; depth <= 4096; depth *= 16 ){
+    MeasureSteadyState( depth, values );
+    MeasureModuloRing( depth, values );
+  }
+
+  printf( "\nGrowth from the default capacity: %d values\n", GROWTH_VALUES );
+  MeasureGrowth( values );
+
+  printf( "\nBatches of values pushed then popped: %d values\n", BATCH_VALUES );
+  for( batch = 4; batch <= MAX_BATCH; batch *= 4 )
+    MeasureBatches( batch, values );
+
+  free( values );
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+static
+void
+MeasureBatches
+( size_t batch, char *values )
+{
+  void *in[MAX_BATCH], *out[MAX_BATCH];
+  double bulk_time, scalar_time;
+  size_t i, j;
+  struct timespec begin;
+  SQueue *queue;
+  unsigned short in_order = 1;
+
+  // a capacity that is not a multiple of the batch makes the batches wrap
+  queue = SQueueNewSized( 1000 );
+  if( !queue ){
+    printf( "Could not build a Queue.\n" );
+    return;
+  }
+
+  for( j = 0; j < batch; j++ )
+    in[j] = values + j;
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < BATCH_VALUES; i += batch ){
+    for( j = 0; j < batch; j++ )
+      SQueuePush( queue, in[j] );
+    for( j = 0; j < batch; j++ )
+      out[j] = SQueuePop( queue );
+  }
+  scalar_time = ElapsedMilliseconds( &begin );
+  in_order &= out[batch - 1] == in[batch - 1];
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < BATCH_VALUES; i += batch ){
+    SQueuePushN( queue, in, batch );
+    SQueuePopN( queue, out, batch );
+  }
+  bulk_time = ElapsedMilliseconds( &begin );
+  in_order &= out[batch - 1] == in[batch - 1];
+
+  printf( "Batch: %3d  Scalar Mops/s: %7.1f  Bulk Mops/s: %7.1f%s\n",
+          (int)batch, BATCH_VALUES / scalar_time / 1000.0,
+          BATCH_VALUES / bulk_time / 1000.0,
+          in_order ? "" : "  (lost a value)" );
+
+  SQueueDestroy( queue );
+}
+
+static
+void
+MeasureGrowth
+( char *values )
+{
+  double pop_time, push_time;
+  size_t i;
+  struct timespec begin;
+  SQueue *queue;
+
+  queue = SQueueNew();
+  if( !queue ){
+    printf( "Could not build a Queue.\n" );
+    return;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < GROWTH_VALUES; i++ )
+    if( !SQueuePush( queue, values + i ) ){
+      printf( "Could not grow the Queue.\n" );
+      SQueueDestroy( queue );
+      return;
+    }
+  push_time = ElapsedMilliseconds( &begin );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < GROWTH_VALUES; i++ )
+    if( SQueuePop( queue ) != values + i ){
+      printf( "The Queue lost the order of its values.\n" );
+      break;
+    }
+  pop_time = ElapsedMilliseconds( &begin );
+
+  printf( "Capacity: %9d  Push ms: %7.1f  Pop ms: %7.1f  Mops/s: %7.1f\n",
+          (int)SQueueCapacity( queue ), push_time, pop_time,
+          2.0 * GROWTH_VALUES / ( push_time + pop_time ) / 1000.0 );
+
+  SQueueDestroy( queue );
+}
+
+static
+void
+MeasureModuloRing
+( size_t depth, char *values )
+{
+  double time;
+  size_t i;
+  struct modulo_ring_t ring;
+  struct timespec begin;
+  volatile size_t capacity = depth + 1;
+  void *sink = NULL;
+
+  // the capacity is read at run time so the division is not folded away
+  ring.capacity = capacity;
+  ring.elements = malloc( sizeof( void * ) * ring.capacity );
+  if( !ring.elements ){
+    printf( "Could not build a modulo ring.\n" );
+    return;
+  }
+
+  ring.front = ring.back = 0;
+  for( i = 0; i < depth; i++ ){
+    ring.elements[ring.back] = values + i;
+    ring.back = ( ring.back + 1 ) % ring.capacity;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < STEADY_OPERATIONS; i++ ){
+    ring.elements[ring.back] = values + i % depth;
+    ring.back = ( ring.back + 1 ) % ring.capacity;
+
+    sink = ring.elements[ring.front];
+    ring.front = ( ring.front + 1 ) % ring.capacity;
+  }
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "Modulo Ring  Depth: %5d  ms: %7.1f  Mops/s: %7.1f%s\n",
+          (int)depth, time, STEADY_OPERATIONS / time / 1000.0,
+          sink ? "" : " (lost a value)" );
+
+  free( ring.elements );
+}
+
+static
+void
+MeasureSteadyState
+( size_t depth, char *values )
+{
+  double time;
+  size_t i;
+  struct timespec begin;
+  SQueue *queue;
+  void *sink = NULL;
+
+  queue = SQueueNewSized( depth );
+  if( !queue ){
+    printf( "Could not build a Queue.\n" );
+    return;
+  }
+
+  for( i = 0; i < depth; i++ )
+    SQueuePush( queue, values + i );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < STEADY_OPERATIONS; i++ ){
+    SQueuePush( queue, values + i % depth );
+    sink = SQueuePop( queue );
+  }
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "SQueue       Depth: %5d  ms: %7.1f  Mops/s: %7.1f%s\n",
+          (int)depth, time, STEADY_OPERATIONS / time / 1000.0,
+          sink ? "" : " (lost a value)" );
+
+  SQueueDestroy( queue );
+}
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/queue.h>
+#include <woodpile/static/spscqueue.h>
+#include "test/performance/static/spscqueue_suite.h"
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#define LOCKED_CAPACITY 1024
+#define TRANSFER_VALUES (1 << 24)
+
+static char *values;
+
+int
+main
+( void )
+{
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+  size_t capacity;
+
+  values = malloc( TRANSFER_VALUES );
+  if( !values ){
+    printf( "Could not allocate the values.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Values passed from one thread to another: %d\n", TRANSFER_VALUES );
+  MeasureLockedQueue( values );
+  for( capacity = 64; capacity <= 16384; capacity *= 16 )
+    MeasureSPSCQueue( capacity, values );
+
+  free( values );
+#else
+  printf( "Threads are not available, so there is nothing to measure.\n" );
+#endif
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+#ifdef __WOODPILE_HAVE_PTHREAD_H
+static
+void
+MeasureLockedQueue
+( char *values )
+{
+  double time;
+  size_t i;
+  struct locked_queue_t locked;
+  pthread_t producer;
+  struct timespec begin;
+  void *value;
+  unsigned short in_order = 1;
+
+  locked.queue = SQueueNewSized( LOCKED_CAPACITY );
+  if( !locked.queue ){
+    printf( "Could not build a Queue.\n" );
+    return;
+  }
+  pthread_mutex_init( &locked.lock, NULL );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  if( pthread_create( &producer, NULL, ProduceLocked, &locked ) != 0 ){
+    printf( "Could not start the producer.\n" );
+    return;
+  }
+
+  for( i = 0; i < TRANSFER_VALUES; i++ ){
+    for( ;; ){
+      pthread_mutex_lock( &locked.lock );
+      value = SQueuePop( locked.queue );
+      pthread_mutex_unlock( &locked.lock );
+      if( value )
+        break;
+      sched_yield();
+    }
+
+    in_order &= value == values + i;
+  }
+
+  pthread_join( producer, NULL );
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "Mutex SQueue  Capacity: %6d  ms: %7.1f  Mops/s: %7.1f%s\n",
+          LOCKED_CAPACITY, time, TRANSFER_VALUES / time / 1000.0,
+          in_order ? "" : "  (out of order)" );
+
+  pthread_mutex_destroy( &locked.lock );
+  SQueueDestroy( locked.queue );
+}
+
+static
+void
+MeasureSPSCQueue
+( size_t capacity, char *values )
+{
+  double time;
+  size_t i;
+  pthread_t producer;
+  sspscqueue_t *queue;
+  struct timespec begin;
+  void *value;
+  unsigned short in_order = 1;
+
+  queue = SSPSCQueueNew( capacity );
+  if( !queue ){
+    printf( "Could not build an SPSC queue.\n" );
+    return;
+  }
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  if( pthread_create( &producer, NULL, ProduceSPSC, queue ) != 0 ){
+    printf( "Could not start the producer.\n" );
+    return;
+  }
+
+  for( i = 0; i < TRANSFER_VALUES; i++ ){
+    while( !( value = SSPSCQueuePop( queue ) ) )
+      sched_yield();
+
+    in_order &= value == values + i;
+  }
+
+  pthread_join( producer, NULL );
+  time = ElapsedMilliseconds( &begin );
+
+  printf( "SPSC Queue    Capacity: %6d  ms: %7.1f  Mops/s: %7.1f%s\n",
+          (int)capacity, time, TRANSFER_VALUES / time / 1000.0,
+          in_order ? "" : "  (out of order)" );
+
+  SSPSCQueueDestroy( queue );
+}
+
+static
+void *
+ProduceLocked
+( void *queue )
+{
+  struct locked_queue_t *locked = queue;
+  size_t i;
+  SQueue *pushed;
+
+  // the Queue is kept from growing so that both sides wait the same way
+  for( i = 0; i < TRANSFER_VALUES; i++ )
+    for( ;; ){
+      pthread_mutex_lock( &locked->lock );
+      pushed = SQueueSize( locked->queue ) < LOCKED_CAPACITY
+               ? SQueuePush( locked->queue, values + i ) : NULL;
+      pthread_mutex_unlock( &locked->lock );
+      if( pushed )
+        break;
+      sched_yield();
+    }
+
+  return NULL;
+}
+
+static
+void *
+ProduceSPSC
+( void *queue )
+{
+  size_t i;
+
+  for( i = 0; i < TRANSFER_VALUES; i++ )
+    while( !SSPSCQueuePush( queue, values + i ) )
+      sched_yield();
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/static/stack.h>
+#include "test/performance/static/stack_suite.h"
+
+#define BATCH_VALUES (1 << 26)
+#define MAX_BATCH 256
+
+int
+main
+( void )
+{
+  static char values[MAX_BATCH];
+  size_t batch;
+
+  printf( "Batches of values pushed then popped: %d values\n", BATCH_VALUES );
+  for( batch = 4; batch <= MAX_BATCH; batch *= 4 )
+    MeasureBatches( batch, values );
+
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+static
+void
+MeasureBatches
+( size_t batch, char *values )
+{
+  void *in[MAX_BATCH], *out[MAX_BATCH];
+  double bulk_time, scalar_time;
+  size_t i, j;
+  struct timespec begin;
+  SStack *stack;
+  unsigned short in_order = 1;
+
+  stack = SStackNew();
+  if( !stack ){
+    printf( "Could not build a Stack.\n" );
+    return;
+  }
+
+  for( j = 0; j < batch; j++ )
+    in[j] = values + j;
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < BATCH_VALUES; i += batch ){
+    for( j = 0; j < batch; j++ )
+      SStackPush( stack, in[j] );
+    for( j = 0; j < batch; j++ )
+      out[j] = SStackPop( stack );
+  }
+  scalar_time = ElapsedMilliseconds( &begin );
+  in_order &= out[0] == in[batch - 1];
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( i = 0; i < BATCH_VALUES; i += batch ){
+    SStackPushN( stack, in, batch );
+    SStackPopN( stack, out, batch );
+  }
+  bulk_time = ElapsedMilliseconds( &begin );
+  in_order &= out[0] == in[0];
+
+  printf( "Batch: %3d  Scalar Mops/s: %7.1f  Bulk Mops/s: %7.1f%s\n",
+          (int)batch, BATCH_VALUES / scalar_time / 1000.0,
+          BATCH_VALUES / bulk_time / 1000.0,
+          in_order ? "" : "  (lost a value)" );
+
+  SStackDestroy( stack );
+}
@@ -0,0 +1,151 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/static/cache.h>
+#include <woodpile/static/tinylfu.h>
+#include "test/performance/static/tinylfu_suite.h"
+
+#define CACHE_CAPACITY 10000
+#define KEY_POOL (1 << 22)
+#define SCAN_LENGTH 20000
+#define TRACE_LENGTH 4000000
+
+int
+main
+( void )
+{
+  char *keys, **trace;
+
+  keys = malloc( KEY_POOL );
+  trace = malloc( TRACE_LENGTH * sizeof( char * ) );
+  if( !keys || !trace ){
+    printf( "Could not allocate the keys.\n" );
+    free( keys );
+    free( trace );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Capacity %d  Keys %d  Trace Length %d\n", CACHE_CAPACITY, KEY_POOL, TRACE_LENGTH );
+
+  BuildTrace( trace, keys, 0.8, 0 );
+  MeasureSCache( "Zipf 0.8", trace );
+  MeasureSTinyLFU( "Zipf 0.8", trace );
+
+  BuildTrace( trace, keys, 1.0, 0 );
+  MeasureSCache( "Zipf 1.0", trace );
+  MeasureSTinyLFU( "Zipf 1.0", trace );
+
+  BuildTrace( trace, keys, 0.8, 100000 );
+  MeasureSCache( "Zipf 0.8 + Scans", trace );
+  MeasureSTinyLFU( "Zipf 0.8 + Scans", trace );
+
+  free( trace );
+  free( keys );
+  return EXIT_SUCCESS;
+}
+
+static
+void
+BuildTrace
+( char **trace, char *keys, double skew, size_t scan_every )
+{
+  double *cumulative, draw, total = 0;
+  size_t high, i, low, middle, next_scan = 0, scanned = 0;
+  size_t popular = KEY_POOL / 2;
+
+  cumulative = malloc( popular * sizeof( double ) );
+  if( !cumulative ){
+    printf( "Could not allocate the distribution.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  for( i = 0; i < popular; i++ ){
+    total += 1.0 / pow( (double) ( i + 1 ), skew );
+    cumulative[i] = total;
+  }
+
+  srand( 0x5eed );
+  for( i = 0; i < TRACE_LENGTH; i++ ){
+    // scanned keys come from the half of the pool the distribution never uses
+    if( scan_every && i % scan_every == 0 && i > 0 )
+      next_scan = i + SCAN_LENGTH;
+    if( i < next_scan ){
+      trace[i] = keys + popular + scanned++ % popular;
+      continue;
+    }
+
+    draw = ( (double) rand() / RAND_MAX ) * total;
+    low = 0;
+    high = popular - 1;
+    while( low < high ){
+      middle = ( low + high ) / 2;
+      if( cumulative[middle] < draw )
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+    trace[i] = keys + low;
+  }
+
+  free( cumulative );
+}
+
+static
+void
+MeasureSCache
+( const char *name, char **trace )
+{
+  clock_t begin, clocks;
+  scache_t *cache;
+  size_t hits = 0, i;
+
+  cache = SCacheNew( CACHE_CAPACITY );
+  if( !cache ){
+    printf( "Could not build a cache.\n" );
+    return;
+  }
+
+  begin = clock();
+  for( i = 0; i < TRACE_LENGTH; i++ )
+    if( SCacheGet( cache, trace[i] ) )
+      hits++;
+    else
+      SCachePut( cache, trace[i], trace[i] );
+  clocks = clock() - begin;
+
+  printf( "%-18s LRU      Hit Rate: %6.2f%%  Clocks: %8d\n",
+          name, 100.0 * hits / TRACE_LENGTH, (int)clocks );
+
+  SCacheDestroy( cache );
+}
+
+static
+void
+MeasureSTinyLFU
+( const char *name, char **trace )
+{
+  clock_t begin, clocks;
+  stinylfu_t *cache;
+  size_t hits = 0, i;
+
+  cache = STinyLFUNew( CACHE_CAPACITY );
+  if( !cache ){
+    printf( "Could not build a TinyLFU cache.\n" );
+    return;
+  }
+
+  begin = clock();
+  for( i = 0; i < TRACE_LENGTH; i++ )
+    if( STinyLFUGet( cache, trace[i] ) )
+      hits++;
+    else
+      STinyLFUPut( cache, trace[i], trace[i] );
+  clocks = clock() - begin;
+
+  printf( "%-18s TinyLFU  Hit Rate: %6.2f%%  Clocks: %8d\n",
+          name, 100.0 * hits / TRACE_LENGTH, (int)clocks );
+
+  STinyLFUDestroy( cache );
+}
@@ -0,0 +1,89 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/static/ttl.h>
+#include "test/performance/static/ttl_suite.h"
+
+#define LONGEST_LIFETIME 1000
+#define STALL_TICKS 500
+#define TTL_ENTRIES (1 << 20)
+
+int
+main
+( void )
+{
+  char *keys;
+
+  keys = malloc( TTL_ENTRIES );
+  if( !keys ){
+    printf( "Could not allocate the keys.\n" );
+    return EXIT_FAILURE;
+  }
+
+  printf( "Entries %d  Longest Lifetime %d  Stall %d ticks\n",
+          TTL_ENTRIES, LONGEST_LIFETIME, STALL_TICKS );
+  MeasureSTTL( SIZE_MAX, keys );
+  MeasureSTTL( 16384, keys );
+  MeasureSTTL( 4096, keys );
+
+  free( keys );
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+static
+void
+MeasureSTTL
+( size_t budget, char *keys )
+{
+  double call_time, total_time = 0, worst_time = 0;
+  size_t calls = 0, i;
+  struct timespec begin;
+  sttl_t *ttl;
+  unsigned long long now = 0;
+
+  ttl = STTLNew( TTL_ENTRIES, LONGEST_LIFETIME );
+  if( !ttl ){
+    printf( "Could not build a TTL map.\n" );
+    return;
+  }
+
+  srand( 0x5eed );
+  for( i = 0; i < TTL_ENTRIES; i++ )
+    STTLPut( ttl, keys + i, keys + i, 1 + rand() % LONGEST_LIFETIME );
+
+  while( !STTLIsEmpty( ttl ) ){
+    now += now == LONGEST_LIFETIME / 4 ? STALL_TICKS : 1;
+
+    clock_gettime( CLOCK_MONOTONIC, &begin );
+    STTLAdvance( ttl, now, budget );
+    call_time = ElapsedMilliseconds( &begin );
+
+    total_time += call_time;
+    if( call_time > worst_time )
+      worst_time = call_time;
+    calls++;
+  }
+
+  if( budget == SIZE_MAX )
+    printf( "Budget: unbounded  " );
+  else
+    printf( "Budget: %9d  ", (int)budget );
+  printf( "Calls: %6d  Total ms: %8.1f  Worst Call ms: %8.3f\n",
+          (int)calls, total_time, worst_time );
+
+  STTLDestroy( ttl );
+}
@@ -0,0 +1,191 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <woodpile/config.h>
+#include <woodpile/static/wsdeque.h>
+#include "test/performance/static/wsdeque_suite.h"
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+# include <pthread.h>
+# include <sched.h>
+# include <stdatomic.h>
+#endif
+
+#define CUTOFF 18
+#define FIBONACCI_N 40
+
+/** tasks are the position of the number to compute, offset so none is NULL */
+#define TASK( n ) ( (void *) (uintptr_t) ( (n) + 1 ) )
+#define TASK_N( task ) ( (unsigned) ( (uintptr_t) (task) - 1 ) )
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+static struct worker_t pool[MAX_WORKERS];
+static unsigned pool_size;
+static atomic_size_t pending;
+#endif
+
+int
+main
+( void )
+{
+  double sequential_time;
+  struct timespec begin;
+  unsigned long long expected;
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+  unsigned workers;
+#endif
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  expected = Fibonacci( FIBONACCI_N );
+  sequential_time = ElapsedMilliseconds( &begin );
+
+  printf( "Fork/join Fibonacci of %d, with tasks below %d run whole\n",
+          FIBONACCI_N, CUTOFF + 1 );
+  printf( "Plain recursion        ms: %7.1f  Result: %llu\n",
+          sequential_time, expected );
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+  for( workers = 1; workers <= MAX_WORKERS; workers *= 2 )
+    MeasureForkJoin( workers, expected, sequential_time );
+#else
+  printf( "Threads are not available, so there is nothing more to measure.\n" );
+#endif
+
+  return EXIT_SUCCESS;
+}
+
+static
+double
+ElapsedMilliseconds
+( const struct timespec *begin )
+{
+  struct timespec end;
+
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  return ( end.tv_sec - begin->tv_sec ) * 1000.0
+         + ( end.tv_nsec - begin->tv_nsec ) / 1000000.0;
+}
+
+static
+unsigned long long
+Fibonacci
+( unsigned n )
+{
+  if( n < 2 )
+    return n;
+
+  return Fibonacci( n - 1 ) + Fibonacci( n - 2 );
+}
+
+#if defined( __WOODPILE_HAVE_PTHREAD_H ) && defined( __WOODPILE_HAVE_STDATOMIC_H )
+static
+void
+Fork
+( struct worker_t *worker, unsigned n )
+{
+  // without room for the task, the worker runs it at once
+  if( !SWSDequePush( worker->deque, TASK( n ) ) ){
+    worker->sum += Fibonacci( n );
+    atomic_fetch_sub_explicit( &pending, 1, memory_order_release );
+  }
+}
+
+static
+void
+MeasureForkJoin
+( unsigned workers, unsigned long long expected, double sequential_time )
+{
+  pthread_t threads[MAX_WORKERS];
+  double time;
+  size_t steals = 0;
+  struct timespec begin;
+  unsigned long long sum = 0;
+  unsigned w;
+
+  for( w = 0; w < workers; w++ ){
+    pool[w].deque = SWSDequeNew( 64 );
+    if( !pool[w].deque ){
+      printf( "Could not build a deque.\n" );
+      while( w > 0 )
+        SWSDequeDestroy( pool[--w].deque );
+      return;
+    }
+
+    pool[w].index = w;
+    pool[w].seed = w + 1;
+    pool[w].steals = 0;
+    pool[w].sum = 0;
+  }
+
+  pool_size = workers;
+  atomic_store( &pending, 1 );
+  SWSDequePush( pool[0].deque, TASK( FIBONACCI_N ) );
+
+  clock_gettime( CLOCK_MONOTONIC, &begin );
+  for( w = 0; w < workers; w++ )
+    if( pthread_create( &threads[w], NULL, Work, &pool[w] ) != 0 ){
+      printf( "Could not start the workers.\n" );
+      exit( EXIT_FAILURE );
+    }
+
+  for( w = 0; w < workers; w++ )
+    pthread_join( threads[w], NULL );
+  time = ElapsedMilliseconds( &begin );
+
+  for( w = 0; w < workers; w++ ){
+    steals += pool[w].steals;
+    sum += pool[w].sum;
+    SWSDequeDestroy( pool[w].deque );
+  }
+
+  printf( "Workers: %d  ms: %7.1f  Speedup: %5.2f  Steals: %7d%s\n",
+          (int)workers, time, sequential_time / time, (int)steals,
+          sum == expected ? "" : "  (wrong result)" );
+}
+
+static
+void *
+Work
+( void *worker )
+{
+  struct worker_t *self = worker;
+  unsigned n;
+  void *task;
+
+  while( atomic_load_explicit( &pending, memory_order_acquire ) > 0 ){
+    task = SWSDequePop( self->deque );
+
+    if( !task && pool_size > 1 ){
+      // a xorshift picks the victim, skipping the worker itself
+      self->seed ^= self->seed << 13;
+      self->seed ^= self->seed >> 7;
+      self->seed ^= self->seed << 17;
+      task = SWSDequeSteal( pool[( self->index + 1 + self->seed % ( pool_size - 1 ) ) % pool_size].deque );
+      if( task )
+        self->steals++;
+    }
+
+    if( !task ){
+      sched_yield();
+      continue;
+    }
+
+    n = TASK_N( task );
+    if( n <= CUTOFF ){
+      self->sum += Fibonacci( n );
+      atomic_fetch_sub_explicit( &pending, 1, memory_order_release );
+      continue;
+    }
+
+    // the task becomes its two halves, counted before either can be stolen and
+    // finished, with the larger pushed last so that it is run next
+    atomic_fetch_add_explicit( &pending, 1, memory_order_relaxed );
+    Fork( self, n - 2 );
+    Fork( self, n - 1 );
+  }
+
+  return NULL;
+}
+#endif